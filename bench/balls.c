@@ -0,0 +1,157 @@
+/**
+ * @file		balls.c
+ *       		Ball-ball collision scaling benchmark (make bench-balls). From 4 to 10k balls moving
+ * 			    in a box sized for a constant density, compares the sweep and prune broad phase
+ * 			    (collideBallPairs) with testing every pair. Prints one CSV line per size.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define AREA_PER_BALL 1600
+#define MIN_BENCH_TIME 200000000UL
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Scatter the balls in a square box, random direction.
+ * @param	Ball*	balls		the balls
+ * @param	int		nbBalls	the number of balls
+ * @param	float	side		the box side
+ */
+void scatterBalls(Ball *balls, int nbBalls, float side) {
+	Point2D origin;
+	Vector2D speed;
+	int i;
+
+	for (i = 0; i < nbBalls; ++i) {
+		initPoint2D(&origin, BALL_RADIUS + (rand() % (int)(side - (2 * BALL_RADIUS))),
+			BALL_RADIUS + (rand() % (int)(side - (2 * BALL_RADIUS))));
+		initVector2D(&speed, rand() % 2 ? NORMAL : -NORMAL, rand() % 2 ? NORMAL : -NORMAL);
+		initBall(&balls[i], i, BALL_RADIUS, speed, origin, themeColor, 1);
+		balls[i].respawnTimer = 0;
+	}
+}
+
+/**
+ * Move the balls for one tick, bouncing on the box sides.
+ * @param	Ball*	balls		the balls
+ * @param	int		nbBalls	the number of balls
+ * @param	float	side		the box side
+ */
+void moveInBox(Ball *balls, int nbBalls, float side) {
+	int i;
+
+	for (i = 0; i < nbBalls; ++i) {
+		moveBall(&balls[i]);
+		if ((balls[i].origin.x < BALL_RADIUS && balls[i].speed.x < 0)
+			|| (balls[i].origin.x > side - BALL_RADIUS && balls[i].speed.x > 0)) {
+			balls[i].speed.x *= -1;
+		}
+		if ((balls[i].origin.y < BALL_RADIUS && balls[i].speed.y < 0)
+			|| (balls[i].origin.y > side - BALL_RADIUS && balls[i].speed.y > 0)) {
+			balls[i].speed.y *= -1;
+		}
+	}
+}
+
+/**
+ * Collide every pair of balls, without any broad phase (reference).
+ * @param		Ball*	balls		the balls
+ * @param		int		nbBalls	the number of balls
+ * @return	int						the number of pairs tested
+ */
+int collideAllPairs(Ball *balls, int nbBalls) {
+	int i, j;
+
+	for (i = 0; i < nbBalls; ++i) {
+		for (j = i + 1; j < nbBalls; ++j) {
+			collisionBallBall(&balls[i], &balls[j]);
+		}
+	}
+	return (nbBalls * (nbBalls - 1)) / 2;
+}
+
+/**
+ * Run ticks (collisions then movement) until MIN_BENCH_TIME is spent.
+ * @param		Ball*		balls				the balls
+ * @param		int			nbBalls			the number of balls
+ * @param		float		side				the box side
+ * @param		bool		sweep				sweep and prune, every pair otherwise
+ * @param		long*		ticks				number of ticks run
+ * @param		double*	tests				pairs tested per tick
+ * @return	double							nanoseconds per tick
+ */
+double runTicks(Ball *balls, int nbBalls, float side, bool sweep, long *ticks, double *tests) {
+	unsigned long start, elapsed = 0, pairs = 0, tick;
+
+	*ticks = 0;
+	while (elapsed < MIN_BENCH_TIME) {
+		start = clockNow();
+		for (tick = 0; tick < 16; ++tick) {
+			pairs += sweep ? collideBallPairs(balls, nbBalls) : collideAllPairs(balls, nbBalls);
+			moveInBox(balls, nbBalls, side);
+		}
+		elapsed += clockNow() - start;
+		*ticks += 16;
+	}
+	*tests = (double)pairs / *ticks;
+	return (double)elapsed / *ticks;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Run both broad phases on every ball count.
+ * @return	int	EXIT_SUCCESS
+ */
+int main() {
+	static int const sizes[] = {4, 16, 64, 256, 1024, 4096, 10000};
+	Ball *sweepBalls, *bruteBalls;
+	double sweepTime, bruteTime, sweepTests, bruteTests;
+	long sweepTicks, bruteTicks;
+	float side;
+	int i, n;
+
+	initMatchDefaults("GladOS");
+
+	printf("balls,box,ticks,sap_ns_per_tick,sap_ns_per_ball,sap_pairs_per_ball,all_pairs_ns_per_tick,speedup\n");
+	for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); ++i) {
+		n = sizes[i];
+		side = sqrt((float)n * AREA_PER_BALL);
+		sweepBalls = malloc(n * sizeof(Ball));
+		bruteBalls = malloc(n * sizeof(Ball));
+		if (sweepBalls == NULL || bruteBalls == NULL) {
+			exit(MALLOC_ERROR);
+		}
+		scatterBalls(sweepBalls, n, side);
+		memcpy(bruteBalls, sweepBalls, n * sizeof(Ball));
+
+		/* first tick : the order starts from scratch */
+		collideBallPairs(sweepBalls, n);
+		sweepTime = runTicks(sweepBalls, n, side, true, &sweepTicks, &sweepTests);
+		bruteTime = runTicks(bruteBalls, n, side, false, &bruteTicks, &bruteTests);
+
+		printf("%d,%.0f,%ld,%.0f,%.1f,%.2f,%.0f,%.1f\n", n, side, sweepTicks, sweepTime, sweepTime / n,
+			sweepTests / n, bruteTime, bruteTime / sweepTime);
+		free(sweepBalls);
+		free(bruteBalls);
+	}
+	return EXIT_SUCCESS;
+}
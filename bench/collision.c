@@ -0,0 +1,359 @@
+/**
+ * @file		collision.c
+ *       		Microbenchmarks of the geometry and collision kernels (make bench).
+ * 			    Each kernel runs on randomized and adversarial inputs, the results are
+ * 			    printed as CSV : benchmark,input,iterations,ns_per_op,allocs_per_op
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define NB_INPUTS 4096
+#define MIN_BENCH_TIME 100000000UL
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static unsigned long nbAllocations = 0;
+static volatile float sink;
+
+static Ball inputBalls[NB_INPUTS];
+static Point2D inputA[NB_INPUTS];
+static Point2D inputB[NB_INPUTS];
+static Brick inputBricks[NB_INPUTS];
+static Bar inputBars[NB_INPUTS];
+static GridBrick grid;
+static GridBrick scanGrid;
+
+/*/////////////////////////////////////////
+ //				ALLOCATION COUNTERS						//
+/////////////////////////////////////////*/
+
+/* Linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc */
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+
+void *__wrap_malloc(size_t size) {
+	++nbAllocations;
+	return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t nb, size_t size) {
+	++nbAllocations;
+	return __real_calloc(nb, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+	++nbAllocations;
+	return __real_realloc(ptr, size);
+}
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Run a kernel on the inputs, doubling the number of operations until it lasts
+ * at least MIN_BENCH_TIME, then print its CSV line.
+ * @param	char const*	name		the benchmark name
+ * @param	char const*	input		the input set name
+ * @param	void				kernel	the kernel, runs one operation on input number i
+ */
+void bench(char const *name, char const *input, void (*kernel)(int)) {
+	unsigned long iterations = NB_INPUTS, i, start, elapsed, allocations;
+
+	for (;;) {
+		allocations = nbAllocations;
+		start = clockNow();
+		for (i = 0; i < iterations; ++i) {
+			kernel(i & (NB_INPUTS - 1));
+		}
+		elapsed = clockNow() - start;
+		allocations = nbAllocations - allocations;
+		if (elapsed >= MIN_BENCH_TIME) {
+			break;
+		}
+		iterations *= 2;
+	}
+	printf("%s,%s,%lu,%.3f,%.3f\n", name, input, iterations,
+		(double)elapsed / iterations, (double)allocations / iterations);
+}
+
+/*/////////////////////////////////////////
+ //					INPUT GENERATION						//
+/////////////////////////////////////////*/
+
+/**
+ * Random float between min and max.
+ */
+float randomFloat(float min, float max) {
+	return min + ((max - min) * rand() / RAND_MAX);
+}
+
+/**
+ * Random ball inside the playground, random direction.
+ */
+void randomBall(Ball *ball) {
+	Point2D origin;
+	Vector2D speed;
+	initPoint2D(&origin, randomFloat(HUD_HEIGHT, SCREEN_WIDTH - HUD_HEIGHT),
+		randomFloat(HUD_HEIGHT, SCREEN_HEIGHT - HUD_HEIGHT));
+	initVector2D(&speed, rand() % 2 ? NORMAL : -NORMAL, rand() % 2 ? NORMAL : -NORMAL);
+	initBall(ball, 0, BALL_RADIUS, speed, origin, themeColor, 1 + rand() % 2);
+}
+
+/**
+ * Random inputs : balls anywhere, segments/bricks/bars anywhere. Most tests miss.
+ */
+void generateRandomInputs() {
+	Point2D topLeft;
+	int i;
+
+	for (i = 0; i < NB_INPUTS; ++i) {
+		randomBall(&inputBalls[i]);
+		initPoint2D(&inputA[i], randomFloat(0, SCREEN_WIDTH), randomFloat(0, SCREEN_HEIGHT));
+		initPoint2D(&inputB[i], randomFloat(0, SCREEN_WIDTH), randomFloat(0, SCREEN_HEIGHT));
+		initBrick(&inputBricks[i], ORDINARY, PRISTINE, 0, 0);
+		initPoint2D(&topLeft, randomFloat(HUD_HEIGHT, SCREEN_WIDTH - HUD_HEIGHT - BRICK_WIDTH),
+			randomFloat(HUD_HEIGHT, SCREEN_HEIGHT - HUD_HEIGHT - BRICK_HEIGHT));
+		updateBrickCoordinates(&inputBricks[i], topLeft);
+		inputBars[i] = players[rand() % 2].bar;
+		inputBars[i].center.x = randomFloat(HUD_HEIGHT, SCREEN_WIDTH - HUD_HEIGHT);
+	}
+}
+
+/**
+ * Adversarial inputs : every test hits, on the slowest path (corners, tangent balls,
+ * balls exactly on the bar corners) so no early exit is taken.
+ */
+void generateAdversarialInputs() {
+	Point2D topLeft;
+	int i;
+
+	for (i = 0; i < NB_INPUTS; ++i) {
+		randomBall(&inputBalls[i]);
+		initPoint2D(&topLeft, randomFloat(HUD_HEIGHT, SCREEN_WIDTH - HUD_HEIGHT - BRICK_WIDTH),
+			randomFloat(HUD_HEIGHT, SCREEN_HEIGHT - HUD_HEIGHT - BRICK_HEIGHT));
+		initBrick(&inputBricks[i], ORDINARY, PRISTINE, 0, 0);
+		updateBrickCoordinates(&inputBricks[i], topLeft);
+
+		/* segment almost tangent to the ball, ball past the end : corner test */
+		inputA[i] = inputBricks[i].topLeft;
+		inputB[i] = inputBricks[i].topRight;
+		inputBalls[i].origin.x = inputB[i].x + (BALL_RADIUS / 2);
+		inputBalls[i].origin.y = inputB[i].y + (BALL_RADIUS / 2);
+		inputBalls[i].speed.x = -NORMAL;
+		inputBalls[i].speed.y = -NORMAL;
+
+		/* bar centered on the ball corner */
+		inputBars[i] = players[i % 2].bar;
+		inputBars[i].center.x = inputBalls[i].origin.x + (inputBars[i].width / 2);
+		inputBars[i].center.y = inputBalls[i].origin.y + (BAR_HEIGHT / 2);
+	}
+}
+
+/*/////////////////////////////////////////
+ //						KERNELS										//
+/////////////////////////////////////////*/
+
+void kernelBallLine(int i) {
+	sink += collisionBallLine(&inputBalls[i], inputA[i], inputB[i]);
+}
+
+void kernelBallSegment(int i) {
+	sink += collisionBallSegment(&inputBalls[i], inputA[i], inputB[i]);
+}
+
+void kernelBallBrick(int i) {
+	sink += collisionBallBrick(&inputBalls[i], &inputBricks[i]);
+}
+
+void kernelBarBall(int i) {
+	Ball ball = inputBalls[i];
+	collisionBarBall(&inputBars[i], &ball);
+	sink += ball.speed.x;
+}
+
+void kernelBallGrid(int i) {
+	Ball ball = inputBalls[i];
+	sink += collisionBallGrid(grid, &ball, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+}
+
+void kernelBallGridScan(int i) {
+	Ball ball = inputBalls[i];
+	sink += collisionBallGrid(scanGrid, &ball, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+}
+
+/* one tick of a level where every brick moves : move the bricks, then query 4 balls */
+void kernelBricksTick(int i) {
+	int j;
+	Ball ball;
+	moveBricks(grid, GRID_MAX_WIDTH, GRID_MAX_HEIGHT, 1);
+	for (j = 0; j < 4; ++j) {
+		ball = inputBalls[(i + j) & (NB_INPUTS - 1)];
+		sink += collisionBallGrid(grid, &ball, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+	}
+}
+
+/* the same tick, with a tree rebuilt instead of refitted */
+void kernelBricksTickRebuild(int i) {
+	int j;
+	Ball ball;
+	moveBricks(grid, GRID_MAX_WIDTH, GRID_MAX_HEIGHT, 1);
+	buildBrickTree(grid, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+	for (j = 0; j < 4; ++j) {
+		ball = inputBalls[(i + j) & (NB_INPUTS - 1)];
+		sink += collisionBallGrid(grid, &ball, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+	}
+}
+
+/* the same tick, without any tree : every brick is tested */
+void kernelBricksTickScan(int i) {
+	int j;
+	Ball ball;
+	moveBricks(scanGrid, GRID_MAX_WIDTH, GRID_MAX_HEIGHT, 1);
+	for (j = 0; j < 4; ++j) {
+		ball = inputBalls[(i + j) & (NB_INPUTS - 1)];
+		sink += collisionBallGrid(scanGrid, &ball, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+	}
+}
+
+void kernelDefineVector(int i) {
+	sink += defineVector(inputA[i], inputB[i]).x;
+}
+
+void kernelPointPlusVector(int i) {
+	sink += pointPlusVector(inputA[i], inputBalls[i].speed).y;
+}
+
+void kernelAddVectors(int i) {
+	sink += addVectors(inputBalls[i].speed, defineVector(inputA[i], inputB[i])).x;
+}
+
+void kernelSubVectors(int i) {
+	sink += subVectors(inputBalls[i].speed, defineVector(inputA[i], inputB[i])).x;
+}
+
+void kernelMultVector(int i) {
+	sink += multVector(defineVector(inputA[i], inputB[i]), 0.5f).x;
+}
+
+void kernelDivVector(int i) {
+	sink += divVector(defineVector(inputA[i], inputB[i]), 3.f).x;
+}
+
+void kernelDotProduct(int i) {
+	sink += dotPRoduct(defineVector(inputA[i], inputB[i]), inputBalls[i].speed);
+}
+
+void kernelNorm(int i) {
+	sink += norm(defineVector(inputA[i], inputB[i]));
+}
+
+void kernelNormalize(int i) {
+	sink += normalize(inputBalls[i].speed).x;
+}
+
+void kernelDistance(int i) {
+	sink += distance(inputA[i], inputB[i]);
+}
+
+/* one frame of a multiball chain : 40 bricks destroyed, then the whole pool moved and drawn (null renderer) */
+void kernelParticles(int i) {
+	static long tick = 0;
+	int j;
+	for (j = 0; j < 40; ++j) {
+		emitBrickBurst(&inputBricks[(i + j) & (NB_INPUTS - 1)]);
+	}
+	updateParticles(++tick);
+	drawParticles();
+	sink += particlePool()->count;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Run every kernel on both input sets.
+ * @return	int	EXIT_SUCCESS
+ */
+int main() {
+	int *brickTypes = calloc(2 * GRID_MAX_WIDTH * GRID_MAX_HEIGHT, sizeof(int));
+	int i, inputSet;
+	char const *inputName;
+
+	initMatchDefaults("Player");
+	initGame(TWO_PL);
+
+	/* Indestructible bricks : the grid stays identical during the whole run. Every line moves
+	 * (sliding and orbiting lines) once the bricksTick benchmarks start. */
+	for (i = 0; i < GRID_MAX_WIDTH * GRID_MAX_HEIGHT; ++i) {
+		brickTypes[i] = INDESTRUCTIBLE;
+		brickTypes[(GRID_MAX_WIDTH * GRID_MAX_HEIGHT) + i] = (i / GRID_MAX_WIDTH) % 2 ? ORBIT : SLIDE;
+	}
+	/* the brick tree is built for the last grid : scanGrid tests every brick */
+	scanGrid = initGrid(GRID_MAX_WIDTH, GRID_MAX_HEIGHT, brickTypes);
+	initBrickCoordinates(scanGrid, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+	grid = initGrid(GRID_MAX_WIDTH, GRID_MAX_HEIGHT, brickTypes);
+	initBrickCoordinates(grid, GRID_MAX_WIDTH, GRID_MAX_HEIGHT);
+
+	printf("benchmark,input,iterations,ns_per_op,allocs_per_op\n");
+	for (inputSet = 0; inputSet < 2; ++inputSet) {
+		if (inputSet == 0) {
+			generateRandomInputs();
+			inputName = "random";
+		} else {
+			generateAdversarialInputs();
+			inputName = "adversarial";
+		}
+		bench("collisionBallLine", inputName, kernelBallLine);
+		bench("collisionBallSegment", inputName, kernelBallSegment);
+		bench("collisionBallBrick", inputName, kernelBallBrick);
+		bench("collisionBarBall", inputName, kernelBarBall);
+		bench("collisionBallGrid", inputName, kernelBallGrid);
+		bench("collisionBallGridScan", inputName, kernelBallGridScan);
+		bench("defineVector", inputName, kernelDefineVector);
+		bench("pointPlusVector", inputName, kernelPointPlusVector);
+		bench("addVectors", inputName, kernelAddVectors);
+		bench("subVectors", inputName, kernelSubVectors);
+		bench("multVector", inputName, kernelMultVector);
+		bench("divVector", inputName, kernelDivVector);
+		bench("dotPRoduct", inputName, kernelDotProduct);
+		bench("norm", inputName, kernelNorm);
+		bench("normalize", inputName, kernelNormalize);
+		bench("distance", inputName, kernelDistance);
+	}
+	bench("bricksTick", "moving", kernelBricksTick);
+	bench("bricksTickScan", "moving", kernelBricksTickScan);
+	bench("bricksTickRebuild", "moving", kernelBricksTickRebuild);
+	setRenderer(&nullRenderer);
+	bench("particlesFrame", "chain", kernelParticles);
+	printf("# particle pool : %d, peak %d, %lu particles dropped\n", PARTICLE_CAPACITY,
+		particlePool()->peak, particlePool()->droppedParticles);
+
+	for (i = 0; i < GRID_MAX_HEIGHT; ++i) {
+		free(grid[i]);
+		free(scanGrid[i]);
+	}
+	free(grid);
+	free(scanGrid);
+	free(brickTypes);
+	free(players);
+	free(balls);
+	return EXIT_SUCCESS;
+}
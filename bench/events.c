@@ -0,0 +1,150 @@
+/**
+ * @file		events.c
+ *       		Event-driven fast-forward benchmark (make bench-events). Plays whole GladOS matches on
+ * 			    each level, tick by tick then with fastForward, checks that both end in the same state
+ * 			    (and the same state hash)
+ * 			    and prints one CSV line per level and number of players.
+ * 			    Usage : bench_events [levels...] (res/grid1.txt res/grid_max.txt res/grid_motion.txt)
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define MAX_MATCH_TICKS 1000000L
+#define MIN_BENCH_TIME 200000000UL
+
+/*/////////////////////////////////////////
+ //						STRUCTURES								//
+/////////////////////////////////////////*/
+
+typedef struct MatchEnd {
+	long ticks;
+	long jumps;
+	long playedTicks;
+	int scores[4];
+	int lives[4];
+	Point2D balls[4];
+	Point2D bars[4];
+	Uint64 hash;
+} MatchEnd;
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Play one whole match, GladOS on every seat. Only the ticks are timed, not the setup.
+ * @param		char const*	level				the config file of the level
+ * @param		int					nbPlayers		total number of players in game
+ * @param		bool				events			jump to the events with fastForward, tick by tick otherwise
+ * @param		MatchEnd*		end					the state at the end of the match
+ * @return	unsigned long						nanoseconds spent in the ticks
+ */
+unsigned long playMatch(char const *level, int nbPlayers, bool events, MatchEnd *end) {
+	Match match;
+	int i;
+	long tick = 0, jumped;
+	bool over = false;
+	unsigned long start;
+
+	openMatch(&match, level, nbPlayers, (1u << nbPlayers) - 1);
+	memset(end, 0, sizeof(MatchEnd));
+
+	start = clockNow();
+	while (!over && tick < MAX_MATCH_TICKS) {
+		if (events && (jumped = fastForward(match.grid, match.gridWidth, match.gridHeight, nbPlayers,
+			match.nbBalls, match.gladOSSeats, MAX_MATCH_TICKS - tick))) {
+			tick += jumped;
+			++end->jumps;
+			continue;
+		}
+		simulationTick(0);
+		for (i = 0; i < nbPlayers; ++i) {
+			over = over || players[i].life <= 0;
+		}
+		++tick;
+		++end->playedTicks;
+	}
+
+	start = clockNow() - start;
+	end->ticks = tick;
+	end->hash = matchHash(tick);
+	for (i = 0; i < nbPlayers; ++i) {
+		end->scores[i] = players[i].score;
+		end->lives[i] = players[i].life;
+		end->balls[i] = balls[i].origin;
+		end->bars[i] = players[i].bar.center;
+	}
+	closeMatch(&match);
+	return start;
+}
+
+/**
+ * Play the same match until MIN_BENCH_TIME is spent.
+ * @param		char const*	level			the config file of the level
+ * @param		int					nbPlayers	total number of players in game
+ * @param		bool				events		jump to the events with fastForward, tick by tick otherwise
+ * @param		MatchEnd*		end				the state at the end of the match
+ * @return	double								nanoseconds per match
+ */
+double timeMatch(char const *level, int nbPlayers, bool events, MatchEnd *end) {
+	unsigned long start = clockNow(), elapsed = 0;
+	long nbMatches = 0;
+
+	do {
+		elapsed += playMatch(level, nbPlayers, events, end);
+		++nbMatches;
+	} while (clockNow() - start < MIN_BENCH_TIME);
+	return (double)elapsed / nbMatches;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Compare both ways of playing on every level, 2 then 4 players.
+ * @param		argc	number of parameters of main
+ * @param		argv	the levels to play
+ * @return	int		EXIT_SUCCESS, EXIT_FAILURE if a fast-forwarded match ends differently
+ */
+int main(int argc, char **argv) {
+	static char *defaultLevels[] = {"res/grid1.txt", "res/grid_max.txt", "res/grid_motion.txt"};
+	char **levels = argc > 1 ? argv + 1 : defaultLevels;
+	int nbLevels = argc > 1 ? argc - 1 : 3;
+	MatchEnd ticked, jumped;
+	double tickTime, eventTime;
+	bool same, allSame = true;
+	int i, nbPlayers;
+
+	initMatchDefaults("GladOS");
+
+	printf("level,players,ticks,played_ticks,jumps,tick_us_per_match,event_us_per_match,speedup,same_end\n");
+	for (i = 0; i < nbLevels; ++i) {
+		for (nbPlayers = TWO_PL; nbPlayers <= FOUR_PL; nbPlayers += 2) {
+			tickTime = timeMatch(levels[i], nbPlayers, false, &ticked);
+			eventTime = timeMatch(levels[i], nbPlayers, true, &jumped);
+			same = ticked.ticks == jumped.ticks && ticked.hash == jumped.hash
+				&& memcmp(ticked.scores, jumped.scores, sizeof(ticked.scores)) == 0
+				&& memcmp(ticked.lives, jumped.lives, sizeof(ticked.lives)) == 0
+				&& memcmp(ticked.balls, jumped.balls, sizeof(ticked.balls)) == 0
+				&& memcmp(ticked.bars, jumped.bars, sizeof(ticked.bars)) == 0;
+			allSame = allSame && same;
+			printf("%s,%d,%ld,%ld,%ld,%.1f,%.1f,%.1f,%s\n", levels[i], nbPlayers, jumped.ticks, jumped.playedTicks,
+				jumped.jumps, tickTime / 1000, eventTime / 1000, tickTime / eventTime, same ? "yes" : "NO");
+		}
+	}
+	return allSame ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file		match.c
+ *       		Headless whole-game benchmark (make bench-match). Replays the scenarios of
+ * 			    bench/scenarios.txt : fixed level, GladOS or recorded inputs on every seat,
+ * 			    fixed number of ticks (a finished match is restarted). Prints one CSV line
+ * 			    per scenario : sim ticks/s, frames/s with the null renderer and peak RSS. Every
+ * 			    scenario runs in its own child process, so its peak RSS is its own and not the
+ * 			    peak of the scenarios before it.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define _XOPEN_SOURCE 600
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define SEAT_PATTERN_SIZE 64
+
+/*/////////////////////////////////////////
+ //						STRUCTURES								//
+/////////////////////////////////////////*/
+
+typedef struct Scenario {
+	char name[64];
+	char level[256];
+	int nbPlayers;
+	long ticks;
+	char seats[4][SEAT_PATTERN_SIZE];
+} Scenario;
+
+/*/////////////////////////////////////////
+ //					MATCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Know which seats of a scenario GladOS plays.
+ * @param		Scenario const*	scenario	the scenario to play
+ * @return	unsigned int							bit i set if GladOS plays seat i
+ */
+unsigned int scenarioGladOSSeats(Scenario const *scenario) {
+	unsigned int seats = 0;
+	int i;
+	for (i = 0; i < scenario->nbPlayers; ++i) {
+		if (strcmp(scenario->seats[i], "gladOS") == 0) {
+			seats |= 1u << i;
+		}
+	}
+	return seats;
+}
+
+/**
+ * Read the actions of the recorded seats for the current tick.
+ * @param		Scenario const*	scenario	the scenario to play
+ * @param		long						tick			the current tick
+ * @return	unsigned int							the actions bitmask, the seats of GladOS are left out
+ */
+unsigned int scenarioActions(Scenario const *scenario, long tick) {
+	unsigned int actions = 0;
+	char move;
+	int i;
+	for (i = 0; i < scenario->nbPlayers; ++i) {
+		if (strcmp(scenario->seats[i], "gladOS") == 0) {
+			continue;
+		}
+		move = scenario->seats[i][tick % strlen(scenario->seats[i])];
+		if (move == 'L') {
+			actions |= ACTION_MINUS(i);
+		} else if (move == 'R') {
+			actions |= ACTION_PLUS(i);
+		}
+	}
+	return actions;
+}
+
+/**
+ * Play a scenario for its number of ticks, restarting the match when it's over.
+ * @param		Scenario const*	scenario	the scenario to play
+ * @param		bool						render		also draw every frame with the null renderer
+ * @param		long*						nbMatches	number of matches started
+ * @return	double										elapsed time in seconds
+ */
+double playScenario(Scenario const *scenario, bool render, long *nbMatches) {
+	Match match;
+	long tick;
+	int i;
+	bool over;
+	double start;
+
+	openMatch(&match, scenario->level, scenario->nbPlayers, scenarioGladOSSeats(scenario));
+	*nbMatches = 1;
+	start = clockNow() / 1e9;
+	for (tick = 0; tick < scenario->ticks; ++tick) {
+		simulationTick(scenarioActions(scenario, tick));
+		if (render) {
+			updateParticles(tick + 1);
+			renderer->beginFrame();
+			drawGame(match.grid, match.gridWidth, match.gridHeight, players, match.nbPlayers, balls, match.nbBalls);
+			renderer->endFrame();
+		}
+
+		over = false;
+		for (i = 0; i < match.nbPlayers; ++i) {
+			over = over || players[i].life <= 0;
+		}
+		if (over) {
+			closeMatch(&match);
+			openMatch(&match, scenario->level, scenario->nbPlayers, match.gladOSSeats);
+			++*nbMatches;
+		}
+	}
+	start = clockNow() / 1e9 - start;
+	closeMatch(&match);
+	return start;
+}
+
+/**
+ * Play a scenario without then with rendering and print its line. Meant to run in a
+ * child process of its own : the peak RSS printed is the one of this scenario only.
+ * @param	Scenario const*	scenario	the scenario to play
+ */
+void runScenario(Scenario const *scenario) {
+	struct rusage usage;
+	double simTime, frameTime;
+	long nbMatches;
+
+	simTime = playScenario(scenario, false, &nbMatches);
+	frameTime = playScenario(scenario, true, &nbMatches);
+	getrusage(RUSAGE_SELF, &usage);
+
+	printf("%s,%d,%s,%ld,%ld,%.0f,%.0f,%ld\n", scenario->name, scenario->nbPlayers, scenario->level,
+		scenario->ticks, nbMatches, scenario->ticks / simTime, scenario->ticks / frameTime, usage.ru_maxrss);
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Run every scenario of the scenario file (bench/scenarios.txt by default).
+ * The frames go through the null renderer, so rendering only measures
+ * the CPU side of the frame (draw submission), without any GL context.
+ * @param		argc	number of parameters of main
+ * @param		argv	argv[1] : optional scenario file
+ * @return	int		the error code value or the correct end value.
+ */
+int main(int argc, char **argv) {
+	char const *path = argc > 1 ? argv[1] : "bench/scenarios.txt";
+	char line[512];
+	FILE *file;
+	Scenario scenario;
+	pid_t child;
+	int nbFields, status;
+
+	if ((file = fopen(path, "r")) == NULL) {
+		printf("ERROR : Impossible to read the scenario file.\n");
+		return EXIT_FAILURE;
+	}
+
+	initMatchDefaults("Script");
+	initBallMesh();
+	setRenderer(&nullRenderer);
+
+	printf("scenario,players,grid,ticks,matches,sim_ticks_per_sec,frames_per_sec,peak_rss_kb\n");
+	while (fgets(line, sizeof(line), file) != NULL) {
+		if (line[0] == '#' || line[0] == '\n') {
+			continue;
+		}
+		memset(&scenario, 0, sizeof(scenario));
+		nbFields = sscanf(line, "%63s %255s %d %ld %63s %63s %63s %63s", scenario.name, scenario.level,
+			&scenario.nbPlayers, &scenario.ticks, scenario.seats[0], scenario.seats[1],
+			scenario.seats[2], scenario.seats[3]);
+		if (nbFields < 4 + scenario.nbPlayers) {
+			printf("ERROR : Invalid scenario '%s'.\n", scenario.name);
+			continue;
+		}
+
+		fflush(stdout);
+		if ((child = fork()) < 0) {
+			printf("ERROR : Impossible to start the scenario '%s'.\n", scenario.name);
+			continue;
+		}
+		if (child == 0) {
+			runScenario(&scenario);
+			/* _exit : the scenario file is the parent's, leave its offset alone */
+			fflush(stdout);
+			_exit(EXIT_SUCCESS);
+		}
+		waitpid(child, &status, 0);
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+			printf("ERROR : The scenario '%s' failed.\n", scenario.name);
+		}
+	}
+	fclose(file);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/**
+ * @file		observation.c
+ *       		Observation frames benchmark (make bench-observation). Plays a GladOS match and draws
+ * 			    every tick into small grayscale frames with the CPU rasterizer, alone or in a stack of
+ * 			    the last 4 frames. Prints one CSV line per size and depth ; the drawing only is timed.
+ * 			    Usage : bench_observation [level (res/grid_max.txt)] [stack.pgm]
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define MATCH_TICKS 2000
+#define STACK_DEPTH 4
+#define MIN_BENCH_TIME 200000000UL
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Play a match and draw an observation of every tick.
+ * @param		char const*			level		the config file of the level
+ * @param		unsigned char*	frames	depth frames of size * size bytes
+ * @param		int							size		the frame width and height
+ * @param		int							depth		the number of stacked frames, 1 for none
+ * @param		long*						drawn		the number of frames drawn
+ * @return	unsigned long						nanoseconds spent drawing
+ */
+unsigned long playMatch(char const *level, unsigned char *frames, int size, int depth, long *drawn) {
+	Match match;
+	unsigned long start, elapsed = 0;
+	bool over = false;
+	long tick;
+
+	openMatch(&match, level, TWO_PL, (1u << TWO_PL) - 1);
+	memset(frames, 0, depth * size * size);
+
+	for (tick = 0; tick < MATCH_TICKS && !over; ++tick) {
+		simulationTick(0);
+		over = players[0].life <= 0 || players[1].life <= 0;
+
+		start = clockNow();
+		if (depth > 1) {
+			stackObservation(frames, depth, size, size, match.grid, match.gridWidth, match.gridHeight,
+				players, TWO_PL, balls, TWO_PL);
+		} else {
+			drawObservation(frames, size, size, match.grid, match.gridWidth, match.gridHeight,
+				players, TWO_PL, balls, TWO_PL);
+		}
+		elapsed += clockNow() - start;
+		++(*drawn);
+	}
+
+	closeMatch(&match);
+	return elapsed;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Time every frame size, without then with the stack.
+ * @param		argc	number of parameters of main
+ * @param		argv	the level to play, the file to write the last 84x84 stack into
+ * @return	int		the error code value or the correct end value.
+ */
+int main(int argc, char **argv) {
+	static int const sizes[] = {64, OBSERVATION_SIZE, 128};
+	char const *level = argc > 1 ? argv[1] : "res/grid_max.txt";
+	unsigned char *frames = malloc(STACK_DEPTH * 128 * 128);
+	unsigned long start, elapsed;
+	long drawn;
+	double frameTime;
+	FILE *output;
+	int i, depth;
+
+	if (frames == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	initMatchDefaults("GladOS");
+
+	printf("size,depth,frames,ns_per_frame,frames_per_second\n");
+	for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); ++i) {
+		for (depth = 1; depth <= STACK_DEPTH; depth += STACK_DEPTH - 1) {
+			start = clockNow();
+			elapsed = 0;
+			drawn = 0;
+			do {
+				elapsed += playMatch(level, frames, sizes[i], depth, &drawn);
+			} while (clockNow() - start < MIN_BENCH_TIME);
+			frameTime = (double)elapsed / drawn;
+			printf("%d,%d,%ld,%.0f,%.0f\n", sizes[i], depth, drawn, frameTime, 1e9 / frameTime);
+		}
+	}
+
+	if (argc > 2) {
+		playMatch(level, frames, OBSERVATION_SIZE, STACK_DEPTH, &drawn);
+		if ((output = fopen(argv[2], "wb")) == NULL) {
+			printf("ERROR : Impossible to write '%s'.\n", argv[2]);
+			return EXIT_FAILURE;
+		}
+		/* the frames of the stack one under the other, the oldest on top */
+		fprintf(output, "P5\n%d %d\n255\n", OBSERVATION_SIZE, OBSERVATION_SIZE * STACK_DEPTH);
+		fwrite(frames, 1, STACK_DEPTH * OBSERVATION_SIZE * OBSERVATION_SIZE, output);
+		fclose(output);
+	}
+	free(frames);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,147 @@
+/**
+ * @file		rewind.c
+ *       		Rewind benchmark (make bench-rewind). Plays a practice match against GladOS for one
+ * 			    and a half times REWIND_SECONDS, keeping every tick in the rewind ring, then plays it
+ * 			    backwards to the oldest tick kept, checking each state put back against the one
+ * 			    played. Prints one CSV line : memory used, push and step times.
+ * 			    Usage : bench_rewind [level (res/grid_max.txt)]
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define PLAY_TICKS (REWIND_FRAMES + (REWIND_FRAMES / 2))
+#define RESUME_TICKS 1000
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Choose the actions of the first seat : its bar moves towards the nearest ball.
+ * @return	unsigned int	the actions of the tick
+ */
+unsigned int chaseBall() {
+	Bar const *bar = &players[0].bar;
+	float distance, nearest = -1, target = 0;
+	int i;
+
+	for (i = 0; i < TWO_PL; ++i) {
+		distance = fabs(balls[i].origin.y - bar->center.y);
+		if (!balls[i].respawnTimer && (nearest < 0 || distance < nearest)) {
+			nearest = distance;
+			target = balls[i].origin.x;
+		}
+	}
+	if (nearest >= 0 && target < bar->center.x - BAR_SPEED) {
+		return ACTION_MINUS(0);
+	}
+	if (nearest >= 0 && target > bar->center.x + BAR_SPEED) {
+		return ACTION_PLUS(0);
+	}
+	return 0;
+}
+
+/**
+ * Fingerprint everything the match shows : players, balls, living bricks and their
+ * position, state hash.
+ * @param		GridBrick	grid				the 2 dimensional brick grid
+ * @param		int				gridWidth		the number of columns in game
+ * @param		int				gridHeight	the number of lines
+ * @param		long			tick				the ticks played
+ * @return	Uint64								the fingerprint
+ */
+Uint64 fingerprint(GridBrick grid, int gridWidth, int gridHeight, long tick) {
+	Uint64 hash = matchHash(tick);
+	unsigned char const *byte;
+	int i, j;
+
+	for (byte = (unsigned char const *)players; byte < (unsigned char const *)(players + TWO_PL); ++byte) {
+		hash = mixHash(hash, *byte);
+	}
+	for (byte = (unsigned char const *)balls; byte < (unsigned char const *)(balls + TWO_PL); ++byte) {
+		hash = mixHash(hash, *byte);
+	}
+	for (i = 0; i < gridHeight; ++i) {
+		for (j = 0; j < gridWidth; ++j) {
+			hash = mixHash(hash, grid[i][j].status);
+			if (grid[i][j].status != DESTROYED) {
+				hash = mixHash(hash, HASH_WORD(floatWord(grid[i][j].topLeft.x), floatWord(grid[i][j].topLeft.y)));
+			}
+		}
+	}
+	return hash;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Play, rewind to the oldest tick kept and play again.
+ * @param		argc	number of parameters of main
+ * @param		argv	the level to play
+ * @return	int		EXIT_SUCCESS, EXIT_FAILURE if a state put back differs from the one played
+ */
+int main(int argc, char **argv) {
+	static Uint64 played[PLAY_TICKS + 1];
+	char const *level = argc > 1 ? argv[1] : "res/grid_max.txt";
+	unsigned long t, pushTime = 0, stepTime = 0, worst = 0, bytes;
+	long tick, steps = 0;
+	int i;
+	double seconds;
+	Match match;
+	bool same = true;
+
+	initMatchDefaults("bot");
+	muteBrickBursts(true);
+	openMatch(&match, level, TWO_PL, 1u << 1);
+	played[0] = fingerprint(match.grid, match.gridWidth, match.gridHeight, 0);
+
+	/* the match goes on after the last life : only the ticks matter */
+	for (tick = 1; tick <= PLAY_TICKS; ++tick) {
+		simulationTick(chaseBall());
+		t = clockNow();
+		pushRewind(tick);
+		pushTime += clockNow() - t;
+		played[tick] = fingerprint(match.grid, match.gridWidth, match.gridHeight, tick);
+	}
+	rewindUsage(&seconds, &bytes);
+
+	for (tick = PLAY_TICKS; ; ++steps) {
+		t = clockNow();
+		if (!stepRewind(&tick)) {
+			break;
+		}
+		t = clockNow() - t;
+		stepTime += t;
+		worst = t > worst ? t : worst;
+		same = same && fingerprint(match.grid, match.gridWidth, match.gridHeight, tick) == played[tick];
+	}
+
+	/* and forward again from there */
+	for (i = 0; i < RESUME_TICKS; ++i) {
+		simulationTick(chaseBall());
+		pushRewind(++tick);
+	}
+
+	printf("seconds_kept,kb_used,bytes_per_tick,push_ns,steps,step_us,worst_step_us,same_states\n");
+	printf("%.1f,%lu,%.1f,%.0f,%ld,%.2f,%.1f,%s\n", seconds, bytes / 1024,
+		(double)bytes / (seconds * 1000 / SIM_TICK_DURATION), (double)pushTime / PLAY_TICKS, steps,
+		stepTime / 1000.0 / steps, worst / 1000.0, same ? "yes" : "NO");
+
+	closeMatch(&match);
+	return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,184 @@
+/**
+ * @file		rollback.c
+ *       		Rollback benchmark (make bench-rollback). Plays 4 players matches (bars following the
+ * 			    nearest ball) and every ROLLBACK_TICKS ticks restores the state saved ROLLBACK_TICKS
+ * 			    ticks before and plays them again, like after a wrong prediction. Checks the state
+ * 			    ends exactly the same and prints one CSV line : save time per tick, then the median,
+ * 			    99th percentile, worst and mean rollback times. A rollback lands on one tick : its
+ * 			    tail matters as much as its mean.
+ * 			    Usage : bench_rollback [level (res/grid_max.txt)]
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define ROLLBACK_TICKS 8
+#define MATCH_TICKS 20000
+#define MIN_BENCH_TIME 1000000000UL
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Choose the actions of every seat : each bar moves towards the nearest ball.
+ * @return	unsigned int	the actions of the tick
+ */
+unsigned int chaseBalls() {
+	Bar const *bar;
+	float distance, nearest, target, barPos;
+	unsigned int actions = 0;
+	int i, j;
+
+	for (i = 0; i < FOUR_PL; ++i) {
+		bar = &players[i].bar;
+		nearest = -1;
+		target = 0;
+		for (j = 0; j < FOUR_PL; ++j) {
+			distance = bar->orientationHorizontal ? fabs(balls[j].origin.y - bar->center.y) : fabs(balls[j].origin.x - bar->center.x);
+			if (!balls[j].respawnTimer && (nearest < 0 || distance < nearest)) {
+				nearest = distance;
+				target = bar->orientationHorizontal ? balls[j].origin.x : balls[j].origin.y;
+			}
+		}
+		barPos = bar->orientationHorizontal ? bar->center.x : bar->center.y;
+		if (nearest >= 0 && target < barPos - BAR_SPEED) {
+			actions |= ACTION_MINUS(i);
+		} else if (nearest >= 0 && target > barPos + BAR_SPEED) {
+			actions |= ACTION_PLUS(i);
+		}
+	}
+	return actions;
+}
+
+/**
+ * Order two durations, for qsort.
+ * @param		void const*	a	the first duration
+ * @param		void const*	b	the second duration
+ * @return	int							negative, zero or positive like strcmp
+ */
+int compareTimes(void const *a, void const *b) {
+	unsigned long x = *(unsigned long const *)a, y = *(unsigned long const *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+/**
+ * Compare two saved states.
+ * @param		MatchState const*	a						the first state
+ * @param		MatchState const*	b						the second state
+ * @param		int								nbBricks		the number of bricks in game
+ * @return	bool												true if they are the same
+ */
+bool sameState(MatchState const *a, MatchState const *b, int nbBricks) {
+	int i;
+
+	for (i = 0; i < FOUR_PL; ++i) {
+		if (a->players[i].life != b->players[i].life || a->players[i].score != b->players[i].score
+			|| a->players[i].bar.width != b->players[i].bar.width
+			|| a->players[i].bar.center.x != b->players[i].bar.center.x
+			|| a->players[i].bar.center.y != b->players[i].bar.center.y) {
+			return false;
+		}
+	}
+	return a->tick == b->tick && savedMatchHash(&a->hash, a->tick) == savedMatchHash(&b->hash, b->tick)
+		&& memcmp(a->balls, b->balls, FOUR_PL * sizeof(Ball)) == 0
+		&& memcmp(a->bricks, b->bricks, nbBricks * sizeof(Brick)) == 0
+		&& a->tree.nbNodes == b->tree.nbNodes && a->tree.root == b->tree.root
+		&& memcmp(a->tree.nodes, b->tree.nodes, a->tree.nbNodes * sizeof(BVHNode)) == 0;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Play matches with a rollback every ROLLBACK_TICKS ticks until MIN_BENCH_TIME is spent.
+ * @param		argc	number of parameters of main
+ * @param		argv	the level to play
+ * @return	int		EXIT_SUCCESS, EXIT_FAILURE if a rollback ended differently
+ */
+int main(int argc, char **argv) {
+	static MatchState ring[ROLLBACK_TICKS + 1], check, replayed;
+	char const *level = argc > 1 ? argv[1] : "res/grid_max.txt";
+	unsigned int actions[ROLLBACK_TICKS + 1];
+	unsigned long start = clockNow(), t, saveTime = 0, rollbackTime = 0;
+	unsigned long *rollbackTimes = NULL;
+	long ticks = 0, nbRollbacks = 0, capacity = 0, tick;
+	int i, k;
+	Match match;
+	bool over, same = true;
+
+	initMatchDefaults("bot");
+	for (i = 0; i <= ROLLBACK_TICKS; ++i) {
+		if ((ring[i].balls = malloc(FOUR_PL * sizeof(Ball))) == NULL) {
+			exit(MALLOC_ERROR);
+		}
+	}
+	check.balls = malloc(FOUR_PL * sizeof(Ball));
+	replayed.balls = malloc(FOUR_PL * sizeof(Ball));
+	if (check.balls == NULL || replayed.balls == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	muteBrickBursts(true);
+
+	do {
+		openMatch(&match, level, FOUR_PL, 0);
+
+		over = false;
+		for (tick = 0; tick < MATCH_TICKS && !over; ++tick) {
+			t = clockNow();
+			saveSimulation(&ring[tick % (ROLLBACK_TICKS + 1)]);
+			saveTime += clockNow() - t;
+			actions[tick % (ROLLBACK_TICKS + 1)] = chaseBalls();
+			simulationTick(actions[tick % (ROLLBACK_TICKS + 1)]);
+			++ticks;
+
+			if (tick >= ROLLBACK_TICKS && tick % ROLLBACK_TICKS == 0) {
+				saveSimulation(&check);
+				t = clockNow();
+				restoreSimulation(&ring[(tick + 1 - ROLLBACK_TICKS) % (ROLLBACK_TICKS + 1)]);
+				for (k = tick + 1 - ROLLBACK_TICKS; k <= tick; ++k) {
+					simulationTick(actions[k % (ROLLBACK_TICKS + 1)]);
+				}
+				t = clockNow() - t;
+				rollbackTime += t;
+				if (nbRollbacks == capacity) {
+					capacity = capacity ? capacity * 2 : 1024;
+					if ((rollbackTimes = realloc(rollbackTimes, capacity * sizeof(unsigned long))) == NULL) {
+						exit(MALLOC_ERROR);
+					}
+				}
+				rollbackTimes[nbRollbacks++] = t;
+				saveSimulation(&replayed);
+				same = same && sameState(&check, &replayed, match.gridWidth * match.gridHeight);
+			}
+			for (i = 0; i < FOUR_PL; ++i) {
+				over = over || players[i].life <= 0;
+			}
+		}
+
+		closeMatch(&match);
+	} while (clockNow() - start < MIN_BENCH_TIME);
+
+	qsort(rollbackTimes, nbRollbacks, sizeof(unsigned long), compareTimes);
+	printf("ticks,rollbacks,save_ns_per_tick,rollback_%d_ticks_p50_us,p99_us,worst_us,mean_us,same_end\n",
+		ROLLBACK_TICKS);
+	printf("%ld,%ld,%.0f,%.1f,%.1f,%.1f,%.1f,%s\n", ticks, nbRollbacks, (double)saveTime / ticks,
+		rollbackTimes[nbRollbacks / 2] / 1000.0, rollbackTimes[((nbRollbacks - 1) * 99) / 100] / 1000.0,
+		rollbackTimes[nbRollbacks - 1] / 1000.0, rollbackTime / 1000.0 / nbRollbacks, same ? "yes" : "NO");
+	free(rollbackTimes);
+	return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file		spectators.c
+ *       		Spectator feed benchmark (make bench-spectators). Writes BENCH_FRAMES frames into the
+ * 			    spectator ring, ten times faster than the simulation ticks, while 0 to 16 spectator
+ * 			    processes read them with their own cursor. Every field of a frame comes from its
+ * 			    tick, so the spectators check each frame read is whole and newer than the last one.
+ * 			    Prints one CSV line per number of spectators : the write time per frame should not
+ * 			    depend on it.
+ * 			    Usage : bench_spectators
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define BENCH_FEED "/kasspong_bench_spectators"
+#define BENCH_FRAMES 20000
+#define FRAME_INTERVAL_NS ((SIM_TICK_DURATION * 1000000L) / 10)
+#define READER_POLL_NS 1000000L
+#define READER_IDLE_POLLS 2000
+#define MAX_READERS 16
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Fill a snapshot from its tick : scores, ball timers and bricks all tell the tick.
+ * @param	RenderSnapshot*	snapshot	the snapshot, with FOUR_PL balls
+ * @param	long						tick			the tick of the frame
+ */
+void fillFrame(RenderSnapshot *snapshot, long tick) {
+	int i;
+
+	snapshot->tick = tick;
+	for (i = 0; i < FOUR_PL; ++i) {
+		snapshot->players[i].score = tick & 0xFFFF;
+		snapshot->balls[i].respawnTimer = tick & 0xFF;
+	}
+	for (i = 0; i < snapshot->gridWidth * snapshot->gridHeight; ++i) {
+		snapshot->bricks[i].status = (tick + i) & 1 ? DESTROYED : PRISTINE;
+	}
+}
+
+/**
+ * Check a frame read is whole : every field tells the same tick.
+ * @param		NetState const*	state	the frame
+ * @return	bool									true if it is
+ */
+bool wholeFrame(NetState const *state) {
+	int i;
+
+	for (i = 0; i < FOUR_PL; ++i) {
+		if (state->players[i].score != (state->tick & 0xFFFF) || state->balls[i].respawnTimer != (state->tick & 0xFF)) {
+			return false;
+		}
+	}
+	for (i = 0; i < state->gridWidth * state->gridHeight; ++i) {
+		if (((state->bricks[i / 32] >> (i % 32)) & 1) != (((state->tick + i) & 1) == 0)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Body of a spectator process : read the frames until the last one, or until the feed is idle.
+ * @return	int	EXIT_SUCCESS, EXIT_FAILURE if a frame was torn or older than the previous one
+ */
+int runSpectator() {
+	struct timespec delay = {0, READER_POLL_NS};
+	static Spectator spectator;
+	NetState state;
+	long last = -1, idle = 0;
+
+	if (!attachSpectator(&spectator, BENCH_FEED)) {
+		return EXIT_FAILURE;
+	}
+	while (last < BENCH_FRAMES - 1 && idle < READER_IDLE_POLLS) {
+		if (!readSpectatorFrame(&spectator, &state)) {
+			++idle;
+			nanosleep(&delay, NULL);
+			continue;
+		}
+		idle = 0;
+		if (!wholeFrame(&state) || (long)state.tick <= last) {
+			return EXIT_FAILURE;
+		}
+		last = state.tick;
+	}
+	detachSpectator(&spectator);
+	return last == BENCH_FRAMES - 1 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Write the frames for 0, 1, 4 then 16 spectators.
+ * @param		argc	number of parameters of main
+ * @param		argv	unused
+ * @return	int		EXIT_SUCCESS, EXIT_FAILURE if a spectator read a wrong frame
+ */
+int main(int argc, char **argv) {
+	static int const nbReaders[] = {0, 1, 4, MAX_READERS};
+	static RenderSnapshot snapshot;
+	struct timespec delay = {0, FRAME_INTERVAL_NS}, attach = {0, 100000000L};
+	Ball frameBalls[FOUR_PL];
+	pid_t readers[MAX_READERS];
+	unsigned long t, writeTime, worst;
+	long tick;
+	int run, i, status, good;
+	bool same = true;
+
+	memset(frameBalls, 0, sizeof(frameBalls));
+	snapshot.nbPlayers = FOUR_PL;
+	snapshot.nbBalls = FOUR_PL;
+	snapshot.balls = frameBalls;
+	snapshot.gridWidth = GRID_MAX_WIDTH;
+	snapshot.gridHeight = GRID_MAX_HEIGHT;
+	for (i = 0; i < GRID_MAX_HEIGHT; ++i) {
+		snapshot.rows[i] = &snapshot.bricks[i * GRID_MAX_WIDTH];
+	}
+
+	printf("spectators,frames,write_ns,worst_write_us,spectators_ok\n");
+	for (run = 0; run < (int)(sizeof(nbReaders) / sizeof(nbReaders[0])); ++run) {
+		openSpectatorFeed(BENCH_FEED);
+		for (i = 0; i < nbReaders[run]; ++i) {
+			fflush(stdout);
+			if ((readers[i] = fork()) == 0) {
+				exit(runSpectator());
+			}
+		}
+		nanosleep(&attach, NULL);
+
+		writeTime = 0;
+		worst = 0;
+		for (tick = 0; tick < BENCH_FRAMES; ++tick) {
+			fillFrame(&snapshot, tick);
+			t = clockNow();
+			publishSpectatorFrame(&snapshot);
+			t = clockNow() - t;
+			writeTime += t;
+			worst = t > worst ? t : worst;
+			nanosleep(&delay, NULL);
+		}
+
+		good = 0;
+		for (i = 0; i < nbReaders[run]; ++i) {
+			if (readers[i] > 0 && waitpid(readers[i], &status, 0) == readers[i]
+				&& WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS) {
+				++good;
+			}
+		}
+		same = same && good == nbReaders[run];
+		closeSpectatorFeed();
+		printf("%d,%d,%.0f,%.1f,%d\n", nbReaders[run], BENCH_FRAMES, (double)writeTime / BENCH_FRAMES,
+			worst / 1000.0, good);
+	}
+	return same ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file		threads.c
+ *       		Parallel ball collision benchmark (make bench-threads). Plays the same ticks of many
+ * 			    balls on a level with 1 to 8 threads, checks that the balls, players and bricks end
+ * 			    exactly like on a single thread and prints one CSV line per number of balls and threads.
+ * 			    Usage : bench_threads [level] (res/grid_max.txt)
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define BENCH_TICKS 200
+#define BENCH_RADIUS 2
+#define MIN_BENCH_TIME 200000000UL
+
+/*/////////////////////////////////////////
+ //						STRUCTURES								//
+/////////////////////////////////////////*/
+
+typedef struct TicksEnd {
+	Ball *balls;
+	int lives[2];
+	int scores[2];
+	int widths[2];
+	int status[GRID_MAX_WIDTH * GRID_MAX_HEIGHT];
+} TicksEnd;
+
+/*/////////////////////////////////////////
+ //					BENCH FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Scatter small balls between the bars, random direction, always the same ones.
+ * @param	int	nbBalls	the number of balls
+ */
+void scatterBalls(int nbBalls) {
+	Point2D origin;
+	Vector2D speed;
+	int i;
+
+	srand(42);
+	free(balls);
+	if ((balls = malloc(nbBalls * sizeof(Ball))) == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	for (i = 0; i < nbBalls; ++i) {
+		initPoint2D(&origin, HUD_HEIGHT + BALL_RADIUS + (rand() % (SCREEN_WIDTH - (2 * (HUD_HEIGHT + BALL_RADIUS)))),
+			HUD_HEIGHT + (4 * BAR_HEIGHT) + (rand() % (SCREEN_HEIGHT - (2 * HUD_HEIGHT) - (8 * BAR_HEIGHT))));
+		initVector2D(&speed, rand() % 2 ? NORMAL : -NORMAL, rand() % 2 ? NORMAL : -NORMAL);
+		initBall(&balls[i], i, BENCH_RADIUS, speed, origin, themeColor, 1 + (i % 2));
+		balls[i].respawnTimer = 0;
+	}
+}
+
+/**
+ * Play BENCH_TICKS ticks of collisions and moves from the start of the level.
+ * @param		char const*	level		the config file of the level
+ * @param		int					nbBalls	the number of balls
+ * @param		TicksEnd*		end			the state after the ticks
+ * @return	unsigned long				nanoseconds spent in collideBalls
+ */
+unsigned long playTicks(char const *level, int nbBalls, TicksEnd *end) {
+	Match match;
+	int i, j;
+	unsigned long start, elapsed = 0;
+
+	openMatch(&match, level, TWO_PL, (1u << TWO_PL) - 1);
+	scatterBalls(nbBalls);
+
+	for (i = 0; i < BENCH_TICKS; ++i) {
+		start = clockNow();
+		collideBalls(match.grid, match.gridWidth, match.gridHeight, TWO_PL, nbBalls);
+		elapsed += clockNow() - start;
+		moveBalls(nbBalls);
+	}
+
+	memcpy(end->balls, balls, nbBalls * sizeof(Ball));
+	for (i = 0; i < TWO_PL; ++i) {
+		end->lives[i] = players[i].life;
+		end->scores[i] = players[i].score;
+		end->widths[i] = players[i].bar.width;
+	}
+	for (i = 0; i < match.gridHeight; ++i) {
+		for (j = 0; j < match.gridWidth; ++j) {
+			end->status[(i * match.gridWidth) + j] = match.grid[i][j].status;
+		}
+	}
+	closeMatch(&match);
+	return elapsed;
+}
+
+/**
+ * Play the same ticks until MIN_BENCH_TIME is spent.
+ * @param		char const*	level		the config file of the level
+ * @param		int					nbBalls	the number of balls
+ * @param		TicksEnd*		end			the state after the ticks
+ * @return	double							nanoseconds per tick
+ */
+double timeTicks(char const *level, int nbBalls, TicksEnd *end) {
+	unsigned long start = clockNow(), elapsed = 0;
+	long nbRuns = 0;
+
+	do {
+		elapsed += playTicks(level, nbBalls, end);
+		++nbRuns;
+	} while (clockNow() - start < MIN_BENCH_TIME);
+	return (double)elapsed / (nbRuns * BENCH_TICKS);
+}
+
+/**
+ * Compare two ends of the same ticks.
+ * @param		TicksEnd const*	a				the first end
+ * @param		TicksEnd const*	b				the second end
+ * @param		int							nbBalls	the number of balls
+ * @return	bool										true if they are the same
+ */
+bool sameEnd(TicksEnd const *a, TicksEnd const *b, int nbBalls) {
+	return memcmp(a->balls, b->balls, nbBalls * sizeof(Ball)) == 0
+		&& memcmp(a->lives, b->lives, sizeof(a->lives)) == 0
+		&& memcmp(a->scores, b->scores, sizeof(a->scores)) == 0
+		&& memcmp(a->widths, b->widths, sizeof(a->widths)) == 0
+		&& memcmp(a->status, b->status, sizeof(a->status)) == 0;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Run every number of balls on every number of threads.
+ * @param		argc	number of parameters of main
+ * @param		argv	the level to play
+ * @return	int		EXIT_SUCCESS, EXIT_FAILURE if some threads end differently from one
+ */
+int main(int argc, char **argv) {
+	static int const sizes[] = {256, 1024, 4096, 16384};
+	static int const threads[] = {1, 2, 4, 8};
+	char const *level = argc > 1 ? argv[1] : "res/grid_max.txt";
+	TicksEnd single, parallel;
+	double singleTime, time;
+	bool same, allSame = true;
+	int i, j, n;
+
+	initMatchDefaults("GladOS");
+
+	printf("balls,threads,us_per_tick,ns_per_ball,speedup,same_end\n");
+	for (i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); ++i) {
+		n = sizes[i];
+		single.balls = malloc(n * sizeof(Ball));
+		parallel.balls = malloc(n * sizeof(Ball));
+		if (single.balls == NULL || parallel.balls == NULL) {
+			exit(MALLOC_ERROR);
+		}
+		memset(single.status, 0, sizeof(single.status));
+		memset(parallel.status, 0, sizeof(parallel.status));
+
+		for (j = 0; j < (int)(sizeof(threads) / sizeof(threads[0])); ++j) {
+			startWorkers(threads[j]);
+			time = timeTicks(level, n, j ? &parallel : &single);
+			if (!j) {
+				singleTime = time;
+			}
+			same = !j || sameEnd(&single, &parallel, n);
+			allSame = allSame && same;
+			printf("%d,%d,%.1f,%.1f,%.2f,%s\n", n, workersCount(), time / 1000, time / n, singleTime / time,
+				same ? "yes" : "NO");
+		}
+		free(single.balls);
+		free(parallel.balls);
+	}
+	stopWorkers();
+	return allSame ? EXIT_SUCCESS : EXIT_FAILURE;
+}
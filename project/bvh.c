@@ -0,0 +1,479 @@
+/**
+ * @file		bvh.c
+ *       		bvh functions library. Bounding volume hierarchy over the living bricks of the grid,
+ * 			    built once per match. Moving bricks don't rebuild it : each moved brick refits its
+ * 			    leaf and the boxes above it (updateBrickCoordinates is the hook), a destroyed brick
+ * 			    leaves the tree. The balls only test the bricks whose box they touch.
+ * 			    moveBricks batches the refits of a tick : each box shared by several moved bricks
+ * 			    is refitted once instead of once per brick.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+/* empty until the first buildBrickTree : no grid matches it */
+static BrickTree tree;
+/* nodes to refit at endBrickRefits, only while batching */
+static bool refitBatching = false;
+static bool refitPending[BVH_CAPACITY];
+static int lastPending = -1;
+
+/*/////////////////////////////////////////
+ //					BUILD FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Build the tree of the living bricks of a grid. The previous tree is forgotten.
+ * @param	GridBrick	grid				the 2 dimensional brick grid
+ * @param	int				gridWidth		the number of columns in game
+ * @param	int				gridHeight	the number of lines
+ */
+void buildBrickTree(GridBrick grid, int gridWidth, int gridHeight) {
+	Brick *bricks[GRID_MAX_WIDTH * GRID_MAX_HEIGHT];
+	int i, j, nbBricks = 0;
+
+	for (i = 0; i < gridHeight; ++i) {
+		for (j = 0; j < gridWidth; ++j) {
+			grid[i][j].leaf = BVH_NO_NODE;
+			if (grid[i][j].status != DESTROYED) {
+				bricks[nbBricks++] = &grid[i][j];
+			}
+		}
+	}
+	tree.grid = grid;
+	tree.nbNodes = 0;
+	tree.margin = 0;
+	for (i = 0; i < nbBricks; ++i) {
+		if (bricks[i]->motion == SLIDE && tree.margin < 2 * BRICK_SLIDE_AMPLITUDE) {
+			tree.margin = 2 * BRICK_SLIDE_AMPLITUDE;
+		}
+		if (bricks[i]->motion == ORBIT && tree.margin < 2 * BRICK_ORBIT_RADIUS) {
+			tree.margin = 2 * BRICK_ORBIT_RADIUS;
+		}
+	}
+	tree.root = nbBricks ? buildBrickNode(bricks, nbBricks, BVH_NO_NODE) : BVH_NO_NODE;
+}
+
+/**
+ * Build a subtree : the bricks are split in two halves along the longest side of their corners.
+ * @param		Brick**	bricks		the bricks of the subtree (reordered)
+ * @param		int			nbBricks	the number of bricks, at least 1
+ * @param		int			parent		the parent node, BVH_NO_NODE for the root
+ * @return	int								the index of the subtree node
+ */
+int buildBrickNode(Brick **bricks, int nbBricks, int parent) {
+	int index = tree.nbNodes++;
+	BVHNode *node = &tree.nodes[index];
+	Point2D min, max;
+	Brick *brick;
+	bool alongX;
+	float key;
+	int i, j;
+
+	node->parent = parent;
+	node->left = BVH_NO_NODE;
+	node->right = BVH_NO_NODE;
+	node->brick = NULL;
+	if (nbBricks == 1) {
+		node->brick = bricks[0];
+		bricks[0]->leaf = index;
+		fitBrickNode(node);
+		return index;
+	}
+
+	initPoint2D(&min, bricks[0]->topLeft.x, bricks[0]->topLeft.y);
+	initPoint2D(&max, min.x, min.y);
+	for (i = 1; i < nbBricks; ++i) {
+		min.x = bricks[i]->topLeft.x < min.x ? bricks[i]->topLeft.x : min.x;
+		min.y = bricks[i]->topLeft.y < min.y ? bricks[i]->topLeft.y : min.y;
+		max.x = bricks[i]->topLeft.x > max.x ? bricks[i]->topLeft.x : max.x;
+		max.y = bricks[i]->topLeft.y > max.y ? bricks[i]->topLeft.y : max.y;
+	}
+	alongX = (max.x - min.x) >= (max.y - min.y);
+
+	/* insertion sort : at most one grid of bricks, once per match */
+	for (i = 1; i < nbBricks; ++i) {
+		brick = bricks[i];
+		key = alongX ? brick->topLeft.x : brick->topLeft.y;
+		for (j = i - 1; j >= 0 && (alongX ? bricks[j]->topLeft.x : bricks[j]->topLeft.y) > key; --j) {
+			bricks[j + 1] = bricks[j];
+		}
+		bricks[j + 1] = brick;
+	}
+
+	/* the node pointer isn't kept : the children are stored after it */
+	i = buildBrickNode(bricks, nbBricks / 2, index);
+	j = buildBrickNode(bricks + (nbBricks / 2), nbBricks - (nbBricks / 2), index);
+	tree.nodes[index].left = i;
+	tree.nodes[index].right = j;
+	fitBrickNode(&tree.nodes[index]);
+	return index;
+}
+
+/**
+ * Recompute the box of a node : the brick of a leaf, the union of the children otherwise.
+ * @param	BVHNode*	node	the node to fit
+ */
+void fitBrickNode(BVHNode *node) {
+	BVHNode const *left, *right;
+
+	if (node->brick != NULL) {
+		node->min = node->brick->topLeft;
+		node->max = node->brick->bottomRight;
+		return;
+	}
+	left = &tree.nodes[node->left];
+	right = &tree.nodes[node->right];
+	node->min.x = left->min.x < right->min.x ? left->min.x : right->min.x;
+	node->min.y = left->min.y < right->min.y ? left->min.y : right->min.y;
+	node->max.x = left->max.x > right->max.x ? left->max.x : right->max.x;
+	node->max.y = left->max.y > right->max.y ? left->max.y : right->max.y;
+}
+
+/*/////////////////////////////////////////
+ //					REFIT FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Refit the boxes from a node up to the root. Stops as soon as a box doesn't change :
+ * the boxes above it can't change either.
+ * @param	int	index	the first node to refit
+ */
+void refitBrickAncestors(int index) {
+	Point2D min, max;
+
+	while (index != BVH_NO_NODE) {
+		min = tree.nodes[index].min;
+		max = tree.nodes[index].max;
+		fitBrickNode(&tree.nodes[index]);
+		if (min.x == tree.nodes[index].min.x && min.y == tree.nodes[index].min.y
+			&& max.x == tree.nodes[index].max.x && max.y == tree.nodes[index].max.y) {
+			return;
+		}
+		index = tree.nodes[index].parent;
+	}
+}
+
+/**
+ * Refit the tree after a brick moved. Bricks out of the tree (destroyed, other grid) are ignored.
+ * While batching, the leaf is only marked : endBrickRefits refits it.
+ * @param	Brick const*	brick	the moved brick
+ */
+void refitBrick(Brick const *brick) {
+	if (brick->leaf == BVH_NO_NODE || brick->leaf >= tree.nbNodes || tree.nodes[brick->leaf].brick != brick) {
+		return;
+	}
+	if (refitBatching) {
+		refitPending[brick->leaf] = true;
+		lastPending = brick->leaf > lastPending ? brick->leaf : lastPending;
+		return;
+	}
+	refitBrickAncestors(brick->leaf);
+}
+
+/**
+ * Start batching the refits of the bricks of the tree. Other grids are ignored : their
+ * bricks never refit the tree.
+ * @param	GridBrick	grid	the grid whose bricks are about to move
+ */
+void beginBrickRefits(GridBrick grid) {
+	if (grid == tree.grid) {
+		refitBatching = true;
+	}
+}
+
+/**
+ * Refit the nodes marked since beginBrickRefits. A child is always stored after its parent,
+ * so going down the indices refits every child before its parent, and a parent is only
+ * marked when the box of a child changed, like refitBrickAncestors stops.
+ * @param	GridBrick	grid	the grid whose bricks moved
+ */
+void endBrickRefits(GridBrick grid) {
+	Point2D min, max;
+	int index;
+
+	if (grid != tree.grid || !refitBatching) {
+		return;
+	}
+	refitBatching = false;
+	for (index = lastPending; index >= 0; --index) {
+		if (!refitPending[index]) {
+			continue;
+		}
+		refitPending[index] = false;
+		min = tree.nodes[index].min;
+		max = tree.nodes[index].max;
+		fitBrickNode(&tree.nodes[index]);
+		if (tree.nodes[index].parent != BVH_NO_NODE
+			&& (min.x != tree.nodes[index].min.x || min.y != tree.nodes[index].min.y
+			|| max.x != tree.nodes[index].max.x || max.y != tree.nodes[index].max.y)) {
+			refitPending[tree.nodes[index].parent] = true;
+		}
+	}
+	lastPending = -1;
+}
+
+/**
+ * Take a destroyed brick out of the tree : its sibling replaces their parent.
+ * @param	Brick*	brick	the destroyed brick
+ */
+void removeBrick(Brick *brick) {
+	int leaf = brick->leaf, parent, sibling, grandParent;
+
+	if (leaf == BVH_NO_NODE || leaf >= tree.nbNodes || tree.nodes[leaf].brick != brick) {
+		return;
+	}
+	brick->leaf = BVH_NO_NODE;
+	tree.nodes[leaf].brick = NULL;
+
+	parent = tree.nodes[leaf].parent;
+	if (parent == BVH_NO_NODE) {
+		tree.root = BVH_NO_NODE;
+		return;
+	}
+	sibling = tree.nodes[parent].left == leaf ? tree.nodes[parent].right : tree.nodes[parent].left;
+	grandParent = tree.nodes[parent].parent;
+	tree.nodes[sibling].parent = grandParent;
+	if (grandParent == BVH_NO_NODE) {
+		tree.root = sibling;
+		return;
+	}
+	if (tree.nodes[grandParent].left == parent) {
+		tree.nodes[grandParent].left = sibling;
+	} else {
+		tree.nodes[grandParent].right = sibling;
+	}
+	refitBrickAncestors(grandParent);
+}
+
+/*/////////////////////////////////////////
+ //					QUERY FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Find the brick hit by a ball. When several bricks are hit, the first one in the grid
+ * (line by line) is returned, like a scan of the whole grid would.
+ * @param		Ball const*			ball				the current ball pointer
+ * @param		enum direction*	collision		the collided side of the returned brick
+ * @return	Brick*											the brick hit, NULL if none
+ */
+Brick *queryBrickTree(Ball const *ball, enum direction *collision) {
+	int stack[BVH_STACK_SIZE];
+	int top = 0;
+	BVHNode const *node;
+	Brick *hit = NULL;
+	enum direction side;
+	/* one pixel more than the radius : collisionBallLine truncates its distance */
+	float reach = ball->radius + 1;
+
+	*collision = NONE;
+	if (tree.root == BVH_NO_NODE) {
+		return NULL;
+	}
+	stack[top++] = tree.root;
+	while (top) {
+		node = &tree.nodes[stack[--top]];
+		if (ball->origin.x + reach < node->min.x || ball->origin.x - reach > node->max.x
+			|| ball->origin.y + reach < node->min.y || ball->origin.y - reach > node->max.y) {
+			continue;
+		}
+		if (node->brick == NULL) {
+			stack[top++] = node->left;
+			stack[top++] = node->right;
+			continue;
+		}
+		if (hit != NULL && (node->brick->gridX > hit->gridX
+			|| (node->brick->gridX == hit->gridX && node->brick->gridY > hit->gridY))) {
+			continue;
+		}
+		if ((side = collisionBallBrick(ball, node->brick)) != NONE) {
+			hit = node->brick;
+			*collision = side;
+		}
+	}
+	return hit;
+}
+
+/**
+ * Find when a point moving in a straight line enters a box (slab method).
+ * @param		Point2D		origin	the point at time 0
+ * @param		Vector2D	speed		the move of the point per time unit
+ * @param		Point2D		min			the top left corner of the box
+ * @param		Point2D		max			the bottom right corner of the box
+ * @return	float							the first time (0 if already inside) in the box, -1 if never
+ */
+float rayBoxEntry(Point2D origin, Vector2D speed, Point2D min, Point2D max) {
+	float entry = 0, exit = EVENT_NEVER, t1, t2, tmp;
+
+	if (speed.x == 0) {
+		if (origin.x < min.x || origin.x > max.x) {
+			return -1;
+		}
+	} else {
+		t1 = (min.x - origin.x) / speed.x;
+		t2 = (max.x - origin.x) / speed.x;
+		if (t1 > t2) {
+			tmp = t1;
+			t1 = t2;
+			t2 = tmp;
+		}
+		entry = t1 > entry ? t1 : entry;
+		exit = t2 < exit ? t2 : exit;
+	}
+	if (speed.y == 0) {
+		if (origin.y < min.y || origin.y > max.y) {
+			return -1;
+		}
+	} else {
+		t1 = (min.y - origin.y) / speed.y;
+		t2 = (max.y - origin.y) / speed.y;
+		if (t1 > t2) {
+			tmp = t1;
+			t1 = t2;
+			t2 = tmp;
+		}
+		entry = t1 > entry ? t1 : entry;
+		exit = t2 < exit ? t2 : exit;
+	}
+	return entry <= exit ? entry : -1;
+}
+
+/**
+ * Find how long a ball can't touch a brick, from the gap between them now : on each axis
+ * the gap closes at most by the speed of the ball plus the fastest move of the brick. A
+ * ball flying away faster than the brick can follow, already out of contact, never does.
+ * @param		Ball const*		ball		the ball, at its position before the first tick
+ * @param		Vector2D			speed		the move of the ball per tick
+ * @param		Brick const*	brick		the brick
+ * @param		float					reach		distance from the center at which the ball may touch a box
+ * @return	float									the ticks before the gap may close, 0 if it is closed
+ */
+float brickSeparation(Ball const *ball, Vector2D speed, Brick const *brick, float reach) {
+	float drift[2], gap[2], away[2], closing, ticks = 0;
+	int i;
+
+	drift[0] = brick->motion == SLIDE ? BRICK_SLIDE_DRIFT : (brick->motion == ORBIT ? BRICK_ORBIT_DRIFT : 0);
+	drift[1] = brick->motion == ORBIT ? BRICK_ORBIT_DRIFT : 0;
+	if (ball->origin.x < brick->topLeft.x) {
+		gap[0] = brick->topLeft.x - ball->origin.x;
+		away[0] = -speed.x;
+	} else {
+		gap[0] = ball->origin.x - brick->bottomRight.x;
+		away[0] = speed.x;
+	}
+	if (ball->origin.y < brick->topLeft.y) {
+		gap[1] = brick->topLeft.y - ball->origin.y;
+		away[1] = -speed.y;
+	} else {
+		gap[1] = ball->origin.y - brick->bottomRight.y;
+		away[1] = speed.y;
+	}
+	for (i = 0; i < 2; ++i) {
+		closing = drift[i] - away[i];
+		if (closing <= 0 && gap[i] >= ball->radius + EVENT_DRIFT) {
+			return EVENT_NEVER;
+		}
+		if (closing > 0 && gap[i] > reach) {
+			ticks = (gap[i] - reach) / closing > ticks ? (gap[i] - reach) / closing : ticks;
+		}
+	}
+	return ticks;
+}
+
+/**
+ * Find the first tick at which a ball moving in a straight line could touch a brick of the tree.
+ * The moving bricks are taken on their whole path, then every brick closer with brickSeparation.
+ * @param		Ball const*	ball	the ball, at its position before the first tick
+ * @param		Vector2D		speed	the move of the ball per tick (zero for a respawning ball)
+ * @param		float				reach	distance from the center at which the ball may touch a box
+ * @param		long				limit	the most ticks looked at : the boxes entered later are skipped
+ * @return	long							the number of ticks without any brick contact, limit if more
+ */
+long nextBrickImpact(Ball const *ball, Vector2D speed, float reach, long limit) {
+	int stack[BVH_STACK_SIZE];
+	int top = 0;
+	BVHNode const *node;
+	Brick const *brick;
+	Point2D min, max;
+	float entry, best = limit, margin, separation;
+
+	if (tree.root == BVH_NO_NODE) {
+		return limit;
+	}
+	stack[top++] = tree.root;
+	while (top) {
+		node = &tree.nodes[stack[--top]];
+		brick = node->brick;
+		margin = reach + (brick == NULL ? tree.margin : 0);
+		if (brick != NULL && brick->motion == SLIDE) {
+			initPoint2D(&min, brick->home.x - BRICK_SLIDE_AMPLITUDE, brick->home.y);
+			initPoint2D(&max, brick->home.x + BRICK_SLIDE_AMPLITUDE + BRICK_WIDTH, brick->home.y + BRICK_HEIGHT);
+		} else if (brick != NULL && brick->motion == ORBIT) {
+			initPoint2D(&min, brick->home.x - BRICK_ORBIT_RADIUS, brick->home.y);
+			initPoint2D(&max, brick->home.x + BRICK_ORBIT_RADIUS + BRICK_WIDTH,
+				brick->home.y + (2 * BRICK_ORBIT_RADIUS) + BRICK_HEIGHT);
+		} else {
+			min = node->min;
+			max = node->max;
+		}
+		initPoint2D(&min, min.x - margin, min.y - margin);
+		initPoint2D(&max, max.x + margin, max.y + margin);
+		entry = rayBoxEntry(ball->origin, speed, min, max);
+		if (entry < 0 || entry >= best) {
+			continue;
+		}
+		if (brick == NULL) {
+			stack[top++] = node->left;
+			stack[top++] = node->right;
+			continue;
+		}
+		separation = brickSeparation(ball, speed, brick, reach);
+		entry = separation > entry ? separation : entry;
+		best = entry < best ? entry : best;
+	}
+	return best >= EVENT_NEVER ? EVENT_NEVER : (long)floor(best);
+}
+
+/**
+ * Get the tree, to know which grid it was built for.
+ * @return	BrickTree const*	the brick tree
+ */
+BrickTree const *brickTree() {
+	return &tree;
+}
+
+/**
+ * Copy the tree, to put it back after a rollback : only the nodes in use.
+ * @param	BrickTree*	copy	the copy
+ */
+void saveBrickTree(BrickTree *copy) {
+	memcpy(copy->nodes, tree.nodes, tree.nbNodes * sizeof(BVHNode));
+	copy->nbNodes = tree.nbNodes;
+	copy->root = tree.root;
+	copy->grid = tree.grid;
+	copy->margin = tree.margin;
+}
+
+/**
+ * Put back a tree saved by saveBrickTree. The bricks must be back where they were too.
+ * @param	BrickTree const*	copy	the copy
+ */
+void restoreBrickTree(BrickTree const *copy) {
+	memcpy(tree.nodes, copy->nodes, copy->nbNodes * sizeof(BVHNode));
+	tree.nbNodes = copy->nbNodes;
+	tree.root = copy->root;
+	tree.grid = copy->grid;
+	tree.margin = copy->margin;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file		capture.c
+ *       		capture functions library. Read every captured frame back through two pixel buffer
+ * 			    objects (the frame N is read while the frame N+1 is drawn, glReadPixels never waits
+ * 			    for the GPU) and stream them as Y4M video from a writer thread, to a file or a pipe.
+ * 			    The video follows the game time, not the render loop : each frame drawn covers the
+ * 			    ticks played since the previous one, so it is written as many times as video frames
+ * 			    fall in them (none if the loop draws faster than the frame rate). The frames the
+ * 			    writer couldn't take are replaced by copies of the next one.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 199309L
+#define GL_GLEXT_PROTOTYPES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_thread.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static FILE *captureFile = NULL;
+static bool capturePipe = false;
+static int captureWidth, captureHeight, captureFps;
+
+static GLuint capturePBO[2];
+static int captureReadRepeats[2];
+static bool captureAsync = false;
+static unsigned long captureRead = 0;
+
+/* the game time covered : ticks played, last tick drawn, video frames given to the queue */
+static long captureTicks = 0;
+static long captureLastTick = -1;
+static unsigned long captureFrames = 0;
+static int captureMissing = 0;
+
+static GLubyte *captureQueue[CAPTURE_QUEUE_SIZE];
+static int captureRepeats[CAPTURE_QUEUE_SIZE];
+static unsigned long captureHead = 0;
+static unsigned long captureTail = 0;
+static unsigned long captureDropped = 0;
+static GLubyte *capturePlanes = NULL;
+
+static SDL_Thread *captureThread = NULL;
+static int captureRunning = 0;
+
+static unsigned long captureGameTime = 0;
+static unsigned long captureWriterTime = 0;
+static unsigned long captureWritten = 0;
+
+/*/////////////////////////////////////////
+ //					WRITER FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Convert a bottom-up RGBA frame into top-down 4:2:0 planes (BT.601) and write it as Y4M frames.
+ * @param	GLubyte const*	rgba		the frame read back from OpenGL
+ * @param	int							repeats	the number of video frames it lasts
+ */
+void writeCaptureFrame(GLubyte const *rgba, int repeats) {
+	GLubyte *y = capturePlanes;
+	GLubyte *u = y + (captureWidth * captureHeight);
+	GLubyte *v = u + ((captureWidth / 2) * (captureHeight / 2));
+	GLubyte const *pixel;
+	int i, j, r, g, b, row;
+
+	for (i = 0; i < captureHeight; ++i) {
+		pixel = &rgba[(captureHeight - 1 - i) * captureWidth * 4];
+		for (j = 0; j < captureWidth; ++j, pixel += 4) {
+			y[(i * captureWidth) + j] = 16 + (((66 * pixel[0]) + (129 * pixel[1]) + (25 * pixel[2]) + 128) >> 8);
+		}
+	}
+	/* one chroma sample for each 2x2 block */
+	for (i = 0; i < captureHeight / 2; ++i) {
+		row = (captureHeight - 2 - (2 * i)) * captureWidth * 4;
+		for (j = 0; j < captureWidth / 2; ++j) {
+			pixel = &rgba[row + (j * 8)];
+			r = (pixel[0] + pixel[4] + pixel[(captureWidth * 4)] + pixel[(captureWidth * 4) + 4]) / 4;
+			g = (pixel[1] + pixel[5] + pixel[(captureWidth * 4) + 1] + pixel[(captureWidth * 4) + 5]) / 4;
+			b = (pixel[2] + pixel[6] + pixel[(captureWidth * 4) + 2] + pixel[(captureWidth * 4) + 6]) / 4;
+			u[(i * (captureWidth / 2)) + j] = 128 + (((-38 * r) - (74 * g) + (112 * b) + 128) >> 8);
+			v[(i * (captureWidth / 2)) + j] = 128 + (((112 * r) - (94 * g) - (18 * b) + 128) >> 8);
+		}
+	}
+
+	for (; repeats > 0; --repeats) {
+		fprintf(captureFile, "FRAME\n");
+		fwrite(capturePlanes, 1, (captureWidth * captureHeight * 3) / 2, captureFile);
+		++captureWritten;
+	}
+}
+
+/**
+ * Write every queued frame. Single consumer side of the queue : only the writer thread moves the tail.
+ */
+void drainCapture() {
+	unsigned long head = __atomic_load_n(&captureHead, __ATOMIC_ACQUIRE);
+	unsigned long tail = captureTail, start;
+
+	while (tail != head) {
+		start = clockNow();
+		writeCaptureFrame(captureQueue[tail % CAPTURE_QUEUE_SIZE], captureRepeats[tail % CAPTURE_QUEUE_SIZE]);
+		captureWriterTime += clockNow() - start;
+		++tail;
+		__atomic_store_n(&captureTail, tail, __ATOMIC_RELEASE);
+	}
+}
+
+/**
+ * Body of the writer thread : conversion and disk (or pipe) never run on the GL thread.
+ * @param		void*	data	unused
+ * @return	int					0
+ */
+int captureWriterThread(void *data) {
+	while (__atomic_load_n(&captureRunning, __ATOMIC_ACQUIRE)) {
+		drainCapture();
+		SDL_Delay(2);
+	}
+	drainCapture();
+	return 0;
+}
+
+/*/////////////////////////////////////////
+ //					CAPTURE FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Start capturing the frames of the current GL context into a Y4M video.
+ * @param		char const*	path		the video file, "-" for stdout or "|command" for a pipe
+ * @param		int					width		frame width in pixels (even)
+ * @param		int					height	frame height in pixels (even)
+ * @param		int					fps			frame rate of the video, in game time
+ * @return	bool								false if the output can't be opened
+ */
+bool startCapture(char const *path, int width, int height, int fps) {
+	char const *extensions = (char const *)glGetString(GL_EXTENSIONS);
+	int i;
+
+	if (path[0] == '|') {
+		captureFile = popen(path + 1, "w");
+		capturePipe = true;
+	} else if (strcmp(path, "-") == 0) {
+		captureFile = stdout;
+	} else {
+		captureFile = fopen(path, "wb");
+	}
+	if (captureFile == NULL) {
+		printf("ERROR : Impossible to open the capture output '%s'.\n", path);
+		return false;
+	}
+	captureWidth = width & ~1;
+	captureHeight = height & ~1;
+	captureFps = fps;
+	fprintf(captureFile, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", captureWidth, captureHeight, fps);
+
+	for (i = 0; i < CAPTURE_QUEUE_SIZE; ++i) {
+		if ((captureQueue[i] = malloc(captureWidth * captureHeight * 4)) == NULL) {
+			exit(MALLOC_ERROR);
+		}
+	}
+	if ((capturePlanes = malloc((captureWidth * captureHeight * 3) / 2)) == NULL) {
+		exit(MALLOC_ERROR);
+	}
+
+	captureAsync = extensions != NULL && strstr(extensions, "GL_ARB_pixel_buffer_object") != NULL;
+	if (captureAsync) {
+		glGenBuffersARB(2, capturePBO);
+		for (i = 0; i < 2; ++i) {
+			glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, capturePBO[i]);
+			glBufferDataARB(GL_PIXEL_PACK_BUFFER_ARB, captureWidth * captureHeight * 4, NULL, GL_STREAM_READ_ARB);
+		}
+		glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+	}
+	captureRead = captureHead = captureTail = 0;
+	captureDropped = captureWritten = captureGameTime = captureWriterTime = 0;
+	captureTicks = 0;
+	captureLastTick = -1;
+	captureFrames = 0;
+	captureMissing = 0;
+
+	captureRunning = 1;
+	captureThread = SDL_CreateThread(captureWriterThread, NULL);
+	return true;
+}
+
+/**
+ * Queue a frame for the writer thread. Never blocks : if the writer is a full queue behind,
+ * the frame is dropped and the next one queued lasts its video frames too, so the capture
+ * never slows the game down and the video keeps the game time.
+ * @param	GLubyte const*	rgba		the frame pixels
+ * @param	int							repeats	the number of video frames it lasts
+ */
+void queueCaptureFrame(GLubyte const *rgba, int repeats) {
+	unsigned long head = captureHead;
+
+	if (head - __atomic_load_n(&captureTail, __ATOMIC_ACQUIRE) >= CAPTURE_QUEUE_SIZE) {
+		++captureDropped;
+		captureMissing += repeats;
+		return;
+	}
+	memcpy(captureQueue[head % CAPTURE_QUEUE_SIZE], rgba, captureWidth * captureHeight * 4);
+	captureRepeats[head % CAPTURE_QUEUE_SIZE] = repeats + captureMissing;
+	captureMissing = 0;
+	__atomic_store_n(&captureHead, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Collect the frame read into a pixel buffer object by a previous captureFrame.
+ * @param	int	index	the pixel buffer object to map
+ */
+void collectCaptureFrame(int index) {
+	GLubyte const *rgba;
+
+	glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, capturePBO[index]);
+	rgba = glMapBufferARB(GL_PIXEL_PACK_BUFFER_ARB, GL_READ_ONLY_ARB);
+	if (rgba != NULL) {
+		queueCaptureFrame(rgba, captureReadRepeats[index]);
+		glUnmapBufferARB(GL_PIXEL_PACK_BUFFER_ARB);
+	}
+	glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+}
+
+/**
+ * Count the video frames the frame drawn lasts : the ones falling in the ticks played since the
+ * previous frame drawn. Going back (a rewind) counts as playing, a jump of more than a second (a new
+ * match) as one tick.
+ * @param		long	tick	the tick of the frame drawn
+ * @return	int					the number of video frames, 0 if the frame is not in the video
+ */
+int captureRepeatCount(long tick) {
+	long played = labs(tick - captureLastTick);
+	unsigned long due;
+
+	if (captureLastTick >= 0) {
+		captureTicks += played > 1000 / SIM_TICK_DURATION ? 1 : played;
+	}
+	captureLastTick = tick;
+	/* video frame k shows the game at k / fps seconds */
+	due = ((captureTicks * SIM_TICK_DURATION * captureFps) / 1000) + 1;
+	if (due <= captureFrames) {
+		return 0;
+	}
+	due -= captureFrames;
+	captureFrames += due;
+	return due;
+}
+
+/**
+ * Capture the frame just drawn (call it before the buffers swap). The read is only
+ * started here, the frame is collected on the next call, once the GPU is done with it.
+ * @param	long	tick	the tick of the frame drawn, which places it in the video
+ */
+void captureFrame(long tick) {
+	unsigned long start;
+	int index, repeats;
+
+	if (captureFile == NULL) {
+		return;
+	}
+	if ((repeats = captureRepeatCount(tick)) == 0) {
+		return;
+	}
+	start = clockNow();
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	if (captureAsync) {
+		index = captureRead % 2;
+		captureReadRepeats[index] = repeats;
+		glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, capturePBO[index]);
+		glReadPixels(0, 0, captureWidth, captureHeight, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+		glBindBufferARB(GL_PIXEL_PACK_BUFFER_ARB, 0);
+		if (captureRead > 0) {
+			collectCaptureFrame(!index);
+		}
+	} else {
+		/* no pixel buffer objects : synchronous read in the slot of the queue */
+		if (captureHead - __atomic_load_n(&captureTail, __ATOMIC_ACQUIRE) >= CAPTURE_QUEUE_SIZE) {
+			++captureDropped;
+			captureMissing += repeats;
+		} else {
+			glReadPixels(0, 0, captureWidth, captureHeight, GL_RGBA, GL_UNSIGNED_BYTE,
+				captureQueue[captureHead % CAPTURE_QUEUE_SIZE]);
+			captureRepeats[captureHead % CAPTURE_QUEUE_SIZE] = repeats + captureMissing;
+			captureMissing = 0;
+			__atomic_store_n(&captureHead, captureHead + 1, __ATOMIC_RELEASE);
+		}
+	}
+	++captureRead;
+	captureGameTime += clockNow() - start;
+}
+
+/**
+ * Collect the last frame, stop the writer thread, close the video and report the overhead.
+ * Must be called while the GL context still exists.
+ */
+void stopCapture() {
+	int i;
+
+	if (captureFile == NULL) {
+		return;
+	}
+	if (captureAsync) {
+		if (captureRead > 0) {
+			collectCaptureFrame((captureRead - 1) % 2);
+		}
+		glDeleteBuffersARB(2, capturePBO);
+	}
+	__atomic_store_n(&captureRunning, 0, __ATOMIC_RELEASE);
+	SDL_WaitThread(captureThread, NULL);
+	captureThread = NULL;
+
+	if (capturePipe) {
+		pclose(captureFile);
+	} else if (captureFile != stdout) {
+		fclose(captureFile);
+	}
+	captureFile = NULL;
+	capturePipe = false;
+
+	fprintf(stderr, "Capture : %lu frames written (%.1f s at %d fps), %lu dropped, %s readback, GL thread %.3f ms/frame, writer %.3f ms/frame\n",
+		captureWritten, (double)captureWritten / captureFps, captureFps, captureDropped, captureAsync ? "PBO" : "synchronous",
+		captureRead ? captureGameTime / 1e6 / captureRead : 0, captureWritten ? captureWriterTime / 1e6 / captureWritten : 0);
+
+	for (i = 0; i < CAPTURE_QUEUE_SIZE; ++i) {
+		free(captureQueue[i]);
+		captureQueue[i] = NULL;
+	}
+	free(capturePlanes);
+	capturePlanes = NULL;
+}
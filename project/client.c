@@ -0,0 +1,291 @@
+/**
+ * @file		client.c
+ *       		client functions library. Draw the matches of a server on another machine,
+ * 			    KASSPONG_CONNECT=host:port KASSPONG_SEAT=2 : no simulation here, the snapshots
+ * 			    received are expanded into the RenderSnapshot drawn by the GL thread, the balls
+ * 			    carried on at their speed until the next one. The keys of the seat are sent when
+ * 			    they change, with every acknowledgement and at least every NET_KEEPALIVE ms.
+ * 			    The names, colors and orientations of the bars and the level come from the local
+ * 			    menu : the same mode and level as the server.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					CLIENT FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Prepare the snapshot drawn from the states received : the level and the players of the
+ * local menu, no ball until the first state.
+ * @param	NetClient*			client			the client
+ * @param	GridBrick				grid				the 2 dimensional brick grid of the level
+ * @param	int							gridWidth		the number of columns in game
+ * @param	int							gridHeight	the number of lines
+ * @param	Player const*		players			the players of the local menu (names, bars)
+ * @param	int							nbPlayers		the number of players of the local menu
+ */
+void initClientSnapshot(NetClient *client, GridBrick grid, int gridWidth, int gridHeight, Player const *players,
+	int nbPlayers) {
+	RenderSnapshot *snapshot = &client->snapshot;
+	Point2D center;
+	Vector2D still;
+	int i;
+
+	client->gridWidth = gridWidth;
+	client->gridHeight = gridHeight;
+	client->nbTemplatePlayers = nbPlayers < 4 ? nbPlayers : 4;
+
+	snapshot->gridWidth = gridWidth;
+	snapshot->gridHeight = gridHeight;
+	snapshot->nbPlayers = client->nbTemplatePlayers;
+	memcpy(snapshot->players, players, client->nbTemplatePlayers * sizeof(Player));
+	for (i = 0; i < GRID_MAX_HEIGHT; ++i) {
+		snapshot->rows[i] = &snapshot->bricks[i * GRID_MAX_WIDTH];
+	}
+	for (i = 0; i < gridHeight; ++i) {
+		memcpy(snapshot->rows[i], grid[i], gridWidth * sizeof(Brick));
+	}
+	initPoint2D(&center, SCREEN_WIDTH / 2, SCREEN_HEIGHT / 2);
+	initVector2D(&still, 0, 0);
+	for (i = 0; i < NET_MAX_BALLS; ++i) {
+		initBall(&client->balls[i], i, BALL_RADIUS, still, center, themeColor, 0);
+	}
+	snapshot->balls = client->balls;
+	snapshot->nbBalls = 0;
+}
+
+/**
+ * Connect to a server : the first keys sent take the seat.
+ * @param	NetClient*			client			the client
+ * @param	Uint32					host				the server address, network byte order
+ * @param	Uint16					port				the server port, network byte order
+ * @param	int							seat				the seat played, from 0
+ * @param	GridBrick				grid				the 2 dimensional brick grid of the level
+ * @param	int							gridWidth		the number of columns in game
+ * @param	int							gridHeight	the number of lines
+ * @param	Player const*		players			the players of the local menu (names, bars)
+ * @param	int							nbPlayers		the number of players of the local menu
+ */
+void startClient(NetClient *client, Uint32 host, Uint16 port, int seat, GridBrick grid, int gridWidth,
+	int gridHeight, Player const *players, int nbPlayers) {
+	memset(client, 0, sizeof(NetClient));
+	openSocket(&client->socket, 0);
+	client->host = host;
+	client->port = port;
+	client->seat = seat & 3;
+	initClientSnapshot(client, grid, gridWidth, gridHeight, players, nbPlayers);
+
+	sendInput(client, 0);
+}
+
+/**
+ * Leave the server, it gives the seat back after NET_TIMEOUT ms.
+ * @param	NetClient*	client	the client
+ */
+void stopClient(NetClient *client) {
+	closeSocket(&client->socket);
+}
+
+/**
+ * Give the keys of the seat played : any seat of the keyboard plays it.
+ * @param		unsigned int	actions	the actions of the keyboard
+ * @return	unsigned int					SHARED_MINUS, SHARED_PLUS or both
+ */
+unsigned int clientKeys(unsigned int actions) {
+	unsigned int keys = 0;
+	int seat;
+
+	for (seat = 0; seat < 4; ++seat) {
+		keys |= (actions >> (2 * seat)) & (SHARED_MINUS | SHARED_PLUS);
+	}
+	return keys;
+}
+
+/**
+ * Send the keys of the seat with the last snapshot received (7 bytes).
+ * @param	NetClient*		client	the client
+ * @param	unsigned int	keys		SHARED_MINUS, SHARED_PLUS or both
+ */
+void sendInput(NetClient *client, unsigned int keys) {
+	unsigned char data[8];
+	BitStream stream;
+
+	initBitStream(&stream, data, sizeof(data));
+	writeBits(&stream, NET_PROTOCOL, 16);
+	writeBits(&stream, NET_INPUT, 2);
+	writeBits(&stream, client->seat, 2);
+	writeBits(&stream, ++client->inputSequence, 16);
+	writeBits(&stream, client->hasState, 1);
+	writeBits(&stream, client->sequence, 16);
+	writeBits(&stream, keys, 2);
+	sendPacket(&client->socket, client->host, client->port, data, bitStreamBytes(&stream));
+
+	client->sentKeys = keys;
+	client->lastSend = SDL_GetTicks();
+}
+
+/**
+ * Decode a snapshot of the server against the baseline it names. The snapshots older than
+ * the last one decoded are dropped.
+ * @param	NetClient*			client	the client
+ * @param	unsigned char*	data		the packet
+ * @param	int							length	the packet size
+ */
+void receiveSnapshot(NetClient *client, unsigned char *data, int length) {
+	static NetState const none;
+	NetState const *baseline = &none;
+	NetState state;
+	BitStream stream;
+	Uint16 sequence;
+
+	initBitStream(&stream, data, length);
+	if (readBits(&stream, 16) != NET_PROTOCOL || readBits(&stream, 2) != NET_SNAPSHOT) {
+		return;
+	}
+	sequence = readBits(&stream, 16);
+	if (client->hasState && !newerSequence(sequence, client->sequence)) {
+		return;
+	}
+	if (readBits(&stream, 1) && (baseline = findNetState(&client->received, readBits(&stream, 16))) == NULL) {
+		++client->snapshotsUndecodable;
+		return;
+	}
+	readNetState(&stream, &state, baseline);
+	if (stream.overflow) {
+		++client->snapshotsUndecodable;
+		return;
+	}
+
+	if (client->hasState) {
+		client->snapshotsLost += (Uint16)(sequence - client->sequence) - 1;
+	}
+	++client->snapshotsReceived;
+	storeNetState(&client->received, &state, sequence);
+	client->state = state;
+	client->sequence = sequence;
+	client->hasState = true;
+	client->stateTime = SDL_GetTicks();
+}
+
+/**
+ * Expand the last state received into the snapshot drawn : bars, HUD values, balls, bricks.
+ * The bricks move with the tick, like in the simulation.
+ * @param	NetClient*	client	the client
+ */
+void expandNetState(NetClient *client) {
+	RenderSnapshot *snapshot = &client->snapshot;
+	NetState const *state = &client->state;
+	Player *player;
+	Ball *ball;
+	Brick *brick;
+	int index, i, j;
+
+	snapshot->tick = state->tick;
+	snapshot->over = state->over;
+	snapshot->nbPlayers = state->nbPlayers < client->nbTemplatePlayers ? state->nbPlayers : client->nbTemplatePlayers;
+	for (i = 0; i < snapshot->nbPlayers; ++i) {
+		player = &snapshot->players[i];
+		player->life = state->players[i].life;
+		player->score = state->players[i].score;
+		player->bar.width = state->players[i].width;
+		initPoint2D(&player->bar.center, dequantize(state->players[i].x, NET_POSITION_OFFSET),
+			dequantize(state->players[i].y, NET_POSITION_OFFSET));
+	}
+	snapshot->nbBalls = state->nbBalls;
+	for (i = 0; i < state->nbBalls; ++i) {
+		ball = &client->balls[i];
+		ball->radius = state->balls[i].radius;
+		ball->respawnTimer = state->balls[i].respawnTimer;
+		ball->lastPlayerId = state->balls[i].lastPlayerId;
+		initVector2D(&ball->speed, dequantize(state->balls[i].speedX, NET_SPEED_OFFSET),
+			dequantize(state->balls[i].speedY, NET_SPEED_OFFSET));
+	}
+
+	snapshot->gridWidth = state->gridWidth < client->gridWidth ? state->gridWidth : client->gridWidth;
+	snapshot->gridHeight = state->gridHeight < client->gridHeight ? state->gridHeight : client->gridHeight;
+	for (i = 0; i < snapshot->gridHeight; ++i) {
+		for (j = 0; j < snapshot->gridWidth; ++j) {
+			brick = &snapshot->rows[i][j];
+			index = (i * state->gridWidth) + j;
+			if (!((state->bricks[index / 32] >> (index % 32)) & 1)) {
+				brick->status = DESTROYED;
+				continue;
+			}
+			if (brick->status == DESTROYED) {
+				brick->status = PRISTINE;
+			}
+			brick->phase = state->tick % (BRICK_SLIDE_PERIOD * BRICK_ORBIT_PERIOD);
+		}
+	}
+	moveBricks((GridBrick)snapshot->rows, snapshot->gridWidth, snapshot->gridHeight, 0);
+}
+
+/**
+ * Carry the balls of the last state on at their speed.
+ * @param	NetClient*	client	the client
+ * @param	long				elapsed	the ticks since the last state
+ */
+void extrapolateBalls(NetClient *client, long elapsed) {
+	NetBall const *state;
+	Ball *ball;
+	int i;
+
+	for (i = 0; i < client->state.nbBalls; ++i) {
+		state = &client->state.balls[i];
+		ball = &client->balls[i];
+		initPoint2D(&ball->origin, dequantize(state->x, NET_POSITION_OFFSET),
+			dequantize(state->y, NET_POSITION_OFFSET));
+		if (!state->respawnTimer) {
+			ball->origin.x += ball->speed.x * elapsed;
+			ball->origin.y += ball->speed.y * elapsed;
+		}
+	}
+	client->snapshot.tick = client->state.tick + elapsed;
+}
+
+/**
+ * Receive the snapshots, send the keys and give the snapshot to draw. Never waits.
+ * @param		NetClient*							client	the client
+ * @param		unsigned int						keys		SHARED_MINUS, SHARED_PLUS or both
+ * @return	RenderSnapshot const*						the snapshot to draw
+ */
+RenderSnapshot const *updateClient(NetClient *client, unsigned int keys) {
+	unsigned char data[NET_PACKET_SIZE];
+	Uint32 host, now;
+	Uint16 port;
+	long received = client->snapshotsReceived, elapsed;
+	int length;
+
+	while ((length = receivePacket(&client->socket, &host, &port, data)) != -1) {
+		if (host == client->host && port == client->port) {
+			receiveSnapshot(client, data, length);
+		}
+	}
+	if (client->snapshotsReceived != received) {
+		expandNetState(client);
+	}
+
+	now = SDL_GetTicks();
+	if (keys != client->sentKeys || now - client->lastSend >= NET_KEEPALIVE) {
+		sendInput(client, keys);
+	}
+	flushPackets(&client->socket);
+
+	if (client->hasState) {
+		elapsed = client->state.over ? 0 : (now - client->stateTime) / SIM_TICK_DURATION;
+		extrapolateBalls(client, elapsed < NET_SNAPSHOT_TICKS ? elapsed : NET_SNAPSHOT_TICKS);
+	}
+	return &client->snapshot;
+}
@@ -20,10 +20,14 @@
 
 /**
  * determines if there is a collision between a ball and the screen borders.
- * @param	Ball*	ball			the current ball pointer
- * @param in		nbPlayers	total of players in game
+ * The lives are not taken here, see loseLives.
+ * @param		Ball*	ball			the current ball pointer
+ * @param		int		nbPlayers	total of players in game
+ * @return	int							one bit per player who missed the ball, 0 if none
  */
-void collisionBallScreen(Ball *ball, int nbPlayers) {
+int collisionBallScreen(Ball *ball, int nbPlayers) {
+	int fallen = 0;
+
 	if (nbPlayers < 3) {
 		if ((ball->origin.x - ball->radius) <= HUD_HEIGHT
 			|| (ball->origin.x + ball->radius) >= (SCREEN_WIDTH - HUD_HEIGHT)) {
@@ -31,19 +35,20 @@ void collisionBallScreen(Ball *ball, int nbPlayers) {
 		}
 	} else {
 		if ((ball->origin.x - ball->radius) <= HUD_HEIGHT) {
-			ballOutOfBounds(ball, LEFT);
+			fallen |= ballOutOfBounds(ball, LEFT);
 		}
 		if ((ball->origin.x + ball->radius) >= (SCREEN_WIDTH - HUD_HEIGHT)) {
-			ballOutOfBounds(ball, RIGHT);
+			fallen |= ballOutOfBounds(ball, RIGHT);
 		}
 	}
 
 	if ((ball->origin.y - ball->radius) <= HUD_HEIGHT) {
-		ballOutOfBounds(ball, TOP);
+		fallen |= ballOutOfBounds(ball, TOP);
 	}
 	if ((ball->origin.y + ball->radius) >= (SCREEN_HEIGHT - HUD_HEIGHT)) {
-		ballOutOfBounds(ball, BOTTOM);
+		fallen |= ballOutOfBounds(ball, BOTTOM);
 	}
+	return fallen;
 }
 
 /**
@@ -152,6 +157,56 @@ enum direction collisionBallBrick(Ball const *ball, Brick const *brick) {
 	return NONE;
 }
 
+/**
+ * Find the brick of the grid a ball collides with, without changing anything.
+ * The bricks are found through the brick tree when it was built for this grid.
+ * @param		GridBrick				grid				the 2 dimensional brick grid
+ * @param		Ball const*			ball				the current ball pointer
+ * @param		int							gridWidth		the config file gridWidth
+ * @param		int							gridHeight	the config file gridHeight
+ * @param		enum direction*	collision		the collided side of the returned brick
+ * @return	Brick*											the first brick hit in the grid, NULL if none
+ */
+Brick *findBrickHit(GridBrick grid, Ball const *ball, int gridWidth, int gridHeight, enum direction *collision) {
+	int i, j;
+
+	if (brickTree()->grid == grid) {
+		return queryBrickTree(ball, collision);
+	}
+	*collision = NONE;
+	for (i = 0; i < gridHeight; ++i) {
+		for (j = 0; j < gridWidth; ++j) {
+			if (grid[i][j].status != DESTROYED) {
+				if ((*collision = collisionBallBrick(ball, &grid[i][j])) != NONE) {
+					return &grid[i][j];
+				}
+			}
+		}
+	}
+	return NULL;
+}
+
+/**
+ * Hit a brick and change the ball speed depending on wich side it collided the brick.
+ * @param	Brick*					brick			the brick hit
+ * @param	Ball*						ball			the current ball pointer
+ * @param	enum direction	collision	the collided side of the brick
+ */
+void bounceOffBrick(Brick *brick, Ball *ball, enum direction collision) {
+	hitBrick(brick, ball);
+	if (collision == TOP || collision == BOTTOM) {
+		ball->speed.y *= -1;
+	}
+	if (collision == LEFT || collision == RIGHT) {
+		ball->speed.x *= -1;
+	}
+	if (collision == TOP_LEFT || collision == TOP_RIGHT ||
+		collision == BOTTOM_LEFT || collision == BOTTOM_RIGHT) {
+		ball->speed.y *= -1;
+		ball->speed.x *= -1;
+	}
+}
+
 /**
  * Determines if there is a collision between a ball and one brick of the grid.
  * Change the ball speed depending on wich side it collided the brick.
@@ -162,32 +217,14 @@ enum direction collisionBallBrick(Ball const *ball, Brick const *brick) {
  * @return	bool									return true if there is a collision, false otherwise
  */
 bool collisionBallGrid(GridBrick grid, Ball *ball, int gridWidth, int gridHeight) {
-	int i, j;
 	enum direction collision;
+	Brick *brick = findBrickHit(grid, ball, gridWidth, gridHeight, &collision);
 
-	for (i = 0; i < gridHeight; ++i) {
-		for (j = 0; j < gridWidth; ++j) {
-			if (grid[i][j].status != DESTROYED) {
-				collision = collisionBallBrick(ball, &grid[i][j]);
-				if (collision != NONE) {
-					hitBrick(&grid[i][j], ball);
-					if (collision == TOP || collision == BOTTOM) {
-						ball->speed.y *= -1;
-					}
-					if (collision == LEFT || collision == RIGHT) {
-						ball->speed.x *= -1;
-					}
-					if (collision == TOP_LEFT || collision == TOP_RIGHT ||
-						collision == BOTTOM_LEFT || collision == BOTTOM_RIGHT) {
-						ball->speed.y *= -1;
-						ball->speed.x *= -1;
-					}
-					return true;
-				}
-			}
-		}
+	if (brick == NULL) {
+		return false;
 	}
-	return false;
+	bounceOffBrick(brick, ball, collision);
+	return true;
 }
 
 /**
@@ -262,6 +299,133 @@ void collisionBarBall(Bar const *bar, Ball *ball) {
 	}
 }
 
+/*/////////////////////////////////////////
+ //			BALL-BALL COLLISION FUNCTIONS		//
+/////////////////////////////////////////*/
+
+/**
+ * Determines if two balls overlap and, if they are moving towards each other, make them
+ * bounce (elastic collision, the mass of a ball is its radius squared). The balls are
+ * also pushed apart so that they don't stay stuck together.
+ * @param		Ball*	a	the first ball pointer
+ * @param		Ball*	b	the second ball pointer
+ * @return	bool			return true if there is a collision, false otherwise
+ */
+bool collisionBallBall(Ball *a, Ball *b) {
+	Vector2D normal = defineVector(a->origin, b->origin);
+	float gap = a->radius + b->radius;
+	float dist2 = dotPRoduct(normal, normal);
+	float dist, massA, massB, approach, impulse, push;
+
+	if (dist2 >= gap * gap) {
+		return false;
+	}
+	dist = sqrt(dist2);
+	if (dist > 0) {
+		normal = divVector(normal, dist);
+	} else {
+		initVector2D(&normal, 1, 0);
+	}
+	massA = a->radius * a->radius;
+	massB = b->radius * b->radius;
+
+	push = (gap - dist) / (massA + massB);
+	a->origin = pointPlusVector(a->origin, multVector(normal, -push * massB));
+	b->origin = pointPlusVector(b->origin, multVector(normal, push * massA));
+
+	approach = dotPRoduct(subVectors(b->speed, a->speed), normal);
+	if (approach >= 0) {
+		/* already moving apart */
+		return true;
+	}
+	impulse = (2 * approach) / (massA + massB);
+	a->speed = addVectors(a->speed, multVector(normal, impulse * massB));
+	b->speed = subVectors(b->speed, multVector(normal, impulse * massA));
+	return true;
+}
+
+/**
+ * Refresh the sweep entries from the balls, then sort them on the left side of the balls.
+ * Insertion sort : the balls barely move between two ticks, so the order of the previous
+ * tick is almost sorted already and the sort is close to linear.
+ * Equal sides are sorted by ball id : the order only depends on the balls, never on the
+ * order of the previous ticks.
+ * @param	SweepEntry*	entries	one entry per ball, sorted in the previous tick
+ * @param	Ball const*	balls		all balls in game
+ * @param	int					nbBalls	the number of balls in game
+ */
+void sortBallsX(SweepEntry *entries, Ball const *balls, int nbBalls) {
+	SweepEntry entry;
+	Ball const *ball;
+	int i, j;
+
+	for (i = 0; i < nbBalls; ++i) {
+		ball = &balls[entries[i].index];
+		entries[i].left = ball->origin.x - ball->radius;
+		entries[i].right = ball->origin.x + ball->radius;
+		entries[i].y = ball->origin.y;
+	}
+	for (i = 1; i < nbBalls; ++i) {
+		entry = entries[i];
+		for (j = i - 1; j >= 0 && (entries[j].left > entry.left
+			|| (entries[j].left == entry.left && entries[j].index > entry.index)); --j) {
+			entries[j + 1] = entries[j];
+		}
+		entries[j + 1] = entry;
+	}
+}
+
+/**
+ * Collide every pair of balls. Sweep and prune on the x axis : once sorted on their left
+ * side, a ball is only tested against the next balls starting before its right side.
+ * The sorted entries are kept from one tick to the next, and scanned contiguously.
+ * Respawning balls are ignored.
+ * @param		Ball*	balls		all balls in game
+ * @param		int		nbBalls	the number of balls in game
+ * @return	int						the number of pairs tested (narrow phase)
+ */
+int collideBallPairs(Ball *balls, int nbBalls) {
+	static SweepEntry *entries = NULL;
+	static int capacity = 0, nbSorted = 0;
+	SweepEntry *grown;
+	Ball *a, *b;
+	int i, j, tests = 0;
+
+	if (nbBalls > capacity) {
+		if ((grown = realloc(entries, nbBalls * sizeof(SweepEntry))) == NULL) {
+			exit(MALLOC_ERROR);
+		}
+		entries = grown;
+		capacity = nbBalls;
+	}
+	if (nbBalls != nbSorted) {
+		for (i = 0; i < nbBalls; ++i) {
+			entries[i].index = i;
+		}
+		nbSorted = nbBalls;
+	}
+
+	sortBallsX(entries, balls, nbBalls);
+	for (i = 0; i < nbBalls; ++i) {
+		a = &balls[entries[i].index];
+		if (a->respawnTimer) {
+			continue;
+		}
+		for (j = i + 1; j < nbBalls && entries[j].left <= entries[i].right; ++j) {
+			/* y first : most pairs overlapping on x are far apart on y */
+			if (fabs(entries[j].y - entries[i].y) >= (entries[i].right - entries[i].left + entries[j].right - entries[j].left) / 2) {
+				continue;
+			}
+			b = &balls[entries[j].index];
+			if (!b->respawnTimer) {
+				collisionBallBall(a, b);
+				++tests;
+			}
+		}
+	}
+	return tests;
+}
+
 /*/////////////////////////////////////////
  //				BASIC MOUVEMENTS FUNCTIONS 		//
 /////////////////////////////////////////*/
@@ -6,20 +6,56 @@
  * @date		2017-04-23
  */
 
+#define _POSIX_C_SOURCE 199309L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <math.h>
 #include <string.h>
+#include <time.h>
 
 #include "headers.h"
 
 /**
- * Read the config file containing the grid configuration.
+ * Read the monotonic clock, the one every timing of the game and its tools uses.
+ * @return	unsigned long	the current time in nanoseconds
+ */
+unsigned long clockNow() {
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long)now.tv_sec * 1000000000UL + now.tv_nsec;
+}
+
+/**
+ * Read the optional motion line of a config or theme file : the motion of each brick
+ * (enum brickMotion), an unknown motion is STILL. The motions missing are left as they are.
+ * @param	FILE*	file				the file, just after the brick types line
+ * @param	int*	brickMotions	the motions of the bricks, in the grid order
+ * @param	int		nbBricks			the number of bricks
+ */
+static void readBrickMotions(FILE *file, int *brickMotions, int nbBricks) {
+	char tmp[500];
+	char *token;
+	int i;
+
+	if (fgets(tmp, sizeof(tmp), file) == NULL) {
+		return;
+	}
+	token = strtok(tmp, " ");
+	for (i = 0; i < nbBricks && token != NULL; ++i) {
+		brickMotions[i] = (token[0] >= '0' && token[0] <= '0' + ORBIT) ? token[0] - '0' : STILL;
+		token = strtok(NULL, " ");
+	}
+}
+
+/**
+ * Read the config file containing the grid configuration. An optional third line gives
+ * the motion of each brick (enum brickMotion), every brick is STILL without it.
  * @param	char*	filePath		the relative file path
  * @param	int*	gridWidth		the pointer of the gridWidth
  * @param	int*	gridHeight	the pointer of the gridHeight
- * @return									return the array containing all brick types in order
+ * @return									return the array containing all brick types in order, then all brick motions
  */
 int *readConfigFile(char *filePath, int *gridWidth, int *gridHeight) {
 	FILE *file;
@@ -33,15 +69,15 @@ int *readConfigFile(char *filePath, int *gridWidth, int *gridHeight) {
 	}
 
 	fscanf(file, " %d %d\n", gridWidth, gridHeight);
-	*gridWidth = *gridWidth > 15 ? 15 : *gridWidth;
-	*gridHeight = *gridHeight > 9 ? 9 : *gridHeight;
+	*gridWidth = *gridWidth > GRID_MAX_WIDTH ? GRID_MAX_WIDTH : *gridWidth;
+	*gridHeight = *gridHeight > GRID_MAX_HEIGHT ? GRID_MAX_HEIGHT : *gridHeight;
 	*gridWidth = *gridWidth < 0 ? 0 : *gridWidth;
 	*gridHeight = *gridHeight < 0 ? 0 : *gridHeight;
 
 
 	fgets(tmp, sizeof(tmp), file);
 
-	brickTypes = malloc(*gridWidth * *gridHeight * sizeof(int));
+	brickTypes = calloc(2 * *gridWidth * *gridHeight, sizeof(int));
 	if (brickTypes == NULL) {
 		exit(MALLOC_ERROR);
 	}
@@ -53,6 +89,9 @@ int *readConfigFile(char *filePath, int *gridWidth, int *gridHeight) {
 		token = strtok(NULL, " ");
 	}
 
+	readBrickMotions(file, &brickTypes[*gridWidth * *gridHeight], *gridWidth * *gridHeight);
+	fclose(file);
+
 	return brickTypes;
 }
 
@@ -123,10 +162,15 @@ void initBrick(Brick *b, int type, enum brickStatus status, int indexX, int inde
 
 	b->gridX = indexX;
 	b->gridY = indexY;
+
+	b->motion = STILL;
+	b->phase = 0;
+	b->leaf = BVH_NO_NODE;
 }
 
 /**
  * Update a brick structure to set the coordinates of each corners. (to avoid numerous operations)
+ * Every brick movement goes through here : the brick tree is refitted around the brick.
  * @param	Brick*	br			the pointer of the brick to be updated
  * @param	Point2D	topLeft	the top left corner of the brick
  */
@@ -142,10 +186,13 @@ void updateBrickCoordinates(Brick *br, Point2D topLeft) {
 
 	br->bottomRight.x = topLeft.x + BRICK_WIDTH;
 	br->bottomRight.y = topLeft.y + BRICK_HEIGHT;
+
+	refitBrick(br);
 }
 
 /**
- * Initiate the true coordinates of all bricks (depending on theire number (column and lines))
+ * Initiate the true coordinates of all bricks (depending on theire number (column and lines)),
+ * their motion starts from there. Then build the brick tree of the grid.
  * @param	GridBrick	grid				the grid in wich all bricks goes
  * @param	int				gridWidth		the number of columns
  * @param	int				gridHeight	the number of lines
@@ -167,15 +214,19 @@ void initBrickCoordinates(GridBrick grid, int gridWidth, int gridHeight) {
 			topLeft.x = originX + (j * BRICK_WIDTH);
 			topLeft.y = originY + (i * BRICK_HEIGHT);
 			updateBrickCoordinates(&grid[i][j], topLeft);
+			grid[i][j].home = topLeft;
+			grid[i][j].phase = 0;
 		}
 	}
+	initBrickMotions();
+	buildBrickTree(grid, gridWidth, gridHeight);
 }
 
 /**
  * Initialise a 2 dimensional grid of bricks with the config file params.
  * @param	int	gridWidth		the config file gridWidth
  * @param	int	gridHeight	the config file gridHeight
- * @param	int	blockType		the blockTypes array containing all bricks types
+ * @param	int	blockType		the blockTypes array containing all bricks types, then all bricks motions
  * @return								return a 2 dimensional grid of bricks
  */
 GridBrick initGrid(int gridWidth, int gridHeight, int *blockType) {
@@ -192,6 +243,7 @@ GridBrick initGrid(int gridWidth, int gridHeight, int *blockType) {
 		}
 		for (j = 0; j < gridWidth; ++j) {
 			initBrick(&grid[i][j], blockType[i*gridWidth + j], PRISTINE, i, j);
+			grid[i][j].motion = blockType[(gridWidth * gridHeight) + (i * gridWidth) + j];
 		}
 	}
 	return grid;
@@ -200,11 +252,12 @@ GridBrick initGrid(int gridWidth, int gridHeight, int *blockType) {
 
 
 /**
- * Read the config file containing the grid configuration.
+ * Read the theme file containing the grid configuration, with the same optional motion line
+ * as the config files.
  * @param		char*	filePath		the relative file path
  * @param		int*	gridWidth		the pointer of the gridWidth
  * @param		int*	gridHeight	the pointer of the gridHeight
- * @return	int*							return the array containing all brick types in order
+ * @return	int*							return the array containing all brick types in order, then all brick motions
  */
 int *readThemeFile(char *filePath, int *gridWidth, int *gridHeight) {
 	FILE *file;
@@ -220,7 +273,7 @@ int *readThemeFile(char *filePath, int *gridWidth, int *gridHeight) {
 	fscanf(file, " %d %d\n", gridWidth, gridHeight);
 	fgets(tmp, sizeof(tmp), file);
 
-	brickTypes = malloc(*gridWidth * *gridHeight * sizeof(int));
+	brickTypes = calloc(2 * *gridWidth * *gridHeight, sizeof(int));
 	if (brickTypes == NULL) {
 		exit(MALLOC_ERROR);
 	}
@@ -232,5 +285,67 @@ int *readThemeFile(char *filePath, int *gridWidth, int *gridHeight) {
 		token = strtok(NULL, " ");
 	}
 
+	readBrickMotions(file, &brickTypes[*gridWidth * *gridHeight], *gridWidth * *gridHeight);
+	fclose(file);
+
 	return brickTypes;
 }
+
+/**
+ * Set what every match played without the menu shares : the seed of the game, the theme
+ * color and the name of every seat.
+ * @param	char*	name	the name given to every seat
+ */
+void initMatchDefaults(char *name) {
+	int i;
+
+	srand(42);
+	initColor3f(&themeColor, 255, 139, 0);
+	for (i = 0; i < 4; ++i) {
+		playersNames[i] = name;
+	}
+}
+
+/**
+ * Open a match without the menu : read its level, build its grid and its game objects
+ * then give them to the simulation, so simulationTick plays the same step as the game.
+ * At 4 players the grid keeps its first 7 columns, like the menu does.
+ * @param	Match*				match				the match to open
+ * @param	char const*		level				the config file of the level
+ * @param	int						nbPlayers		total number of players in game, one ball each
+ * @param	unsigned int	gladOSSeats	bit i set if GladOS plays seat i
+ */
+void openMatch(Match *match, char const *level, int nbPlayers, unsigned int gladOSSeats) {
+	match->brickTypes = readConfigFile((char *)level, &match->gridWidth, &match->gridHeight);
+	match->grid = initGrid(match->gridWidth, match->gridHeight, match->brickTypes);
+	if (nbPlayers == FOUR_PL && match->gridWidth > 7) {
+		match->gridWidth = 7;
+	}
+	match->nbPlayers = nbPlayers;
+	match->nbBalls = nbPlayers;
+	match->gladOSSeats = gladOSSeats;
+
+	initBrickCoordinates(match->grid, match->gridWidth, match->gridHeight);
+	initGame(nbPlayers);
+	resetParticles();
+	setSimulationMatch(match->grid, match->gridWidth, match->gridHeight, match->nbPlayers,
+		match->nbBalls, gladOSSeats);
+}
+
+/**
+ * Free the grid and the game objects of a match opened by openMatch.
+ * @param	Match*	match	the match to close
+ */
+void closeMatch(Match *match) {
+	int i;
+
+	for (i = 0; i < match->gridHeight; ++i) {
+		free(match->grid[i]);
+	}
+	free(match->grid);
+	free(match->brickTypes);
+	free(players);
+	free(balls);
+	players = NULL;
+	balls = NULL;
+}
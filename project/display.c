@@ -16,12 +16,19 @@
 #include <SDL/SDL.h>
 #include <GL/gl.h>
 #include <GL/glu.h>
-#include <GL/glut.h>
 #include <GL/glx.h>
 #include <SDL/SDL_image.h>
 
 #include "headers.h"
 
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+GLuint texturesBuffer[TEXTURE_NB];
+Point2D ballMesh[BALL_SIDES];
+int hudRebuilds = 0;
+
 /*/////////////////////////////////////////
  //				BASIC DRAWING FUNCTIONS				//
 /////////////////////////////////////////*/
@@ -33,20 +40,33 @@
 void drawBar(Bar bar) {
 	int sizeX = bar.width / 2;
 	int sizeY = BAR_HEIGHT / 2;
-
-	glColor3f(bar.color.r, bar.color.g, bar.color.b);
+	Point2D corners[4];
 
 	if (!bar.orientationHorizontal) {
 		sizeX = BAR_HEIGHT / 2;
 		sizeY = bar.width / 2;
 	}
 
-	glBegin(GL_POLYGON);
-		glVertex2f((bar.center.x - sizeX), (bar.center.y - sizeY));
-		glVertex2f((bar.center.x + sizeX), (bar.center.y - sizeY));
-		glVertex2f((bar.center.x + sizeX), (bar.center.y + sizeY));
-		glVertex2f((bar.center.x - sizeX), (bar.center.y + sizeY));
-	glEnd();
+	initPoint2D(&corners[0], (bar.center.x - sizeX), (bar.center.y - sizeY));
+	initPoint2D(&corners[1], (bar.center.x + sizeX), (bar.center.y - sizeY));
+	initPoint2D(&corners[2], (bar.center.x + sizeX), (bar.center.y + sizeY));
+	initPoint2D(&corners[3], (bar.center.x - sizeX), (bar.center.y + sizeY));
+	renderer->drawQuad(corners, NULL, bar.color);
+}
+
+/**
+ * Precompute the unit circle used to draw every ball. Called once at startup,
+ * so no trigonometry is left in the per-frame path.
+ */
+void initBallMesh() {
+	int i;
+	float angle;
+
+	for (i = 0; i < BALL_SIDES; ++i) {
+		angle = i * 2 * PI / BALL_SIDES;
+		ballMesh[i].x = cos(angle);
+		ballMesh[i].y = sin(angle);
+	}
 }
 
 /**
@@ -54,20 +74,61 @@ void drawBar(Bar bar) {
  * @param	Ball	ball	the ball to draw
  */
 void drawBall(Ball ball) {
-		int i, sides = 32;
-		float angle;
-
-	glColor3f(ball.color.r, ball.color.g, ball.color.b);
-
-	glBegin(GL_POLYGON);
-		for(i = 0; i < sides; ++i){
-			angle =  i * 2*PI / sides;
-			glVertex2f(
-				(cos(angle) * ball.radius) + ball.origin.x,
-				(sin(angle) * ball.radius) + ball.origin.y
-			);
+	drawBalls(&ball, 1);
+}
+
+/**
+ * Draw all visible balls (respawning ones are skipped) in a single draw call.
+ * Each ball is expanded from the precomputed unit circle into a triangle fan
+ * written to one shared vertex/color array, grown only when more balls show up.
+ * @param	Ball const*	balls		all balls in game
+ * @param	int					nbBalls	the number of balls in game
+ */
+void drawBalls(Ball const *balls, int nbBalls) {
+	static GLfloat *vertices = NULL;
+	static GLfloat *colors = NULL;
+	static int capacity = 0;
+	int i, j, k, nbVertices = 0;
+	GLfloat *v, *c;
+
+	if (nbBalls > capacity) {
+		v = realloc(vertices, nbBalls * BALL_SIDES * 3 * 2 * sizeof(GLfloat));
+		c = realloc(colors, nbBalls * BALL_SIDES * 3 * 3 * sizeof(GLfloat));
+		if (v == NULL || c == NULL) {
+			exit(MALLOC_ERROR);
+		}
+		vertices = v;
+		colors = c;
+		capacity = nbBalls;
+	}
+
+	v = vertices;
+	c = colors;
+	for (i = 0; i < nbBalls; ++i) {
+		if (balls[i].respawnTimer) {
+			continue;
+		}
+		for (j = 0; j < BALL_SIDES; ++j) {
+			k = (j + 1) % BALL_SIDES;
+			*v++ = balls[i].origin.x;
+			*v++ = balls[i].origin.y;
+			*v++ = (ballMesh[j].x * balls[i].radius) + balls[i].origin.x;
+			*v++ = (ballMesh[j].y * balls[i].radius) + balls[i].origin.y;
+			*v++ = (ballMesh[k].x * balls[i].radius) + balls[i].origin.x;
+			*v++ = (ballMesh[k].y * balls[i].radius) + balls[i].origin.y;
+			for (k = 0; k < 3; ++k) {
+				*c++ = balls[i].color.r;
+				*c++ = balls[i].color.g;
+				*c++ = balls[i].color.b;
+			}
 		}
-	glEnd();
+		nbVertices += BALL_SIDES * 3;
+	}
+	if (!nbVertices) {
+		return;
+	}
+
+	renderer->drawTriangles(vertices, colors, nbVertices);
 }
 
 /**
@@ -75,77 +136,100 @@ void drawBall(Ball ball) {
  * @param	Brick	br					the current brick to draw
  */
 void drawBrick(Brick br) {
-	int index = defineBrickColor(br);
-		glEnable(GL_TEXTURE_2D);
-		glColor3f(255, 255, 255);
-		glBindTexture(GL_TEXTURE_2D, texturesBuffer[index]);
-
-		glBegin(GL_POLYGON);
-			glTexCoord2f(0.0f, 0.0f);
-			glVertex2f(0, 0);
-			glTexCoord2f(0.0f, 1.0f);
-			glVertex2f((BRICK_WIDTH - 1), 0);
-			glTexCoord2f(1.0f, 1.0f);
-			glVertex2f((BRICK_WIDTH - 1), (BRICK_HEIGHT - 1));
-			glTexCoord2f(1.0f, 0.0f);
-			glVertex2f(0, (BRICK_HEIGHT - 1));
-		glEnd();
-
-		glBindTexture(GL_TEXTURE_2D, texturesBuffer[index]);
-		glDisable(GL_TEXTURE_2D);
+	static Point2D const corners[4] = {{0, 0}, {BRICK_WIDTH - 1, 0}, {BRICK_WIDTH - 1, BRICK_HEIGHT - 1}, {0, BRICK_HEIGHT - 1}};
+	static Point2D const texCoords[4] = {{0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}};
+	Color3f white;
+
+	initColor3f(&white, 255, 255, 255);
+	renderer->bindTexture(defineBrickColor(br));
+	renderer->drawQuad(corners, texCoords, white);
+	renderer->bindTexture(RENDER_NO_TEXTURE);
 }
 
 /**
- * Draw a 2 dimensional grid of bricks, centered, based on their type and index.
+ * Draw a 2 dimensional grid of bricks at their current position, based on their type.
  * @param	GridBrick	grid				the current gridBrick to draw
  * @param	int				gridWidth		the gridWidth from the config file
  * @param	int				gridHeight	the gridHeight from the config file
  */
 void drawGrid(GridBrick const grid,int gridWidth, int gridHeight) {
 	int i, j;
-	int originX = SCREEN_WIDTH_CENTER - ((gridWidth / 2) * BRICK_WIDTH);
-	if (gridWidth % 2 == 1) {
-		originX -= (BRICK_WIDTH / 2);
-	}
-	int originY = (SCREEN_HEIGHT_CENTER - ((gridHeight) / 2) * BRICK_HEIGHT);
-	if (gridHeight % 2 == 1) {
-		originY -= (BRICK_HEIGHT / 2);
-	}
 
 	for (i = 0; i < gridHeight; ++i) {
 		for (j = 0; j < gridWidth; ++j) {
 			if (grid[i][j].status != DESTROYED) {
-				glPushMatrix();
-					glTranslatef((originX + (j * (BRICK_WIDTH - 1))), (originY + (i * (BRICK_HEIGHT - 1))), 0);
+				/* one pixel less per line and column : the borders of neighbour bricks overlap */
+				renderer->pushTransform(grid[i][j].topLeft.x - j, grid[i][j].topLeft.y - i, 0);
 					drawBrick(grid[i][j]);
-				glPopMatrix();
+				renderer->popTransform();
 			}
 		}
 	}
 }
 
+/**
+ * Draw a whole PLAYTIME frame : the playfield, then the HUDs on top.
+ * @param	GridBrick				grid				the current gridBrick to draw
+ * @param	int							gridWidth		the gridWidth from the config file
+ * @param	int							gridHeight	the gridHeight from the config file
+ * @param	Player const*		players			the players to draw
+ * @param	int							nbPlayers		total number of players in game
+ * @param	Ball const*			balls				the balls to draw
+ * @param	int							nbBalls			the number of balls in game
+ */
+void drawGame(GridBrick const grid, int gridWidth, int gridHeight, Player const *players, int nbPlayers,
+	Ball const *balls, int nbBalls) {
+	drawPlayfield(grid, gridWidth, gridHeight, players, nbPlayers, balls, nbBalls);
+	drawHUDs(players, nbPlayers);
+}
+
+/**
+ * Draw the playfield : background, balls, bars, bricks and debris particles.
+ * @param	GridBrick				grid				the current gridBrick to draw
+ * @param	int							gridWidth		the gridWidth from the config file
+ * @param	int							gridHeight	the gridHeight from the config file
+ * @param	Player const*		players			the players to draw
+ * @param	int							nbPlayers		total number of players in game
+ * @param	Ball const*			balls				the balls to draw
+ * @param	int							nbBalls			the number of balls in game
+ */
+void drawPlayfield(GridBrick const grid, int gridWidth, int gridHeight, Player const *players, int nbPlayers,
+	Ball const *balls, int nbBalls) {
+	int i;
+
+	drawBackground(4);
+	drawBalls(balls, nbBalls);
+	for (i = 0; i < nbPlayers; ++i) {
+		drawBar(players[i].bar);
+	}
+	drawGrid(grid, gridWidth, gridHeight);
+	drawParticles();
+}
+
+/**
+ * Draw the HUD of every player (cached, opaque).
+ * @param	Player const*		players			the players to draw
+ * @param	int							nbPlayers		total number of players in game
+ */
+void drawHUDs(Player const *players, int nbPlayers) {
+	int i;
+	for (i = 0; i < nbPlayers; ++i) {
+		drawCachedHUD(&players[i], nbPlayers);
+	}
+}
+
 /**
  * Draw the background texture. (x = 0, y = 0) (top left corner)
  * @param	int	index	the correct texture index needed to draw the brick
  */
 void drawBackground(int index) {
-		glEnable(GL_TEXTURE_2D);
-		glColor3f(255, 255, 255);
-		glBindTexture(GL_TEXTURE_2D, texturesBuffer[index]);
-
-		glBegin(GL_POLYGON);
-			glTexCoord2f(0.0f, 0.0f);
-			glVertex2f(0, 0);
-			glTexCoord2f(1.0f, 0.0f);
-			glVertex2f(SCREEN_WIDTH , 0);
-			glTexCoord2f(1.0f, 1.0f);
-			glVertex2f(SCREEN_WIDTH, SCREEN_HEIGHT);
-			glTexCoord2f(0.0f, 1.0f);
-			glVertex2f(0, SCREEN_HEIGHT);
-		glEnd();
-
-		glBindTexture(GL_TEXTURE_2D, texturesBuffer[index]);
-		glDisable(GL_TEXTURE_2D);
+	Point2D topLeft, topRight, bottomRight, bottomLeft;
+
+	initPoint2D(&topLeft, 0, 0);
+	initPoint2D(&topRight, SCREEN_WIDTH, 0);
+	initPoint2D(&bottomRight, SCREEN_WIDTH, SCREEN_HEIGHT);
+	initPoint2D(&bottomLeft, 0, SCREEN_HEIGHT);
+	drawRectangle(index, topLeft, topRight, bottomRight, bottomLeft);
 }
 
 /*/////////////////////////////////////////
@@ -160,23 +244,17 @@ void drawBackground(int index) {
  * @param	Point2D	bottomLeft	bottom left corner
  */
 void drawRectangle(int index, Point2D topLeft, Point2D topRight, Point2D bottomRight, Point2D bottomLeft) {
-	glEnable(GL_TEXTURE_2D);
-	glColor3f(255, 255, 255);
-	glBindTexture(GL_TEXTURE_2D, texturesBuffer[index]);
-
-	glBegin(GL_POLYGON);
-		glTexCoord2f(0.0f, 0.0f);
-		glVertex2f(topLeft.x, topLeft.y);
-		glTexCoord2f(1.0f, 0.0f);
-		glVertex2f(topRight.x, topRight.y);
-		glTexCoord2f(1.0f, 1.0f);
-		glVertex2f(bottomRight.x, bottomRight.y);
-		glTexCoord2f(0.0f, 1.0f);
-		glVertex2f(bottomLeft.x, bottomLeft.y);
-	glEnd();
-
-	glBindTexture(GL_TEXTURE_2D, texturesBuffer[index]);
-	glDisable(GL_TEXTURE_2D);
+	Point2D corners[4];
+	Color3f white;
+
+	corners[0] = topLeft;
+	corners[1] = topRight;
+	corners[2] = bottomRight;
+	corners[3] = bottomLeft;
+	initColor3f(&white, 255, 255, 255);
+	renderer->bindTexture(index);
+	renderer->drawQuad(corners, quadTexCoords, white);
+	renderer->bindTexture(RENDER_NO_TEXTURE);
 }
 
 
@@ -187,9 +265,9 @@ void drawRectangle(int index, Point2D topLeft, Point2D topRight, Point2D bottomR
  * @param	int						nbPlayers	total number of players in game
  */
 void drawHUD(Player const *pl, int nbPlayers) {
-	char score[9] = "0";
-	sprintf(score, "%d", pl->score);
 	Point2D topLeft, topRight, bottomRight, bottomLeft;
+	Color3f textColor = {5, 11, 11};
+	HUDCache *cache;
 
 	if (pl->id == 1) {
 		initPoint2D(&topLeft, 0, 0);
@@ -199,16 +277,14 @@ void drawHUD(Player const *pl, int nbPlayers) {
 
 		drawRectangle(5, topLeft, topRight, bottomRight, bottomLeft);
 
-		glPushMatrix();
-			glTranslatef((LIFE_SIZE_WIDTH * 2), ((HUD_HEIGHT / 2) - (LIFE_SIZE_HEIGHT / 2)), 0);
+		renderer->pushTransform((LIFE_SIZE_WIDTH * 2), ((HUD_HEIGHT / 2) - (LIFE_SIZE_HEIGHT / 2)), 0);
 			drawLifes(pl->life);
-		glPopMatrix();
+		renderer->popTransform();
 
-		glColor3f(5, 11, 11);
-		glPushMatrix();
-			renderBitmapString(SCREEN_WIDTH_CENTER, (HUD_HEIGHT / 2)+5, pl->name);
-			renderBitmapString((SCREEN_WIDTH - 120), (HUD_HEIGHT / 2)+7, score);
-		glPopMatrix();
+		cache = updateHUDCache(pl, SCREEN_WIDTH_CENTER, (HUD_HEIGHT / 2)+5,
+			(SCREEN_WIDTH - 120), (HUD_HEIGHT / 2)+7, false);
+		drawTextMesh(&cache->nameMesh, textColor);
+		drawTextMesh(&cache->scoreMesh, textColor);
 
 	} else if (pl->id == 2) {
 		initPoint2D(&topLeft, 0, SCREEN_HEIGHT - HUD_HEIGHT);
@@ -218,19 +294,14 @@ void drawHUD(Player const *pl, int nbPlayers) {
 
 		drawRectangle(5, topLeft, topRight, bottomRight, bottomLeft);
 
-		glBindTexture(GL_TEXTURE_2D, texturesBuffer[5]);
-		glDisable(GL_TEXTURE_2D);
-
-		glPushMatrix();
-			glTranslatef((LIFE_SIZE_WIDTH * 2), (SCREEN_HEIGHT - (HUD_HEIGHT / 2) - (LIFE_SIZE_HEIGHT / 2)), 0);
+		renderer->pushTransform((LIFE_SIZE_WIDTH * 2), (SCREEN_HEIGHT - (HUD_HEIGHT / 2) - (LIFE_SIZE_HEIGHT / 2)), 0);
 			drawLifes(pl->life);
-		glPopMatrix();
+		renderer->popTransform();
 
-		glColor3f(5, 11, 11);
-		glPushMatrix();
-			renderBitmapString(SCREEN_WIDTH_CENTER, (SCREEN_HEIGHT - (HUD_HEIGHT / 2))+5, pl->name);
-			renderBitmapString((SCREEN_WIDTH - 120), (SCREEN_HEIGHT - (HUD_HEIGHT / 2))+7, score);
-		glPopMatrix();
+		cache = updateHUDCache(pl, SCREEN_WIDTH_CENTER, (SCREEN_HEIGHT - (HUD_HEIGHT / 2))+5,
+			(SCREEN_WIDTH - 120), (SCREEN_HEIGHT - (HUD_HEIGHT / 2))+7, false);
+		drawTextMesh(&cache->nameMesh, textColor);
+		drawTextMesh(&cache->scoreMesh, textColor);
 	}
 	if (nbPlayers > 2) {
 		if (pl->id == 3) {
@@ -241,17 +312,14 @@ void drawHUD(Player const *pl, int nbPlayers) {
 
 			drawRectangle(15, topLeft, topRight, bottomRight, bottomLeft);
 
-			glPushMatrix();
-				glTranslatef(((HUD_HEIGHT / 2) + (LIFE_SIZE_HEIGHT / 2)), -20, 0);
-				glRotatef(90, 0, 0, 1);
+			renderer->pushTransform(((HUD_HEIGHT / 2) + (LIFE_SIZE_HEIGHT / 2)), -20, 90);
 				drawLifes(pl->life);
-			glPopMatrix();
+			renderer->popTransform();
 
-			glColor3f(5, 11, 11);
-			glPushMatrix();
-				renderBitmapVerticalString(((HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT_CENTER + 30), pl->name);
-				renderBitmapVerticalString(((HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT - 90), score);
-			glPopMatrix();
+			cache = updateHUDCache(pl, ((HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT_CENTER + 30),
+				((HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT - 90), true);
+			drawTextMesh(&cache->nameMesh, textColor);
+			drawTextMesh(&cache->scoreMesh, textColor);
 
 		} else if (pl->id == 4) {
 			initPoint2D(&topLeft, SCREEN_WIDTH - HUD_HEIGHT, 0);
@@ -261,21 +329,93 @@ void drawHUD(Player const *pl, int nbPlayers) {
 
 			drawRectangle(15, topLeft, topRight, bottomRight, bottomLeft);
 
-			glPushMatrix();
-				glTranslatef((SCREEN_WIDTH - (HUD_HEIGHT / 2 ) + (LIFE_SIZE_HEIGHT / 2)), -20, 0);
-				glRotatef(90, 0, 0, 1);
+			renderer->pushTransform((SCREEN_WIDTH - (HUD_HEIGHT / 2 ) + (LIFE_SIZE_HEIGHT / 2)), -20, 90);
 				drawLifes(pl->life);
-			glPopMatrix();
+			renderer->popTransform();
 
-			glColor3f(5, 11, 11);
-			glPushMatrix();
-				renderBitmapVerticalString((SCREEN_WIDTH - (HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT_CENTER + 30), pl->name);
-				renderBitmapVerticalString((SCREEN_WIDTH - (HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT - 90), score);
-			glPopMatrix();
+			cache = updateHUDCache(pl, (SCREEN_WIDTH - (HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT_CENTER + 30),
+				(SCREEN_WIDTH - (HUD_HEIGHT / 2)-5), (SCREEN_HEIGHT - 90), true);
+			drawTextMesh(&cache->nameMesh, textColor);
+			drawTextMesh(&cache->scoreMesh, textColor);
 		}
 	}
 }
 
+/**
+ * Draw the HUD of a player from its offscreen texture. The HUD is only rendered
+ * again (and hudRebuilds incremented) when the score, the life or the name changed.
+ * Falls back on drawHUD when render targets are not supported or the backend can't draw offscreen.
+ * A render target that can't be created (incomplete framebuffer) is not tried again until
+ * freeHUDCaches.
+ * @param	Player const*	pl				The current player
+ * @param	int						nbPlayers	total number of players in game
+ */
+void drawCachedHUD(Player const *pl, int nbPlayers) {
+	HUDCache *cache = &hudCaches[pl->id - 1];
+	Point2D topLeft, bottomRight;
+
+	if (pl->id > 2 && nbPlayers <= 2) {
+		return;
+	}
+	if (pl->id == 1) {
+		initPoint2D(&topLeft, 0, 0);
+		initPoint2D(&bottomRight, SCREEN_WIDTH, HUD_HEIGHT);
+	} else if (pl->id == 2) {
+		initPoint2D(&topLeft, 0, SCREEN_HEIGHT - HUD_HEIGHT);
+		initPoint2D(&bottomRight, SCREEN_WIDTH, SCREEN_HEIGHT);
+	} else if (pl->id == 3) {
+		initPoint2D(&topLeft, 0, 0);
+		initPoint2D(&bottomRight, HUD_HEIGHT, SCREEN_HEIGHT);
+	} else {
+		initPoint2D(&topLeft, SCREEN_WIDTH - HUD_HEIGHT, 0);
+		initPoint2D(&bottomRight, SCREEN_WIDTH, SCREEN_HEIGHT);
+	}
+
+	if (!renderer->offscreen || cache->targetFailed) {
+		drawHUD(pl, nbPlayers);
+		return;
+	}
+	if (!cache->target.fbo && !initRenderTarget(&cache->target, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y)) {
+		cache->targetFailed = true;
+		drawHUD(pl, nbPlayers);
+		return;
+	}
+
+	if (!cache->targetReady || !cache->valid || cache->score != pl->score
+		|| cache->life != pl->life || cache->name != pl->name) {
+		beginRenderTarget(&cache->target, topLeft, bottomRight);
+			drawHUD(pl, nbPlayers);
+		endRenderTarget();
+		cache->targetReady = true;
+		++hudRebuilds;
+	}
+	drawRenderTarget(&cache->target, topLeft, bottomRight);
+}
+
+/**
+ * Invalidate every HUD cache and reset the rebuild counter. Called when a match starts.
+ */
+void resetHUDCaches() {
+	int i;
+	for (i = 0; i < 4; ++i) {
+		hudCaches[i].valid = false;
+		hudCaches[i].targetReady = false;
+	}
+	hudRebuilds = 0;
+}
+
+/**
+ * Free the offscreen textures of all HUDs.
+ */
+void freeHUDCaches() {
+	int i;
+	for (i = 0; i < 4; ++i) {
+		freeRenderTarget(&hudCaches[i].target);
+		hudCaches[i].targetReady = false;
+		hudCaches[i].targetFailed = false;
+	}
+}
+
 /**
  * Draw a single life
  */
@@ -298,43 +438,38 @@ void drawLife() {
 void drawLifes(int nbHearts) {
 	int i;
 	for (i = nbHearts; i > 0; --i) {
-		glPushMatrix();
-		glTranslatef(47 +(i * (LIFE_SIZE_WIDTH +4)), 0, 0);
+		renderer->pushTransform(47 +(i * (LIFE_SIZE_WIDTH +4)), 0, 0);
 			drawLife();
-		glPopMatrix();
+		renderer->popTransform();
 	}
 }
 
 /**
- * Render an HORIZONTAL Bitmap string using GLUT library
+ * Render an HORIZONTAL string from the glyph atlas
  * @param	float				x				top left corner (x value)
  * @param	float				y				top left corner (y value)
  * @param	char const*	string	the string to render horizontally
  */
 void renderBitmapString(float x, float y, char const *string) {
-	char const *c;
-	for (c = string; *c != '\0'; c++) {}
-	int strLenght = c - string;
-	glRasterPos2f(x - ((9 * strLenght) / 2), y);
-	for (c = string; *c != '\0'; c++) {
-		glutBitmapCharacter(GLUT_BITMAP_9_BY_15, *c);
-	}
+	static TextMesh mesh;
+	Color3f white;
+	initColor3f(&white, 255, 255, 255);
+	buildTextMesh(&mesh, x, y, string, false);
+	drawTextMesh(&mesh, white);
 }
 
 /**
- * Render a VERTICAL Bitmap string using GLUT library
+ * Render a VERTICAL string from the glyph atlas
  * @param	float				x				top left corner (x value)
  * @param	float				y				top left corner (y value)
  * @param	char const*	string	the string to render vertically
  */
 void renderBitmapVerticalString(float x, float y, char const *string) {
-	char const *c;
-	for (c = string; *c != '\0'; c++) {}
-	for (c = string; *c != '\0'; c++) {
-		glRasterPos2f(x, y + ((15 *  (c - string) )));
-		glutBitmapCharacter(GLUT_BITMAP_9_BY_15, *c);
-
-	}
+	static TextMesh mesh;
+	Color3f white;
+	initColor3f(&white, 255, 255, 255);
+	buildTextMesh(&mesh, x, y, string, true);
+	drawTextMesh(&mesh, white);
 }
 
 /**
@@ -349,8 +484,6 @@ void printVictoryScreen(Player const *players, int nbPlayers, bool gladOS) {
 	int index = 0;
 	int i;
 
-	glColor3f(255, 255, 255);
-	glPushMatrix();
 	if (nbPlayers < 3) {
 		if (players[0].life == 0) {
 			renderBitmapString((SCREEN_WIDTH_CENTER - (((NameLenght(players[1].name)/2) * 9))), 230, players[1].name);
@@ -377,7 +510,6 @@ void printVictoryScreen(Player const *players, int nbPlayers, bool gladOS) {
 			renderBitmapString((SCREEN_WIDTH_CENTER - (((NameLenght(players[i].name)/2) * 9))), (400 + ( 30 * (i + 1))), scorePl);
 		}
 	}
-	glPopMatrix();
 }
 
 /**
@@ -0,0 +1,466 @@
+/**
+ * @file		events.c
+ *       		events functions library. Event-driven fast-forward of a match played by GladOS on every
+ * 			    seat (headless balance runs, kasspong_balance). Between two events a ball flies in a
+ * 			    straight line, so the next possible event is found analytically : a border, the band of
+ * 			    a bar, a brick, another ball, a timer running out, GladOS following another ball or
+ * 			    stopped by a border. All the ticks before it are jumped at once, and land exactly where
+ * 			    as many ticks would :
+ * 			    - whole positions and speeds move in closed form, the events are exact.
+ * 			    - any other coordinate (a ball pushed or sped up by another one) is moved by the same
+ * 			      float additions as the ticks, and its events are looked for EVENT_DRIFT earlier.
+ * 			    The ticks that may hold an event are played normally.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static int blocker = 0;
+
+/*/////////////////////////////////////////
+ //					EVENT FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Find when a coordinate moving at a constant speed goes down to a bound.
+ * @param		double	from		the coordinate now
+ * @param		double	speed		the move per tick
+ * @param		double	bound		the bound to reach
+ * @return	long						the first number of ticks n with from + speed * n <= bound, EVENT_NEVER if none
+ */
+long ticksToReachBelow(double from, double speed, double bound) {
+	double ticks;
+
+	if (from <= bound) {
+		return 0;
+	}
+	if (speed >= 0) {
+		return EVENT_NEVER;
+	}
+	ticks = ceil((from - bound) / -speed);
+	return ticks < EVENT_NEVER ? (long)ticks : EVENT_NEVER;
+}
+
+/**
+ * Find when a coordinate moving at a constant speed goes up to a bound.
+ * @param		double	from		the coordinate now
+ * @param		double	speed		the move per tick
+ * @param		double	bound		the bound to reach
+ * @return	long						the first number of ticks n with from + speed * n >= bound, EVENT_NEVER if none
+ */
+long ticksToReachAbove(double from, double speed, double bound) {
+	return ticksToReachBelow(-from, -speed, -bound);
+}
+
+/**
+ * Check that no ball speed waits to be normalised by moveBalls.
+ * @param		int		nbBalls	the number of balls in game
+ * @return	bool					true if the next ticks can be jumped
+ */
+bool steadyBalls(int nbBalls) {
+	int i;
+
+	for (i = 0; i < nbBalls; ++i) {
+		if (!balls[i].bonusTimer && (fabs(balls[i].speed.x) != NORMAL || fabs(balls[i].speed.y) != NORMAL)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * Check that a ball moves in closed form : whole position and speed, each tick adds to it
+ * without rounding.
+ * @param		Ball const*	ball	the ball
+ * @return	bool							true if it does
+ */
+bool wholeBall(Ball const *ball) {
+	return ball->origin.x == floor(ball->origin.x) && ball->origin.y == floor(ball->origin.y)
+		&& ball->speed.x == floor(ball->speed.x) && ball->speed.y == floor(ball->speed.y);
+}
+
+/**
+ * Get the move of a ball per tick : its speed, nothing while it respawns.
+ * @param		Ball const*	ball	the ball
+ * @return	Vector2D					the move per tick
+ */
+Vector2D ballMotion(Ball const *ball) {
+	Vector2D motion;
+	initVector2D(&motion, 0, 0);
+	if (!ball->respawnTimer) {
+		motion = ball->speed;
+	}
+	return motion;
+}
+
+/**
+ * Find the number of ticks a ball can fly without any event of its own : no border, no bar
+ * band (unless the bar, at full speed, can't get there first), no brick on its whole path,
+ * no timer running out. The bricks, the dearest, are only looked for before the other events.
+ * @param		Ball const*	ball			the ball
+ * @param		int					nbPlayers	total number of players in game
+ * @param		long				limit			the most ticks looked at
+ * @return	long									the number of quiet ticks, limit if more
+ */
+long nextBallEvent(Ball const *ball, int nbPlayers, long limit) {
+	Vector2D motion = ballMotion(ball);
+	Bar const *bar;
+	double x = ball->origin.x, y = ball->origin.y, vx = motion.x, vy = motion.y;
+	double radius = ball->radius, reach = ball->radius + EVENT_REACH, position, speed, low, high, gap;
+	long ticks = limit, event;
+	int i;
+
+	/* collisionBallScreen : bounce or out of bounds, the only bounds without any reach */
+	radius += wholeBall(ball) ? 0 : EVENT_DRIFT;
+	event = ticksToReachBelow(x, vx, HUD_HEIGHT + radius);
+	ticks = event < ticks ? event : ticks;
+	event = ticksToReachAbove(x, vx, SCREEN_WIDTH - HUD_HEIGHT - radius);
+	ticks = event < ticks ? event : ticks;
+	event = ticksToReachBelow(y, vy, HUD_HEIGHT + radius);
+	ticks = event < ticks ? event : ticks;
+	event = ticksToReachAbove(y, vy, SCREEN_HEIGHT - HUD_HEIGHT - radius);
+	ticks = event < ticks ? event : ticks;
+
+	for (i = 0; i < nbPlayers; ++i) {
+		bar = &players[i].bar;
+		position = bar->orientationHorizontal ? y : x;
+		speed = bar->orientationHorizontal ? vy : vx;
+		low = (bar->orientationHorizontal ? bar->center.y : bar->center.x) - (BAR_HEIGHT / 2) - reach;
+		high = (bar->orientationHorizontal ? bar->center.y : bar->center.x) + (BAR_HEIGHT / 2) + reach;
+		if (position < low) {
+			event = ticksToReachAbove(position, speed, low);
+		} else if (position > high) {
+			event = ticksToReachBelow(position, speed, high);
+		} else if (fabs(position - (low + high) / 2) - (BAR_HEIGHT / 2) >= ball->radius + EVENT_DRIFT
+			&& (position < (low + high) / 2 ? speed <= 0 : speed >= 0)) {
+			/* bounced off, or passed : flying away from the bar */
+			event = EVENT_NEVER;
+		} else {
+			event = 0;
+		}
+		if (event < ticks) {
+			/* the gap along the bar closes by the ball and the bar at full speed */
+			gap = fabs((bar->orientationHorizontal ? x - bar->center.x : y - bar->center.y)) - (bar->width / 2) - reach;
+			speed = BAR_SPEED + fabs(bar->orientationHorizontal ? vx : vy);
+			event = gap > 0 && gap / speed > event ? (long)floor(gap / speed) : event;
+		}
+		ticks = event < ticks ? event : ticks;
+	}
+
+	/* the last respawning tick already counts the ball for GladOS */
+	if (ball->respawnTimer && ball->respawnTimer - 1 < ticks) {
+		ticks = ball->respawnTimer - 1;
+	}
+	if (ball->bonusTimer && ball->bonusTimer < ticks) {
+		ticks = ball->bonusTimer;
+	}
+	if (ticks <= 0) {
+		return 0;
+	}
+	return nextBrickImpact(ball, motion, reach, ticks);
+}
+
+/**
+ * Find the number of ticks before two moving balls could overlap (collisionBallBall pushes
+ * them apart as soon as they do).
+ * @param		Ball const*	a	the first ball
+ * @param		Ball const*	b	the second ball
+ * @return	long					the number of quiet ticks, EVENT_NEVER if they never meet
+ */
+long nextPairEvent(Ball const *a, Ball const *b) {
+	double dx = b->origin.x - a->origin.x, dy = b->origin.y - a->origin.y;
+	double vx = b->speed.x - a->speed.x, vy = b->speed.y - a->speed.y;
+	double gap = a->radius + b->radius + EVENT_REACH;
+	double qa = (vx * vx) + (vy * vy), qb = 2 * ((dx * vx) + (dy * vy)), qc = (dx * dx) + (dy * dy) - (gap * gap);
+	double disc, first;
+
+	if (qc <= 0) {
+		/* within the reach but moving apart, and too far to be pushed apart */
+		gap = a->radius + b->radius + EVENT_DRIFT;
+		return qb >= 0 && (dx * dx) + (dy * dy) >= gap * gap ? EVENT_NEVER : 0;
+	}
+	disc = (qb * qb) - (4 * qa * qc);
+	if (qa == 0 || disc < 0) {
+		return EVENT_NEVER;
+	}
+	first = (-qb - sqrt(disc)) / (2 * qa);
+	return first < 0 ? EVENT_NEVER : (long)floor(first);
+}
+
+/*/////////////////////////////////////////
+ //				GLADOS FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Find the ball GladOS follows during the next ticks (the choice of handleGladOS). With
+ * whole balls the scores compared are exact. Otherwise indesirableNumberOne truncates
+ * each score by less than 1 : the choice is only kept while the difference is wider.
+ * @param		int		nbBalls	the number of balls in game
+ * @param		int*	target	the followed ball
+ * @return	long					the number of ticks the choice stays the same
+ */
+long chooseGladOSTarget(int nbBalls, int *target) {
+	double way = balls[0].speed.y < 0 ? -1 : 1, rate = way * ballMotion(&balls[0]).y, diff, change, margin;
+	long ticks = EVENT_NEVER, event;
+	int i;
+
+	*target = 0;
+	for (i = 1; i < nbBalls; ++i) {
+		/* a respawning ball stays out of the choice during the whole jump */
+		if (balls[i].respawnTimer) {
+			continue;
+		}
+		/* diff is the difference after the first tick, it changes by the rates difference */
+		change = ((balls[i].speed.y < 0 ? -1 : 1) * balls[i].speed.y) - rate;
+		if (wholeBall(&balls[0]) && wholeBall(&balls[i])) {
+			diff = indesirableNumberOne(&balls[i]) - indesirableNumberOne(&balls[0]) + change;
+			margin = 0;
+		} else {
+			diff = ((balls[i].speed.y < 0 ? -1 : 1) * (balls[i].origin.y + balls[i].speed.y))
+				- (way * (balls[0].origin.y + ballMotion(&balls[0]).y));
+			margin = 2 + EVENT_DRIFT;
+		}
+		if (diff > margin) {
+			*target = i;
+			event = ticksToReachBelow(diff, change, margin);
+		} else if (diff <= -margin) {
+			event = ticksToReachAbove(diff, change, margin ? -margin : 1);
+		} else {
+			return 0;
+		}
+		ticks = event < ticks ? event : ticks;
+	}
+	return ticks;
+}
+
+/**
+ * Check the borders of handleGladOS : a bar may only move if it isn't already past the border.
+ * @param		Bar const*	bar			the bar
+ * @param		double			center	the position of the bar along its axis
+ * @param		long				way			the direction of the move, -1, 0 or 1
+ * @return	bool								true if handleGladOS moves the bar
+ */
+bool barCanMove(Bar const *bar, double center, long way) {
+	long limit = bar->orientationHorizontal ? SCREEN_WIDTH - HUD_HEIGHT : SCREEN_HEIGHT - HUD_HEIGHT;
+
+	if (way < 0) {
+		return center - (bar->width / 2) >= HUD_HEIGHT;
+	}
+	if (way > 0) {
+		return center + (bar->width / 2) <= limit;
+	}
+	return true;
+}
+
+/**
+ * Find how long a bar locked on its ball (same position every tick) can follow it.
+ * @param		Bar const*	bar			the bar
+ * @param		double			target	the position of the ball along the bar axis, now
+ * @param		double			speed		the move of the ball along the bar axis per tick
+ * @param		long				from		the first tick where the bar starts locked
+ * @param		double			margin	how much earlier the borders are looked for
+ * @return	long								the last tick it still follows, EVENT_NEVER if it always does
+ */
+long lockedBarTicks(Bar const *bar, double target, double speed, long from, double margin) {
+	long limit = bar->orientationHorizontal ? SCREEN_WIDTH - HUD_HEIGHT : SCREEN_HEIGHT - HUD_HEIGHT;
+	long stop;
+
+	/* the move of tick n + 1 needs the bar (the ball after n ticks) inside the borders */
+	if (speed < 0) {
+		stop = ticksToReachBelow(target, speed, HUD_HEIGHT + (bar->width / 2) - (margin ? -margin : 1));
+	} else if (speed > 0) {
+		stop = ticksToReachAbove(target, speed, limit - (bar->width / 2) + (margin ? -margin : 1));
+	} else {
+		return EVENT_NEVER;
+	}
+	if (stop == EVENT_NEVER) {
+		return EVENT_NEVER;
+	}
+	return stop > from ? stop : from;
+}
+
+/**
+ * Plan the moves of a GladOS bar in closed form : stuck against a border, or at full speed
+ * towards its ball until it is close enough, then on the ball every tick. With a ball or a
+ * bar that isn't whole, the ticks where handleGladOS is within EVENT_DRIFT of another
+ * decision are played.
+ * @param		Bar const*		bar			the bar
+ * @param		int						nbBalls	the number of balls in game
+ * @param		BarCourse*		course	the planned moves
+ * @return	long									the number of ticks the plan holds
+ */
+long planGladOS(Bar const *bar, int nbBalls, BarCourse *course) {
+	long ticks = chooseGladOSTarget(nbBalls, &course->target), event;
+	Ball const *ball = &balls[course->target];
+	double target = bar->orientationHorizontal ? ball->origin.x : ball->origin.y;
+	double speed = bar->orientationHorizontal ? ballMotion(ball).x : ballMotion(ball).y;
+	double center = bar->orientationHorizontal ? bar->center.x : bar->center.y;
+	double offset = target + speed - center, last, margin = 0;
+	long way = offset < 0 ? -1 : (offset > 0 ? 1 : 0);
+
+	course->start = center;
+	course->lock = 1;
+	course->way = way;
+	course->stuck = false;
+	if (ticks <= 0) {
+		return 0;
+	}
+
+	if (!wholeBall(ball) || center != floor(center)) {
+		margin = EVENT_DRIFT;
+		if (fabs(speed) >= BAR_SPEED - margin || fabs(fabs(offset) - BAR_SPEED) < margin
+			|| (fabs(offset) < margin && !(barCanMove(bar, center, -1) && barCanMove(bar, center, 1)))) {
+			return 0;
+		}
+	}
+
+	if (!barCanMove(bar, center, way)) {
+		/* stuck until the ball goes back to the other side of the bar */
+		course->stuck = true;
+		if (way > 0) {
+			event = ticksToReachBelow(target + speed, speed, margin ? center + margin : center - 1);
+		} else {
+			event = ticksToReachAbove(target + speed, speed, margin ? center - margin : center + 1);
+		}
+		return event < ticks ? event : ticks;
+	}
+
+	if (offset > BAR_SPEED || offset < -BAR_SPEED) {
+		/* full speed until the offset fits in BAR_SPEED (tick course->lock) */
+		course->lock = 1 + (long)ceil(((way * offset) - BAR_SPEED - margin) / (BAR_SPEED - (way * speed)));
+		event = way < 0 ? ticksToReachBelow(center, -BAR_SPEED, HUD_HEIGHT + (bar->width / 2) - 1 + (margin ? 1 + margin : 0))
+			: ticksToReachAbove(center, BAR_SPEED, (bar->orientationHorizontal ? SCREEN_WIDTH : SCREEN_HEIGHT)
+				- HUD_HEIGHT - (bar->width / 2) + 1 - (margin ? 1 + margin : 0));
+		if (event < course->lock - 1) {
+			return event < ticks ? event : ticks;
+		}
+		/* the last (shorter) move, right on the ball */
+		last = offset + ((course->lock - 1) * (speed - (BAR_SPEED * way)));
+		if ((margin && (way * last > BAR_SPEED - margin || fabs(last) < margin))
+			|| !barCanMove(bar, center + (BAR_SPEED * way * (course->lock - 1)), last < 0 ? -1 : (last > 0 ? 1 : 0))) {
+			return course->lock - 1 < ticks ? course->lock - 1 : ticks;
+		}
+	}
+
+	event = lockedBarTicks(bar, target, speed, course->lock, margin);
+	return event < ticks ? event : ticks;
+}
+
+/*/////////////////////////////////////////
+ //				FAST-FORWARD FUNCTIONS				//
+/////////////////////////////////////////*/
+
+/**
+ * Move a coordinate by as many ticks : in closed form if it stays whole, otherwise with the
+ * same float additions as the ticks.
+ * @param		float*	coordinate	the coordinate
+ * @param		float		speed				the move per tick
+ * @param		long		ticks				the number of ticks
+ */
+void jumpCoordinate(float *coordinate, float speed, long ticks) {
+	long i;
+
+	if (speed == 0) {
+		return;
+	}
+	if (*coordinate == floor(*coordinate) && speed == floor(speed)) {
+		*coordinate += speed * ticks;
+		return;
+	}
+	for (i = 0; i < ticks; ++i) {
+		*coordinate += speed;
+	}
+}
+
+/**
+ * Jump over the ticks before the next event of a match played by GladOS on every seat.
+ * The state afterwards is exactly the one of as many ticks of collideBalls, moveBalls,
+ * moveBricks and handleGladOS. Nothing is done if the next tick may hold an event, or if
+ * a seat is not played by GladOS (a human or a bot can't be foreseen) : play the tick
+ * normally, then fast-forward again.
+ * The ball that held the last event is looked at first : when it still does, nothing
+ * else is looked for.
+ * @param		GridBrick			grid				the 2 dimensional brick grid
+ * @param		int						gridWidth		the number of columns in game
+ * @param		int						gridHeight	the number of lines
+ * @param		int						nbPlayers		total number of players in game
+ * @param		int						nbBalls			the number of balls in game
+ * @param		unsigned int	gladOSSeats	one bit per seat played by GladOS (1u << seat)
+ * @param		long					maxTicks		the most ticks to jump
+ * @return	long											the number of ticks jumped, 0 if the next tick must be played
+ */
+long fastForward(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls, unsigned int gladOSSeats, long maxTicks) {
+	unsigned int allSeats = (1u << nbPlayers) - 1;
+	BarCourse courses[4];
+	Vector2D motion;
+	Bar *bar;
+	long ticks = maxTicks, event;
+	int i, j, k;
+
+	if (ticks <= 0 || (gladOSSeats & allSeats) != allSeats || !steadyBalls(nbBalls)) {
+		return 0;
+	}
+	blocker = blocker < nbBalls ? blocker : 0;
+	for (k = 0; k < nbBalls && ticks > 0; ++k) {
+		i = (blocker + k) % nbBalls;
+		ticks = nextBallEvent(&balls[i], nbPlayers, ticks);
+		blocker = ticks > 0 ? blocker : i;
+	}
+	for (i = 0; i < nbBalls && ticks > 0; ++i) {
+		for (j = i + 1; j < nbBalls && !balls[i].respawnTimer; ++j) {
+			if (!balls[j].respawnTimer) {
+				event = nextPairEvent(&balls[i], &balls[j]);
+				ticks = event < ticks ? event : ticks;
+			}
+		}
+	}
+	for (i = 0; i < nbPlayers && ticks > 0; ++i) {
+		event = planGladOS(&players[i].bar, nbBalls, &courses[i]);
+		ticks = event < ticks ? event : ticks;
+	}
+	if (ticks <= 0) {
+		return 0;
+	}
+
+	for (i = 0; i < nbBalls; ++i) {
+		motion = ballMotion(&balls[i]);
+		jumpCoordinate(&balls[i].origin.x, motion.x, ticks);
+		jumpCoordinate(&balls[i].origin.y, motion.y, ticks);
+		if (balls[i].respawnTimer) {
+			balls[i].respawnTimer -= ticks;
+		}
+		if (balls[i].bonusTimer) {
+			balls[i].bonusTimer -= ticks;
+		}
+	}
+	hashBalls(nbBalls);
+	/* a locked bar ends on its ball, wherever it is */
+	for (i = 0; i < nbPlayers; ++i) {
+		bar = &players[i].bar;
+		if (courses[i].stuck) {
+			continue;
+		}
+		if (ticks < courses[i].lock) {
+			jumpCoordinate(bar->orientationHorizontal ? &bar->center.x : &bar->center.y, BAR_SPEED * courses[i].way, ticks);
+		} else if (bar->orientationHorizontal) {
+			bar->center.x = balls[courses[i].target].origin.x;
+		} else {
+			bar->center.y = balls[courses[i].target].origin.y;
+		}
+		hashPlayer(i);
+	}
+	moveBricks(grid, gridWidth, gridHeight, ticks);
+	return ticks;
+}
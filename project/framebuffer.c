@@ -0,0 +1,163 @@
+/**
+ * @file		framebuffer.c
+ *       		framebuffer functions library. Offscreen render targets (EXT_framebuffer_object)
+ * 			    used to render once and composite many times with a single textured quad.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define GL_GLEXT_PROTOTYPES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+#include <GL/glext.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+/* framebuffers bound before each beginRenderTarget, targets can be nested */
+static GLint previousFramebuffers[RENDER_TARGET_DEPTH];
+static int renderTargetDepth = 0;
+
+/*/////////////////////////////////////////
+ //				RENDER TARGET FUNCTIONS				//
+/////////////////////////////////////////*/
+
+/**
+ * Tell if the current GL context can render into textures.
+ * @return	bool	true if EXT_framebuffer_object is available
+ */
+bool renderTargetSupported() {
+	static int supported = -1;
+	char const *extensions;
+
+	if (supported == -1) {
+		extensions = (char const *)glGetString(GL_EXTENSIONS);
+		supported = extensions != NULL && strstr(extensions, "GL_EXT_framebuffer_object") != NULL;
+	}
+	return supported;
+}
+
+/**
+ * Create an offscreen render target : a RGBA texture attached to a framebuffer object.
+ * @param		RenderTarget*	target	the render target to initialise
+ * @param		int						width		width in pixels
+ * @param		int						height	height in pixels
+ * @return	bool									false if the target can't be used (draw directly instead)
+ */
+bool initRenderTarget(RenderTarget *target, int width, int height) {
+	target->fbo = 0;
+	target->texture = 0;
+	target->width = width;
+	target->height = height;
+	if (!renderTargetSupported()) {
+		return false;
+	}
+
+	glGenTextures(1, &target->texture);
+	glBindTexture(GL_TEXTURE_2D, target->texture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	glGenFramebuffersEXT(1, &target->fbo);
+	glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, target->fbo);
+	glFramebufferTexture2DEXT(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, target->texture, 0);
+	if (glCheckFramebufferStatusEXT(GL_FRAMEBUFFER_EXT) != GL_FRAMEBUFFER_COMPLETE_EXT) {
+		glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+		freeRenderTarget(target);
+		return false;
+	}
+	glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+	return true;
+}
+
+/**
+ * Redirect the drawing into a render target. The given logical area of the screen
+ * is mapped on the whole target, so the usual drawing functions work unchanged.
+ * The framebuffer bound before (window or headless frame) is restored by endRenderTarget.
+ * @param	RenderTarget const*	target	the render target to draw into
+ * @param	Point2D							topLeft			top left corner of the area (screen coordinates)
+ * @param	Point2D							bottomRight	bottom right corner of the area (screen coordinates)
+ */
+void beginRenderTarget(RenderTarget const *target, Point2D topLeft, Point2D bottomRight) {
+	glGetIntegerv(GL_FRAMEBUFFER_BINDING_EXT, &previousFramebuffers[renderTargetDepth++]);
+	glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, target->fbo);
+	glPushAttrib(GL_VIEWPORT_BIT | GL_COLOR_BUFFER_BIT);
+	glViewport(0, 0, target->width, target->height);
+	glMatrixMode(GL_PROJECTION);
+	glPushMatrix();
+	glLoadIdentity();
+	gluOrtho2D(topLeft.x, bottomRight.x, bottomRight.y, topLeft.y);
+	glMatrixMode(GL_MODELVIEW);
+
+	glClearColor(0, 0, 0, 0);
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+/**
+ * Stop drawing into the current render target and go back to the previous framebuffer.
+ */
+void endRenderTarget() {
+	glMatrixMode(GL_PROJECTION);
+	glPopMatrix();
+	glMatrixMode(GL_MODELVIEW);
+	glPopAttrib();
+	glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, previousFramebuffers[--renderTargetDepth]);
+}
+
+/**
+ * Composite a render target on the screen with a single textured quad.
+ * @param	RenderTarget const*	target			the render target to draw
+ * @param	Point2D							topLeft			top left corner (screen coordinates)
+ * @param	Point2D							bottomRight	bottom right corner (screen coordinates)
+ */
+void drawRenderTarget(RenderTarget const *target, Point2D topLeft, Point2D bottomRight) {
+	glEnable(GL_TEXTURE_2D);
+	glColor3f(255, 255, 255);
+	glBindTexture(GL_TEXTURE_2D, target->texture);
+
+	/* framebuffer textures are bottom-up */
+	glBegin(GL_QUADS);
+		glTexCoord2f(0.0f, 1.0f);
+		glVertex2f(topLeft.x, topLeft.y);
+		glTexCoord2f(1.0f, 1.0f);
+		glVertex2f(bottomRight.x, topLeft.y);
+		glTexCoord2f(1.0f, 0.0f);
+		glVertex2f(bottomRight.x, bottomRight.y);
+		glTexCoord2f(0.0f, 0.0f);
+		glVertex2f(topLeft.x, bottomRight.y);
+	glEnd();
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glDisable(GL_TEXTURE_2D);
+}
+
+/**
+ * Free the framebuffer and the texture of a render target.
+ * @param	RenderTarget*	target	the render target to free
+ */
+void freeRenderTarget(RenderTarget *target) {
+	if (target->fbo) {
+		glDeleteFramebuffersEXT(1, &target->fbo);
+	}
+	if (target->texture) {
+		glDeleteTextures(1, &target->texture);
+	}
+	target->fbo = 0;
+	target->texture = 0;
+}
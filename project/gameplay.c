@@ -24,6 +24,11 @@
 
 Ball *balls;
 Player *players;
+char *playersNames[4];
+Color3f themeColor;
+
+static double slideOffsets[BRICK_SLIDE_PERIOD];
+static double orbitOffsets[BRICK_ORBIT_PERIOD][2];
 
 /*/////////////////////////////////////////
  //		GAMEPLAY INITIALISATON FUNCTIONS	//
@@ -99,6 +104,7 @@ void initGame(int nbPlayers) {
 		initPlayer(&players[i-1], i,  playersNames[i - 1], barCenter, themeColor);
 		initBall(&balls[i-1], i, BALL_RADIUS, ballSpeed, ballCenter, themeColor, i);
 	}
+	resetStateHash(nbPlayers, nbPlayers);
 }
 
 /*/////////////////////////////////////////
@@ -132,6 +138,7 @@ void moveBar (Bar *bar, enum direction dir) {
 			bar->center.y += BAR_SPEED;
 		}
 	}
+	hashPlayer(bar->playerId - 1);
 }
 
 /**
@@ -154,13 +161,26 @@ void handleGladOS(Bar *bar, Ball const *balls, int nbBalls) {
 			indexBall = i;
 		}
 	}
-	offset = balls[indexBall].origin.x - bar->center.x;
+	if (bar->orientationHorizontal) {
+		offset = balls[indexBall].origin.x - bar->center.x;
+	} else {
+		offset = balls[indexBall].origin.y - bar->center.y;
+	}
 	if (offset < -BAR_SPEED) {
 		offset = -BAR_SPEED;
 	}
 	if (offset > BAR_SPEED) {
 		offset = BAR_SPEED;
 	}
+	/* side bars (3 and 4 players mode) follow the ball vertically */
+	if (!bar->orientationHorizontal) {
+		if ((offset < 0 && (bar->center.y - (bar->width / 2)) >= (HUD_HEIGHT))
+			|| (offset > 0 && (bar->center.y + (bar->width / 2)) <= (SCREEN_HEIGHT - HUD_HEIGHT))) {
+			bar->center.y += offset;
+		}
+		hashPlayer(bar->playerId - 1);
+		return;
+	}
 	if (offset < 0) {
 		if ((bar->center.x - (bar->width / 2)) >= (HUD_HEIGHT)) {
 			bar->center.x += offset;
@@ -171,6 +191,7 @@ void handleGladOS(Bar *bar, Ball const *balls, int nbBalls) {
 			bar->center.x += offset;
 		}
 	}
+	hashPlayer(bar->playerId - 1);
 }
 
 /**
@@ -196,6 +217,9 @@ void hitBrick (Brick *brick, Ball *ball) {
 	if (brick->type != INDESTRUCTIBLE) {
 		brick->status = DESTROYED;
 		players[ball->lastPlayerId - 1].score += 10;
+		hashBrick(brick);
+		removeBrick(brick);
+		emitBrickBurst(brick);
 	}
 	if (brick->type == WIDER_BAR) {
 		if (barWidth == SMALL) {
@@ -226,39 +250,290 @@ void hitBrick (Brick *brick, Ball *ball) {
 	if (brick->type == SLOWER_BALL || brick->type == FASTER_BALL) {
 		ball->bonusTimer = BALL_BONUS_TIME;
 	}
+	hashPlayer(ball->lastPlayerId - 1);
 }
 
 /**
  * Start all immediate actions related to a ball falling out of the playground.
- * Relaunch the ball at the center of the screen, on the side it fell.
- * @param	Ball*	ball	the current ball pointer
- * @param	enum	dir		the side the ball fell
+ * Relaunch the ball at the center of the screen, on the side it fell. The life of the
+ * player is taken by loseLives.
+ * @param		Ball*	ball	the current ball pointer
+ * @param		enum	dir		the side the ball fell
+ * @return	int					the bit of the player who missed the ball
  */
-void ballOutOfBounds(Ball *ball, enum direction dir) {
+int ballOutOfBounds(Ball *ball, enum direction dir) {
 	ball->origin.x = SCREEN_WIDTH_CENTER;
 	ball->respawnTimer = BALL_RESPAWN_TIME;
 	ball->speed.y *= -1;
 	ball->speed.x *= -1;
 	if (dir == TOP) {
-		--(players[0].life);
 		ball->lastPlayerId = 1;
 		ball->origin.y = HUD_HEIGHT + (3 * BAR_HEIGHT);
 	}
 	if (dir == BOTTOM) {
-		--(players[1].life);
 		ball->lastPlayerId = 2;
 		ball->origin.y = SCREEN_HEIGHT - HUD_HEIGHT - (3 * BAR_HEIGHT);
 	}
 	if (dir == LEFT) {
-		--(players[2].life);
 		ball->lastPlayerId = 3;
 		ball->origin.x = HUD_HEIGHT + (3 * BAR_HEIGHT);
 	}
 	if (dir == RIGHT) {
-		--(players[3].life);
 		ball->lastPlayerId = 4;
 		ball->origin.x = SCREEN_WIDTH - HUD_HEIGHT - (3 * BAR_HEIGHT);
 	}
+	return 1 << (ball->lastPlayerId - 1);
+}
+
+/**
+ * Take a life from every player who missed a ball.
+ * @param	int	fallen	one bit per player, as returned by collisionBallScreen
+ */
+void loseLives(int fallen) {
+	int i;
+	for (i = 0; i < 4; ++i) {
+		if (fallen & (1 << i)) {
+			--(players[i].life);
+			hashPlayer(i);
+		}
+	}
+}
+
+/**
+ * Run the collisions of one ball for one tick : screen borders, bars, then bricks.
+ * @param	GridBrick	grid				the 2 dimensional brick grid
+ * @param	Ball*			ball				the current ball pointer
+ * @param	int				gridWidth		the config file gridWidth
+ * @param	int				gridHeight	the config file gridHeight
+ * @param	int				nbPlayers		total number of players in game
+ */
+void collideBall(GridBrick grid, Ball *ball, int gridWidth, int gridHeight, int nbPlayers) {
+	int j;
+	loseLives(collisionBallScreen(ball, nbPlayers));
+	for (j = 0; j < nbPlayers; ++j) {
+		collisionBarBall(&(players[j].bar), ball);
+	}
+	collisionBallGrid(grid, ball, gridWidth, gridHeight);
+}
+
+/**
+ * Detection phase of the parallel collisions, on a chunk of balls. A ball only changes
+ * itself : the lives lost and the brick hit are kept in its BallHit for resolveBallHits.
+ * @param	void*	data	the CollisionJob
+ * @param	int		first	the first ball of the chunk
+ * @param	int		last	the ball after the chunk
+ */
+void detectBallHits(void *data, int first, int last) {
+	CollisionJob const *job = data;
+	BallHit *hit;
+	int i, j;
+
+	for (i = first; i < last; ++i) {
+		hit = &job->hits[i];
+		hit->before = balls[i];
+		hit->fallen = collisionBallScreen(&balls[i], job->nbPlayers);
+		for (j = 0; j < job->nbPlayers; ++j) {
+			collisionBarBall(&(players[j].bar), &balls[i]);
+		}
+		hit->brick = findBrickHit(job->grid, &balls[i], job->gridWidth, job->gridHeight, &hit->side);
+	}
+}
+
+/**
+ * Resolution phase of the parallel collisions, in ball id order on a single thread : the
+ * lives, scores, bricks and bars end exactly like with collideBall on each ball in turn,
+ * whatever the number of threads.
+ * A brick already broken by a ball with a smaller id is looked for again without it. Once
+ * a bar width changed, the next balls were detected against the old bar : they are put
+ * back as they were and collided again.
+ * @param	CollisionJob const*	job			the detected hits
+ * @param	int									nbBalls	the number of balls in game
+ */
+void resolveBallHits(CollisionJob const *job, int nbBalls) {
+	BallHit const *hit;
+	int widths[4];
+	bool barsChanged = false;
+	int i, j;
+
+	for (j = 0; j < job->nbPlayers; ++j) {
+		widths[j] = players[j].bar.width;
+	}
+	for (i = 0; i < nbBalls; ++i) {
+		hit = &job->hits[i];
+		if (barsChanged) {
+			balls[i] = hit->before;
+			collideBall(job->grid, &balls[i], job->gridWidth, job->gridHeight, job->nbPlayers);
+			continue;
+		}
+		loseLives(hit->fallen);
+		if (hit->brick != NULL && hit->brick->status == DESTROYED) {
+			collisionBallGrid(job->grid, &balls[i], job->gridWidth, job->gridHeight);
+		} else if (hit->brick != NULL) {
+			bounceOffBrick(hit->brick, &balls[i], hit->side);
+		}
+		for (j = 0; j < job->nbPlayers; ++j) {
+			barsChanged = barsChanged || players[j].bar.width != widths[j];
+		}
+	}
+}
+
+/**
+ * Run the collisions of every ball for one tick : screen borders, bars, bricks, then the other balls.
+ * With workers and enough balls, the balls are detected in parallel then resolved in order.
+ * @param	GridBrick	grid				the 2 dimensional brick grid
+ * @param	int				gridWidth		the config file gridWidth
+ * @param	int				gridHeight	the config file gridHeight
+ * @param	int				nbPlayers		total number of players in game
+ * @param	int				nbBalls			the number of balls in game
+ */
+void collideBalls(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls) {
+	static BallHit *hits = NULL;
+	static int capacity = 0;
+	BallHit *grown;
+	CollisionJob job;
+	int i;
+
+	if (nbBalls < COLLISION_PARALLEL_BALLS || workersCount() < 2) {
+		for (i = 0; i < nbBalls; ++i) {
+			collideBall(grid, &balls[i], gridWidth, gridHeight, nbPlayers);
+		}
+	} else {
+		if (nbBalls > capacity) {
+			if ((grown = realloc(hits, nbBalls * sizeof(BallHit))) == NULL) {
+				exit(MALLOC_ERROR);
+			}
+			hits = grown;
+			capacity = nbBalls;
+		}
+		job.grid = grid;
+		job.gridWidth = gridWidth;
+		job.gridHeight = gridHeight;
+		job.nbPlayers = nbPlayers;
+		job.hits = hits;
+		runWorkers(detectBallHits, &job, nbBalls, COLLISION_CHUNK);
+		resolveBallHits(&job, nbBalls);
+	}
+	collideBallPairs(balls, nbBalls);
+}
+
+/**
+ * Move every ball for one tick and update the respawn and bonus timers.
+ * @param	int	nbBalls	the number of balls in game
+ */
+void moveBalls(int nbBalls) {
+	int i;
+	for (i = 0; i < nbBalls; ++i) {
+		if (!balls[i].respawnTimer) {
+			moveBall(&balls[i]);
+		} else {
+			--(balls[i].respawnTimer);
+		}
+		if (!balls[i].bonusTimer) {
+			balls[i].speed.x = balls[i].speed.x < 0 ? - NORMAL : NORMAL;
+			balls[i].speed.y = balls[i].speed.y < 0 ? - NORMAL : NORMAL;
+		} else {
+			--(balls[i].bonusTimer);
+		}
+	}
+	hashBalls(nbBalls);
+}
+
+/**
+ * Compute the offsets of the brick motions for every phase, once and for all : moveBricks
+ * only adds them, with exactly the values sin and cos would give.
+ */
+void initBrickMotions() {
+	float angle;
+	int i;
+
+	for (i = 0; i < BRICK_SLIDE_PERIOD; ++i) {
+		angle = (2 * PI * i) / BRICK_SLIDE_PERIOD;
+		slideOffsets[i] = BRICK_SLIDE_AMPLITUDE * sin(angle);
+	}
+	for (i = 0; i < BRICK_ORBIT_PERIOD; ++i) {
+		angle = (2 * PI * i) / BRICK_ORBIT_PERIOD;
+		orbitOffsets[i][0] = BRICK_ORBIT_RADIUS * sin(angle);
+		orbitOffsets[i][1] = BRICK_ORBIT_RADIUS * (1 - cos(angle));
+	}
+}
+
+/**
+ * Move every living brick along its motion : SLIDE goes left and right, ORBIT turns
+ * around its starting position. The positions only depend on the phase, so moving
+ * several ticks at once ends exactly where as many single ticks would.
+ * @param	GridBrick	grid				the 2 dimensional brick grid
+ * @param	int				gridWidth		the number of columns in game
+ * @param	int				gridHeight	the number of lines
+ * @param	long			ticks				the number of ticks to move, 1 in a normal tick
+ */
+void moveBricks(GridBrick grid, int gridWidth, int gridHeight, long ticks) {
+	Brick *brick;
+	Point2D topLeft;
+	int i, j, phase;
+
+	beginBrickRefits(grid);
+	for (i = 0; i < gridHeight; ++i) {
+		for (j = 0; j < gridWidth; ++j) {
+			brick = &grid[i][j];
+			if (brick->motion == STILL || brick->status == DESTROYED) {
+				continue;
+			}
+			brick->phase = (brick->phase + ticks) % (BRICK_SLIDE_PERIOD * BRICK_ORBIT_PERIOD);
+			if (brick->motion == SLIDE) {
+				initPoint2D(&topLeft, brick->home.x + slideOffsets[brick->phase % BRICK_SLIDE_PERIOD], brick->home.y);
+			} else {
+				phase = brick->phase % BRICK_ORBIT_PERIOD;
+				initPoint2D(&topLeft, brick->home.x + orbitOffsets[phase][0], brick->home.y + orbitOffsets[phase][1]);
+			}
+			updateBrickCoordinates(brick, topLeft);
+		}
+	}
+	endBrickRefits(grid);
+}
+
+/**
+ * Give the action of a key : ACTION_MINUS / ACTION_PLUS of the seat it controls.
+ * @param		SDLKey				key	the key pressed or released
+ * @return	unsigned int			the action bit, 0 if the key doesn't move a bar
+ */
+unsigned int keyAction(SDLKey key) {
+	switch (key) {
+		/* BASIC ACTIONS */
+		case SDLK_a : return ACTION_MINUS(0);
+		case SDLK_z : return ACTION_PLUS(0);
+		case SDLK_LEFT : return ACTION_MINUS(1);
+		case SDLK_RIGHT : return ACTION_PLUS(1);
+
+		/* 4PLAYERS MODE ACTIONS */
+		case SDLK_u : return ACTION_MINUS(2);
+		case SDLK_n : return ACTION_PLUS(2);
+		case SDLK_KP9 : return ACTION_MINUS(3);
+		case SDLK_KP3 : return ACTION_PLUS(3);
+		default : return 0;
+	}
+}
+
+/**
+ * Move the bars of every seat from an actions bitmask, GladOS plays the seats of its mask.
+ * @param	unsigned int	actions			the actions bitmask
+ * @param	unsigned int	gladOSSeats	bit i set if GladOS plays seat i
+ * @param	int						nbPlayers		total number of players in game
+ * @param	int						nbBalls			the number of balls in game
+ */
+void applyPlayersActions(unsigned int actions, unsigned int gladOSSeats, int nbPlayers, int nbBalls) {
+	int i;
+	for (i = 0; i < nbPlayers; ++i) {
+		if (gladOSSeats & (1u << i)) {
+			handleGladOS(&(players[i].bar), balls, nbBalls);
+			continue;
+		}
+		if (actions & ACTION_MINUS(i)) {
+			moveBar(&(players[i].bar), players[i].bar.orientationHorizontal ? LEFT : TOP);
+		}
+		if (actions & ACTION_PLUS(i)) {
+			moveBar(&(players[i].bar), players[i].bar.orientationHorizontal ? RIGHT : BOTTOM);
+		}
+	}
 }
 
 /*/////////////////////////////////////////
@@ -0,0 +1,185 @@
+/**
+ * @file		hash.c
+ *       		hash functions library. 64 bits hash of the match state, kept up to date by the
+ * 			    functions changing it instead of reading the whole state again : each part (a
+ * 			    destroyed brick, a player, the balls) has its own term and the hash is the XOR of
+ * 			    the terms, so a change only replaces its term.
+ * 			    - hitBrick toggles the term of the destroyed brick : nothing depends on the size
+ * 			      of the grid, the moving bricks only depend on the tick.
+ * 			    - hitBrick, loseLives and the bar moves give their player a new term (life,
+ * 			      score, bar width and position).
+ * 			    - moveBalls and fastForward give the balls a new term as they move them.
+ * 			    Two machines, or two builds, playing the same match give the same hash at each
+ * 			    tick as long as they compute exactly the same floats.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static StateHash stateHash;
+
+/*/////////////////////////////////////////
+ //					MIX FUNCTIONS								//
+/////////////////////////////////////////*/
+
+/**
+ * Mix a word into a hash (splitmix64 finalizer) : any bit changed changes half the result.
+ * @param		Uint64	hash	the hash so far
+ * @param		Uint64	word	the word to add, two 32 bits values with HASH_WORD
+ * @return	Uint64				the new hash
+ */
+Uint64 mixHash(Uint64 hash, Uint64 word) {
+	hash = (hash ^ word) + HASH_GOLDEN;
+	hash = (hash ^ (hash >> 30)) * HASH_MULTIPLIER_1;
+	hash = (hash ^ (hash >> 27)) * HASH_MULTIPLIER_2;
+	return hash ^ (hash >> 31);
+}
+
+/**
+ * Give the bits of a float, the exact value computed.
+ * @param		float		value	the float
+ * @return	Uint32				its bits
+ */
+Uint32 floatWord(float value) {
+	Uint32 word;
+	memcpy(&word, &value, sizeof(word));
+	return word;
+}
+
+/**
+ * Compute the term of a player : life, score, bar width and position.
+ * @param		int			index	the player, from 0
+ * @return	Uint64				the term
+ */
+Uint64 playerTerm(int index) {
+	Player const *player = &players[index];
+	Uint64 hash = HASH_WORD(HASH_PLAYER, index);
+
+	hash = mixHash(hash, HASH_WORD(player->life, player->score));
+	hash = mixHash(hash, player->bar.width);
+	return mixHash(hash, HASH_WORD(floatWord(player->bar.center.x), floatWord(player->bar.center.y)));
+}
+
+/**
+ * Compute the term of a ball : position, speed, timers and last player.
+ * @param		int			index	the ball, from 0
+ * @return	Uint64				the term
+ */
+Uint64 ballTerm(int index) {
+	Ball const *ball = &balls[index];
+	Uint64 hash = HASH_WORD(HASH_BALL, index);
+
+	hash = mixHash(hash, HASH_WORD(floatWord(ball->origin.x), floatWord(ball->origin.y)));
+	hash = mixHash(hash, HASH_WORD(floatWord(ball->speed.x), floatWord(ball->speed.y)));
+	hash = mixHash(hash, HASH_WORD(ball->radius, ball->respawnTimer));
+	return mixHash(hash, HASH_WORD(ball->bonusTimer, ball->lastPlayerId));
+}
+
+/*/////////////////////////////////////////
+ //					UPDATE FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Start the hash of a new match : no brick destroyed, every player and ball as they are.
+ * @param	int	nbPlayers	total number of players in game
+ * @param	int	nbBalls		the number of balls in game
+ */
+void resetStateHash(int nbPlayers, int nbBalls) {
+	int i;
+
+	memset(&stateHash, 0, sizeof(stateHash));
+	for (i = 0; i < nbPlayers && i < 4; ++i) {
+		stateHash.players[i] = playerTerm(i);
+	}
+	hashBalls(nbBalls);
+}
+
+/**
+ * Add or remove a destroyed brick. Only called by the thread running hitBrick.
+ * @param	Brick const*	brick	the brick destroyed
+ */
+void hashBrick(Brick const *brick) {
+	stateHash.bricks ^= mixHash(HASH_BRICK, HASH_WORD(brick->gridY, brick->gridX));
+}
+
+/**
+ * Give a player its new term after a change.
+ * @param	int	index	the player, from 0
+ */
+void hashPlayer(int index) {
+	stateHash.players[index] = playerTerm(index);
+}
+
+/**
+ * Give the balls their new term after they moved.
+ * @param	int	nbBalls	the number of balls in game
+ */
+void hashBalls(int nbBalls) {
+	int i;
+
+	stateHash.balls = 0;
+	for (i = 0; i < nbBalls; ++i) {
+		stateHash.balls ^= ballTerm(i);
+	}
+}
+
+/**
+ * Give the hash of the state at a tick.
+ * @param		long		tick	the ticks played in the match
+ * @return	Uint64				the hash
+ */
+Uint64 matchHash(long tick) {
+	return savedMatchHash(&stateHash, tick);
+}
+
+/**
+ * Give the hash of a saved state.
+ * @param		StateHash const*	saved	the terms saved with the state
+ * @param		long							tick	the ticks played before the state
+ * @return	Uint64									the hash
+ */
+Uint64 savedMatchHash(StateHash const *saved, long tick) {
+	return mixHash(HASH_TICK, tick) ^ saved->bricks ^ saved->players[0] ^ saved->players[1]
+		^ saved->players[2] ^ saved->players[3] ^ saved->balls;
+}
+
+/**
+ * Write a hash as 16 hexadecimal digits.
+ * @param	FILE*		output	the file
+ * @param	Uint64	hash		the hash
+ */
+void printHash(FILE *output, Uint64 hash) {
+	fprintf(output, "%08lx%08lx", (unsigned long)(hash >> 32), (unsigned long)(hash & 0xFFFFFFFFU));
+}
+
+/*/////////////////////////////////////////
+ //					ROLLBACK FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Copy the terms with a saved state.
+ * @param	StateHash*	copy	the copy
+ */
+void saveStateHash(StateHash *copy) {
+	*copy = stateHash;
+}
+
+/**
+ * Put back the terms of a saved state.
+ * @param	StateHash const*	copy	the copy
+ */
+void restoreStateHash(StateHash const *copy) {
+	stateHash = *copy;
+}
@@ -38,28 +38,179 @@
 #define BUTTON_WIDTH 360
 #define BUTTON_HEIGHT 60
 #define SPACE_BETWEEN_BUTTONS 20
+#define IDLE_REDRAW_DELAY 500
 
 /* -----------( HUD )------------ */
 #define HUD_HEIGHT 70
 #define LIFE_SIZE_WIDTH 20
 #define LIFE_SIZE_HEIGHT 26
 
+/* -----------( TEXT )----------- */
+#define GLYPH_WIDTH 9
+#define GLYPH_HEIGHT 15
+#define GLYPH_CELL_HEIGHT 20
+#define GLYPH_BASELINE 15
+#define GLYPH_FIRST 32
+#define GLYPH_COUNT 96
+#define GLYPH_ATLAS_COLUMNS 16
+#define GLYPH_ATLAS_WIDTH (GLYPH_ATLAS_COLUMNS * GLYPH_WIDTH)
+#define GLYPH_ATLAS_HEIGHT ((GLYPH_COUNT / GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_HEIGHT)
+#define GLYPH_ATLAS_PATH "img/font9x15.png"
+
+/* ----------( RENDERER )-------- */
+#define RENDER_NO_TEXTURE -1
+
+/* ---------( RESOLUTION )-------- */
+#define RENDER_TARGET_DEPTH 4
+#define RESOLUTION_LEVELS 5
+#define RESOLUTION_WINDOW 30
+#define RESOLUTION_REFRESH 60
+/* with vsync the intervals jitter around the refresh period and a missed refresh doubles
+ * one : 10% over the period is still in budget, a missed refresh every few frames is not */
+#define RESOLUTION_MARGIN 1.1
+#define RESOLUTION_PROBE 10
+
 /* -----------( BRICK )---------- */
 #define BRICK_WIDTH 62
 #define BRICK_HEIGHT 32
+#define BRICK_SLIDE_AMPLITUDE 40
+#define BRICK_SLIDE_PERIOD 480
+#define BRICK_ORBIT_RADIUS 12
+#define BRICK_ORBIT_PERIOD 240
+#define BRICK_SLIDE_DRIFT ((2 * PI * BRICK_SLIDE_AMPLITUDE) / BRICK_SLIDE_PERIOD)
+#define BRICK_ORBIT_DRIFT ((2 * PI * BRICK_ORBIT_RADIUS) / BRICK_ORBIT_PERIOD)
+
+/* -----------( EVENTS )---------- */
+#define EVENT_NEVER 0x7FFFFFFFL
+#define EVENT_REACH 2
+#define EVENT_DRIFT 1
+
+/* ------------( BVH )------------ */
+#define BVH_NO_NODE -1
+#define BVH_CAPACITY (2 * GRID_MAX_WIDTH * GRID_MAX_HEIGHT)
+#define BVH_STACK_SIZE 64
 
 /* -----------( BAR )------------ */
 #define BAR_HEIGHT 12
 #define BAR_SPEED 6
 
+/* ----------( SIMULATION )--------- */
+#define SIM_TICK_DURATION 8
+#define SNAPSHOT_FRESH 4
+#define GRID_MAX_WIDTH 15
+#define GRID_MAX_HEIGHT 9
+#define ACTION_MINUS(seat) (1u << (2 * (seat)))
+#define ACTION_PLUS(seat) (1u << ((2 * (seat)) + 1))
+
+/* ----------( WORKERS )---------- */
+#define WORKERS_MAX 16
+#define COLLISION_CHUNK 32
+#define COLLISION_PARALLEL_BALLS 512
+
+/* ------------( HASH )------------ */
+#define HASH_WORD(high, low) ((((Uint64)(high)) << 32) | (Uint32)(low))
+#define HASH_GOLDEN HASH_WORD(0x9E3779B9U, 0x7F4A7C15U)
+#define HASH_MULTIPLIER_1 HASH_WORD(0xBF58476DU, 0x1CE4E5B9U)
+#define HASH_MULTIPLIER_2 HASH_WORD(0x94D049BBU, 0x133111EBU)
+#define HASH_TICK 1
+#define HASH_BRICK 2
+#define HASH_PLAYER 3
+#define HASH_BALL 4
+
+/* ----------( ROLLBACK )---------- */
+#define ROLLBACK_WINDOW 15
+#define ROLLBACK_FRAMES 32
+
+/* ----------( REWIND )---------- */
+#define REWIND_SECONDS 60
+#define REWIND_KEYFRAME_TICKS 250
+/* a whole segment more : the oldest one is dropped at once */
+#define REWIND_FRAMES (((REWIND_SECONDS * 1000) / SIM_TICK_DURATION) + REWIND_KEYFRAME_TICKS)
+#define REWIND_POOL_SIZE (2 * 1024 * 1024)
+
+/* ----------( SHARED )---------- */
+#define SHARED_MAGIC 0x4B50534DU
+#define SHARED_VERSION 2
+#define SHARED_MAX_BALLS 16
+#define SHARED_BRICK_WORDS (((GRID_MAX_WIDTH * GRID_MAX_HEIGHT) + 31) / 32)
+#define SHARED_RING_SIZE 64
+#define SHARED_MINUS 1u
+#define SHARED_PLUS 2u
+#define SHARED_STALE_TICKS (1000 / SIM_TICK_DURATION)
+
+/* ----------( NETWORK )---------- */
+#define NET_PROTOCOL 0x4B50
+#define NET_DEFAULT_PORT 27500
+#define NET_PACKET_SIZE 512
+#define NET_INPUT 1
+#define NET_SNAPSHOT 2
+#define NET_ROLLBACK 3
+#define NET_HISTORY 32
+#define NET_SNAPSHOT_TICKS 8
+#define NET_KEEPALIVE 100
+#define NET_TIMEOUT 3000
+#define NET_OVER_REPEAT 4
+#define NET_SHIM_QUEUE 256
+#define NET_MAX_BALLS 8
+#define NET_BRICK_WORDS (((GRID_MAX_WIDTH * GRID_MAX_HEIGHT) + 31) / 32)
+#define NET_POSITION_BITS 15
+#define NET_POSITION_OFFSET 256
+#define NET_SPEED_BITS 9
+#define NET_SPEED_OFFSET 32
+#define NET_SCALE 8
+#define NET_SMALL_BITS 6
+
+/* ----------( SPECTATOR )---------- */
+#define SPECTATOR_MAGIC 0x4B505356U
+#define SPECTATOR_VERSION 1
+/* 2 seconds of ticks : a spectator further behind jumps to the last frame */
+#define SPECTATOR_SLOTS 256
+
+/* -----------( INPUT )---------- */
+#define INPUT_QUEUE_SIZE 256
+#define INPUT_LATENCY_BINS 32
+
 /* -----------( BALL )------------ */
 #define BALL_RADIUS 7
+#define BALL_SIDES 32
 
 /* ---------( GAMEPLAY )--------- */
 #define START_LIFE 3
 #define BALL_RESPAWN_TIME 100
 #define BALL_BONUS_TIME 600
 
+/* ---------( PARTICLES )--------- */
+#define PARTICLE_CAPACITY 4096
+#define PARTICLE_BURST_QUEUE 256
+#define PARTICLE_LIFE 60
+#define PARTICLE_SIZE 4
+#define PARTICLE_MIN_SPEED 0.5f
+#define PARTICLE_MAX_SPEED 3.0f
+#define PARTICLE_GRAVITY 0.05f
+
+/* -------( OBSERVATION )-------- */
+#define OBSERVATION_SIZE 84
+#define OBSERVATION_BAR 208
+#define OBSERVATION_BALL 255
+
+/* ---------( CAPTURE )---------- */
+#define CAPTURE_QUEUE_SIZE 8
+#define CAPTURE_FPS 60
+
+/* ---------( PROFILER )--------- */
+#define PROFILER_RING_SIZE 1024
+#define PROFILER_WINDOW 256
+
+#ifdef PROFILER
+#define PROFILE_BEGIN(phase) profilerBegin(phase)
+#define PROFILE_END(phase) profilerEnd(phase)
+#define PROFILE_END_FRAME() profilerEndFrame()
+#else
+#define PROFILE_BEGIN(phase)
+#define PROFILE_END(phase)
+#define PROFILE_END_FRAME()
+#endif
+
 /* -----------( OTHER )---------- */
 #define PI 3.1415926535897932384626433832795
 #define MALLOC_ERROR -3
@@ -92,6 +243,12 @@ enum brickStatus {
 	DESTROYED
 };
 
+enum brickMotion {
+	STILL = 0,
+	SLIDE = 1,
+	ORBIT = 2
+};
+
 enum brickType {
 	ORDINARY = 0,
 	INDESTRUCTIBLE = 1,
@@ -144,6 +301,15 @@ enum gameStep {
 	PAUSE
 };
 
+enum profilerPhase {
+	PHASE_EVENTS,
+	PHASE_COLLISION,
+	PHASE_MOVEMENT,
+	PHASE_DRAW,
+	PHASE_SWAP,
+	PHASE_NB
+};
+
 /*/////////////////////////////////////////
  //					GEOMETRIC STRUCTURES				//
 /////////////////////////////////////////*/
@@ -188,7 +354,11 @@ typedef struct Brick {
 	int status;
 	int gridX;
 	int gridY;
+	int motion;
+	int phase;
+	int leaf;
 
+	Point2D home;
 	Point2D topLeft;
 	Point2D topRight;
 	Point2D bottomLeft;
@@ -197,10 +367,45 @@ typedef struct Brick {
 
 typedef Brick** GridBrick;
 
+typedef struct SweepEntry {
+	float left;
+	float right;
+	float y;
+	int index;
+} SweepEntry;
+
+typedef struct BVHNode {
+	Point2D min;
+	Point2D max;
+	int parent;
+	int left;
+	int right;
+	Brick *brick;
+} BVHNode;
+
+typedef struct BrickTree {
+	BVHNode nodes[BVH_CAPACITY];
+	int nbNodes;
+	int root;
+	GridBrick grid;
+	float margin;
+} BrickTree;
+
 /*/////////////////////////////////////////
  //					GAMEPLAY STRUCTURES					//
 /////////////////////////////////////////*/
 
+/* a match opened without the menu (benches, tools) : openMatch / closeMatch */
+typedef struct Match {
+	GridBrick grid;
+	int *brickTypes;
+	int gridWidth;
+	int gridHeight;
+	int nbPlayers;
+	int nbBalls;
+	unsigned int gladOSSeats;
+} Match;
+
 typedef struct Player {
 	int id;
 	char *name;
@@ -210,6 +415,363 @@ typedef struct Player {
 	int score;
 } Player;
 
+typedef struct BarCourse {
+	int target;
+	double start;
+	long lock;
+	int way;
+	bool stuck;
+} BarCourse;
+
+typedef struct BallHit {
+	Ball before;
+	int fallen;
+	Brick *brick;
+	enum direction side;
+} BallHit;
+
+typedef struct CollisionJob {
+	GridBrick grid;
+	int gridWidth;
+	int gridHeight;
+	int nbPlayers;
+	BallHit *hits;
+} CollisionJob;
+
+/*/////////////////////////////////////////
+ //					DISPLAY STRUCTURES					//
+/////////////////////////////////////////*/
+
+typedef struct TextMesh {
+	int nbGlyphs;
+	int capacity;
+	GLfloat *vertices;
+	GLfloat *texCoords;
+} TextMesh;
+
+typedef struct RenderTarget {
+	GLuint fbo;
+	GLuint texture;
+	int width;
+	int height;
+} RenderTarget;
+
+typedef struct Renderer {
+	char const *name;
+	bool offscreen;
+	void (*beginFrame)();
+	void (*endFrame)();
+	void (*bindTexture)(int index);
+	void (*drawQuad)(Point2D const *corners, Point2D const *texCoords, Color3f color);
+	void (*drawTriangles)(GLfloat const *vertices, GLfloat const *colors, int nbVertices);
+	void (*drawText)(TextMesh const *mesh, Color3f color);
+	void (*pushTransform)(float x, float y, float angle);
+	void (*popTransform)();
+} Renderer;
+
+typedef struct RenderStats {
+	unsigned long frames;
+	unsigned long quads;
+	unsigned long batches;
+	unsigned long texts;
+	unsigned long binds;
+	unsigned long transforms;
+	unsigned long triangles;
+} RenderStats;
+
+typedef struct HUDCache {
+	bool valid;
+	bool targetReady;
+	bool targetFailed;
+	int score;
+	int life;
+	char const *name;
+	char scoreString[12];
+	TextMesh nameMesh;
+	TextMesh scoreMesh;
+	RenderTarget target;
+} HUDCache;
+
+typedef struct ParticleBurst {
+	Point2D center;
+	int type;
+	int texture;
+} ParticleBurst;
+
+typedef struct ParticlePool {
+	int count;
+	int peak;
+	unsigned long droppedBursts;
+	unsigned long droppedParticles;
+	float x[PARTICLE_CAPACITY];
+	float y[PARTICLE_CAPACITY];
+	float vx[PARTICLE_CAPACITY];
+	float vy[PARTICLE_CAPACITY];
+	float life[PARTICLE_CAPACITY];
+	float r[PARTICLE_CAPACITY];
+	float g[PARTICLE_CAPACITY];
+	float b[PARTICLE_CAPACITY];
+} ParticlePool;
+
+/*/////////////////////////////////////////
+ //				SIMULATION STRUCTURES					//
+/////////////////////////////////////////*/
+
+typedef struct RenderSnapshot {
+	long tick;
+	bool over;
+	int nbPlayers;
+	int nbBalls;
+	int gridWidth;
+	int gridHeight;
+	Player players[4];
+	Ball *balls;
+	Brick bricks[GRID_MAX_WIDTH * GRID_MAX_HEIGHT];
+	Brick *rows[GRID_MAX_HEIGHT];
+} RenderSnapshot;
+
+typedef struct TripleBuffer {
+	RenderSnapshot buffers[3];
+	int back;
+	int middle;
+	int front;
+} TripleBuffer;
+
+typedef struct StateHash {
+	Uint64 bricks;
+	Uint64 players[4];
+	Uint64 balls;
+} StateHash;
+
+typedef struct MatchState {
+	long tick;
+	Player players[4];
+	Ball *balls;
+	Brick bricks[GRID_MAX_WIDTH * GRID_MAX_HEIGHT];
+	BrickTree tree;
+	StateHash hash;
+} MatchState;
+
+typedef struct RollbackFrame {
+	long tick;
+	unsigned int local;
+	long remoteTick;
+	unsigned int remote;
+	unsigned int used;
+	MatchState state;
+} RollbackFrame;
+
+typedef struct RewindFrame {
+	long tick;
+	long keyTick;
+	unsigned long offset;
+	int size;
+	bool keyframe;
+} RewindFrame;
+
+typedef struct InputEvent {
+	Uint32 time;
+	unsigned int action;
+	bool pressed;
+} InputEvent;
+
+typedef void (*WorkerJob)(void *data, int first, int last);
+
+/* shared memory segment (shared.c), read by processes in other languages :
+ * only 32 bits fields, no pointer */
+typedef struct SharedBall {
+	float x;
+	float y;
+	float speedX;
+	float speedY;
+	Sint32 radius;
+	Sint32 respawnTimer;
+	Sint32 bonusTimer;
+	Sint32 lastPlayerId;
+} SharedBall;
+
+typedef struct SharedBar {
+	float x;
+	float y;
+	Sint32 width;
+	Sint32 horizontal;
+} SharedBar;
+
+typedef struct SharedState {
+	Uint32 magic;
+	Uint32 version;
+	Uint32 sequence;
+	Uint32 tick;
+	Sint32 over;
+	Sint32 nbPlayers;
+	Sint32 nbBalls;
+	Sint32 gridWidth;
+	Sint32 gridHeight;
+	Sint32 lives[4];
+	Sint32 scores[4];
+	SharedBar bars[4];
+	SharedBall balls[SHARED_MAX_BALLS];
+	Uint32 bricks[SHARED_BRICK_WORDS];
+} SharedState;
+
+typedef struct SharedRing {
+	Uint32 attached;
+	Uint32 heartbeat;
+	Uint32 head;
+	Uint32 tail;
+	Uint32 actions[SHARED_RING_SIZE];
+} SharedRing;
+
+typedef struct SharedSegment {
+	SharedState state;
+	SharedRing rings[4];
+} SharedSegment;
+
+/* network (network.c, server.c, client.c) : the positions and speeds are in 1 / NET_SCALE pixel */
+typedef struct NetPlayer {
+	int life;
+	int score;
+	int x;
+	int y;
+	int width;
+} NetPlayer;
+
+typedef struct NetBall {
+	int x;
+	int y;
+	int speedX;
+	int speedY;
+	int radius;
+	int respawnTimer;
+	int lastPlayerId;
+} NetBall;
+
+typedef struct NetState {
+	Uint32 tick;
+	int over;
+	int nbPlayers;
+	int nbBalls;
+	int gridWidth;
+	int gridHeight;
+	NetPlayer players[4];
+	NetBall balls[NET_MAX_BALLS];
+	Uint32 bricks[NET_BRICK_WORDS];
+} NetState;
+
+typedef struct NetHistory {
+	NetState states[NET_HISTORY];
+	Uint16 sequences[NET_HISTORY];
+	bool valid[NET_HISTORY];
+} NetHistory;
+
+typedef struct BitStream {
+	unsigned char *data;
+	int size;
+	int bit;
+	bool overflow;
+} BitStream;
+
+typedef struct DelayedPacket {
+	Uint32 due;
+	Uint32 host;
+	Uint16 port;
+	int length;
+	unsigned char data[NET_PACKET_SIZE];
+} DelayedPacket;
+
+typedef struct NetSocket {
+	int fd;
+	int loss;
+	int latency;
+	Uint32 seed;
+	DelayedPacket delayed[NET_SHIM_QUEUE];
+	int delayedHead;
+	int delayedCount;
+	long bytesSent;
+	long packetsSent;
+	long packetsDropped;
+	long bytesReceived;
+	long packetsReceived;
+} NetSocket;
+
+typedef struct NetPeer {
+	bool connected;
+	Uint32 host;
+	Uint16 port;
+	Uint32 lastHeard;
+	Uint16 inputSequence;
+	bool hasAck;
+	Uint16 acked;
+	unsigned int held;
+	unsigned int pressed;
+	long bytesSent;
+	long packetsSent;
+	long bytesReceived;
+	long snapshotsSent;
+	long fullSnapshots;
+} NetPeer;
+
+typedef struct NetClient {
+	NetSocket socket;
+	Uint32 host;
+	Uint16 port;
+	int seat;
+	int gridWidth;
+	int gridHeight;
+	NetHistory received;
+	NetState state;
+	bool hasState;
+	Uint16 sequence;
+	Uint32 stateTime;
+	Uint16 inputSequence;
+	unsigned int sentKeys;
+	Uint32 lastSend;
+	long snapshotsReceived;
+	long snapshotsLost;
+	long snapshotsUndecodable;
+	int nbTemplatePlayers;
+	RenderSnapshot snapshot;
+	Ball balls[NET_MAX_BALLS];
+} NetClient;
+
+/* spectator feed (spectator.c) : the game writes one NetState per tick, the spectators only read.
+ * Frame n is in slots[n % SPECTATOR_SLOTS], its sequence is 2n + 1 while written then 2n + 2 */
+typedef struct SpectatorSlot {
+	Uint32 sequence;
+	NetState state;
+} SpectatorSlot;
+
+typedef struct SpectatorFeed {
+	Uint32 magic;
+	Uint32 version;
+	Uint32 head;
+	SpectatorSlot slots[SPECTATOR_SLOTS];
+} SpectatorFeed;
+
+typedef struct Spectator {
+	SpectatorFeed const *feed;
+	Uint32 cursor;
+	long framesRead;
+	long framesSkipped;
+	long retries;
+	NetClient view;
+} Spectator;
+
+/*/////////////////////////////////////////
+ //					PROFILER STRUCTURES					//
+/////////////////////////////////////////*/
+
+typedef struct FrameProfile {
+	unsigned long frame;
+	unsigned long phases[PHASE_NB];
+} FrameProfile;
+
+typedef struct PhaseStats {
+	unsigned long min;
+	unsigned long avg;
+	unsigned long p99;
+} PhaseStats;
+
 /*/////////////////////////////////////////
  //					MENU STRUCTURES							//
 /////////////////////////////////////////*/
@@ -239,6 +801,15 @@ extern Player *players;
 extern char *playersNames[];
 extern GLuint texturesBuffer[];
 extern Color3f themeColor;
+extern Point2D ballMesh[];
+extern GLuint glyphAtlas;
+extern HUDCache hudCaches[];
+extern int hudRebuilds;
+extern Point2D const quadTexCoords[];
+extern Renderer const glRenderer;
+extern Renderer const nullRenderer;
+extern Renderer const recordRenderer;
+extern Renderer const *renderer;
 
 /*/////////////////////////////////////////
  //					FUNCTIONS PROTOTYPE					//
@@ -246,6 +817,7 @@ extern Color3f themeColor;
 
 /* ------------( core.c )------------ */
 
+unsigned long clockNow();
 int *readConfigFile(char *filePath, int *gridWidth, int *gridHeight);
 void initBar(Bar *bar, Point2D center, Color3f color, int playerId);
 void initBall(Ball *bl, int id, int radius, Vector2D speed, Point2D origin, Color3f color, int lastPlayerId);
@@ -254,6 +826,9 @@ void updateBrickCoordinates(Brick *br, Point2D topLeft);
 void initBrickCoordinates(GridBrick grid, int gridWidth, int gridHeight);
 GridBrick initGrid(int gridWidth, int gridHeight, int *blockType);
 int *readThemeFile(char *filePath, int *gridWidth, int *gridHeight);
+void initMatchDefaults(char *name);
+void openMatch(Match *match, char const *level, int nbPlayers, unsigned int gladOSSeats);
+void closeMatch(Match *match);
 
 /* ----------( geometry.c )---------- */
 
@@ -273,25 +848,91 @@ float distance(Point2D a, Point2D b);
 
 /* ------------( collision.c )----------- */
 
-void collisionBallScreen(Ball *ball, int nbPlayers);
+int collisionBallScreen(Ball *ball, int nbPlayers);
 bool collisionBallLine(Ball const *ball, Point2D A, Point2D B);
 enum collisionType collisionBallSegment(Ball const *ball, Point2D A, Point2D B);
 enum direction collisionBallBrick(Ball const *ball, Brick const *brick);
+Brick *findBrickHit(GridBrick grid, Ball const *ball, int gridWidth, int gridHeight, enum direction *collision);
+void bounceOffBrick(Brick *brick, Ball *ball, enum direction collision);
 bool collisionBallGrid(GridBrick grid, Ball *ball, int gridWidth, int gridHeight);
 void collisionBarBall(Bar const *bar, Ball *ball);
+bool collisionBallBall(Ball *a, Ball *b);
+void sortBallsX(SweepEntry *entries, Ball const *balls, int nbBalls);
+int collideBallPairs(Ball *balls, int nbBalls);
 void moveBall(Ball *ball);
 
+/* --------------( bvh.c )------------- */
+
+void buildBrickTree(GridBrick grid, int gridWidth, int gridHeight);
+int buildBrickNode(Brick **bricks, int nbBricks, int parent);
+void fitBrickNode(BVHNode *node);
+void refitBrickAncestors(int index);
+void refitBrick(Brick const *brick);
+void beginBrickRefits(GridBrick grid);
+void endBrickRefits(GridBrick grid);
+void removeBrick(Brick *brick);
+Brick *queryBrickTree(Ball const *ball, enum direction *collision);
+float rayBoxEntry(Point2D origin, Vector2D speed, Point2D min, Point2D max);
+float brickSeparation(Ball const *ball, Vector2D speed, Brick const *brick, float reach);
+long nextBrickImpact(Ball const *ball, Vector2D speed, float reach, long limit);
+BrickTree const *brickTree();
+void saveBrickTree(BrickTree *copy);
+void restoreBrickTree(BrickTree const *copy);
+
+/* --------------( hash.c )------------- */
+
+Uint64 mixHash(Uint64 hash, Uint64 word);
+Uint32 floatWord(float value);
+Uint64 playerTerm(int index);
+Uint64 ballTerm(int index);
+void resetStateHash(int nbPlayers, int nbBalls);
+void hashBrick(Brick const *brick);
+void hashPlayer(int index);
+void hashBalls(int nbBalls);
+Uint64 matchHash(long tick);
+Uint64 savedMatchHash(StateHash const *saved, long tick);
+void printHash(FILE *output, Uint64 hash);
+/* ROLLBACK */
+void saveStateHash(StateHash *copy);
+void restoreStateHash(StateHash const *copy);
+
+/* ------------( events.c )------------ */
+
+long ticksToReachBelow(double from, double speed, double bound);
+long ticksToReachAbove(double from, double speed, double bound);
+bool steadyBalls(int nbBalls);
+bool wholeBall(Ball const *ball);
+Vector2D ballMotion(Ball const *ball);
+long nextBallEvent(Ball const *ball, int nbPlayers, long limit);
+long nextPairEvent(Ball const *a, Ball const *b);
+long chooseGladOSTarget(int nbBalls, int *target);
+bool barCanMove(Bar const *bar, double center, long way);
+long lockedBarTicks(Bar const *bar, double target, double speed, long from, double margin);
+long planGladOS(Bar const *bar, int nbBalls, BarCourse *course);
+void jumpCoordinate(float *coordinate, float speed, long ticks);
+long fastForward(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls, unsigned int gladOSSeats, long maxTicks);
+
 /* ------------( display.c )----------- */
 
 void drawBar(Bar bar);
+void initBallMesh();
 void drawBall(Ball ball);
+void drawBalls(Ball const *balls, int nbBalls);
 void drawBrick(Brick br);
 void drawGrid(GridBrick const grid,int gridWidth, int gridHeight);
+void drawGame(GridBrick const grid, int gridWidth, int gridHeight, Player const *players, int nbPlayers,
+	Ball const *balls, int nbBalls);
+void drawPlayfield(GridBrick const grid, int gridWidth, int gridHeight, Player const *players, int nbPlayers,
+	Ball const *balls, int nbBalls);
+void drawHUDs(Player const *players, int nbPlayers);
 void drawBackground(int index);
 
 /* HUD DISPLAY */
 void drawRectangle(int index, Point2D topLeft, Point2D topRight, Point2D bottomRight, Point2D bottomLeft);
 void drawHUD(Player const *pl, int nbPlayers);
+void drawCachedHUD(Player const *pl, int nbPlayers);
+void resetHUDCaches();
+void freeHUDCaches();
 void drawLife();
 void drawLifes(int nbHearts);
 void renderBitmapString(float x, float y, char const *string);
@@ -305,6 +946,294 @@ void loadTextures(char *themePath);
 void chargeTexture(char *imgaddress);
 
 
+/* ------------( text.c )------------ */
+
+/* GLYPH ATLAS */
+void initGlyphAtlas();
+void freeGlyphAtlas();
+
+/* TEXT MESH */
+void buildTextMesh(TextMesh *mesh, float x, float y, char const *string, bool vertical);
+void drawTextMesh(TextMesh const *mesh, Color3f color);
+void freeTextMesh(TextMesh *mesh);
+
+/* HUD CACHE */
+HUDCache *updateHUDCache(Player const *pl, float nameX, float nameY, float scoreX, float scoreY, bool vertical);
+
+/* -----------( renderer.c )---------- */
+
+void setRenderer(Renderer const *backend);
+Renderer const *findRenderer(char const *name);
+
+/* OPENGL BACKEND */
+void beginFrameGL();
+void endFrameGL();
+void bindTextureGL(int index);
+void drawQuadGL(Point2D const *corners, Point2D const *texCoords, Color3f color);
+void drawTrianglesGL(GLfloat const *vertices, GLfloat const *colors, int nbVertices);
+void drawTextGL(TextMesh const *mesh, Color3f color);
+void pushTransformGL(float x, float y, float angle);
+void popTransformGL();
+
+/* NULL BACKEND */
+void beginFrameNull();
+void endFrameNull();
+void bindTextureNull(int index);
+void drawQuadNull(Point2D const *corners, Point2D const *texCoords, Color3f color);
+void drawTrianglesNull(GLfloat const *vertices, GLfloat const *colors, int nbVertices);
+void drawTextNull(TextMesh const *mesh, Color3f color);
+void pushTransformNull(float x, float y, float angle);
+void popTransformNull();
+
+/* RECORDING BACKEND */
+void startRecording(FILE *output);
+RenderStats const *recordingStats();
+void printRecordingStats(FILE *output);
+void beginFrameRecord();
+void endFrameRecord();
+void bindTextureRecord(int index);
+void drawQuadRecord(Point2D const *corners, Point2D const *texCoords, Color3f color);
+void drawTrianglesRecord(GLfloat const *vertices, GLfloat const *colors, int nbVertices);
+void drawTextRecord(TextMesh const *mesh, Color3f color);
+void pushTransformRecord(float x, float y, float angle);
+void popTransformRecord();
+
+/* ----------( particles.c )---------- */
+
+/* BURSTS */
+void emitBrickBurst(Brick const *brick);
+void muteBrickBursts(bool muted);
+unsigned int particleRandom();
+void spawnBurst(ParticleBurst const *burst);
+
+/* POOL */
+void resetParticles();
+void updateParticles(long tick);
+void drawParticles();
+ParticlePool const *particlePool();
+
+/* ---------( observation.c )--------- */
+
+int coveredPixels(float min, float max, int size, int *first);
+void fillSpan(unsigned char *line, int width, float left, float right, unsigned char gray);
+void fillBox(unsigned char *pixels, int width, int height, Point2D min, Point2D max, unsigned char gray);
+void fillBall(unsigned char *pixels, int width, int height, Ball const *ball, unsigned char gray);
+void drawObservation(unsigned char *pixels, int width, int height, GridBrick const grid, int gridWidth,
+	int gridHeight, Player const *players, int nbPlayers, Ball const *balls, int nbBalls);
+void stackObservation(unsigned char *frames, int depth, int width, int height, GridBrick const grid,
+	int gridWidth, int gridHeight, Player const *players, int nbPlayers, Ball const *balls, int nbBalls);
+
+/* ---------( framebuffer.c )--------- */
+
+bool renderTargetSupported();
+bool initRenderTarget(RenderTarget *target, int width, int height);
+void beginRenderTarget(RenderTarget const *target, Point2D topLeft, Point2D bottomRight);
+void endRenderTarget();
+void drawRenderTarget(RenderTarget const *target, Point2D topLeft, Point2D bottomRight);
+void freeRenderTarget(RenderTarget *target);
+
+/* ---------( simulation.c )--------- */
+
+/* SNAPSHOTS */
+void initSnapshot(RenderSnapshot *snapshot, int nbBalls);
+void fillSnapshot(RenderSnapshot *snapshot);
+void publishSnapshot();
+RenderSnapshot const *consumeSnapshot();
+
+/* SIMULATION THREAD */
+void simulationTick(unsigned int actions);
+int simulationThread(void *data);
+void setSimulationMatch(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls, unsigned int gladOSSeats);
+void startSimulation(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls, unsigned int gladOSSeats);
+void stopSimulation();
+void setSimulationPaused(bool paused);
+void setSimulationRewinding(bool rewinding);
+unsigned int collectActions(Uint32 tickTime, bool record);
+
+/* ROLLBACK */
+void saveSimulation(MatchState *state);
+void restoreSimulation(MatchState const *state);
+
+/* ----------( shared.c )---------- */
+
+void openSharedState(char const *name);
+void closeSharedState();
+bool sharedStateActive();
+void resetSharedActions();
+void publishSharedState(RenderSnapshot const *snapshot);
+unsigned int sharedActions(unsigned int actions);
+unsigned int sharedSeats();
+
+/* ----------( spectator.c )---------- */
+
+/* FEED */
+void openSpectatorFeed(char const *name);
+void closeSpectatorFeed();
+void publishSpectatorFrame(RenderSnapshot const *snapshot);
+
+/* SPECTATORS */
+bool attachSpectator(Spectator *spectator, char const *name);
+void detachSpectator(Spectator *spectator);
+bool readSpectatorFrame(Spectator *spectator, NetState *state);
+RenderSnapshot const *updateSpectator(Spectator *spectator);
+
+/* ----------( network.c )---------- */
+
+/* SOCKETS */
+void setNetworkShim(int loss, int latency);
+bool resolveAddress(char const *name, Uint32 *host, Uint16 *port);
+bool openSocket(NetSocket *sock, Uint16 port);
+void closeSocket(NetSocket *sock);
+Uint32 shimRandom(NetSocket *sock);
+void sendPacket(NetSocket *sock, Uint32 host, Uint16 port, unsigned char const *data, int length);
+void flushPackets(NetSocket *sock);
+int receivePacket(NetSocket *sock, Uint32 *host, Uint16 *port, unsigned char *data);
+
+/* BITS */
+void initBitStream(BitStream *stream, unsigned char *data, int size);
+void writeBits(BitStream *stream, Uint32 value, int bits);
+Uint32 readBits(BitStream *stream, int bits);
+int bitStreamBytes(BitStream const *stream);
+void writeValue(BitStream *stream, int value, int predicted, int bits);
+int readValue(BitStream *stream, int predicted, int bits);
+
+/* STATES */
+bool newerSequence(Uint16 a, Uint16 b);
+int quantize(float value, int offset, int bits);
+float dequantize(int value, int offset);
+void captureNetState(NetState *state, RenderSnapshot const *snapshot);
+int predictPosition(int position, int speed, NetBall const *baseline, long ticks);
+void writeNetState(BitStream *stream, NetState const *state, NetState const *baseline);
+void readNetState(BitStream *stream, NetState *state, NetState const *baseline);
+void storeNetState(NetHistory *history, NetState const *state, Uint16 sequence);
+NetState const *findNetState(NetHistory const *history, Uint16 sequence);
+
+/* ----------( server.c )---------- */
+
+void openServer(Uint16 port);
+void closeServer();
+bool serverActive();
+NetPeer const *serverPeer(int seat);
+NetState const *serverState(Uint16 sequence);
+void receiveInputs();
+unsigned int serverActions(unsigned int actions);
+void sendServerState(NetState const *state, int copies);
+void publishServerState(RenderSnapshot const *snapshot);
+void idleServer();
+
+/* ----------( client.c )---------- */
+
+void initClientSnapshot(NetClient *client, GridBrick grid, int gridWidth, int gridHeight, Player const *players,
+	int nbPlayers);
+void startClient(NetClient *client, Uint32 host, Uint16 port, int seat, GridBrick grid, int gridWidth,
+	int gridHeight, Player const *players, int nbPlayers);
+void stopClient(NetClient *client);
+unsigned int clientKeys(unsigned int actions);
+void sendInput(NetClient *client, unsigned int keys);
+void receiveSnapshot(NetClient *client, unsigned char *data, int length);
+void expandNetState(NetClient *client);
+void extrapolateBalls(NetClient *client, long elapsed);
+RenderSnapshot const *updateClient(NetClient *client, unsigned int keys);
+
+/* ----------( rollback.c )---------- */
+
+void openRollback(Uint16 localPort, Uint32 host, Uint16 remotePort, unsigned int seats);
+void closeRollback();
+bool rollbackActive();
+void resetRollback(int nbPlayers, int nbBalls);
+void receiveRemoteInputs();
+bool rollbackHash(long tick, Uint64 *hash);
+void checkPeerHash();
+void sendLocalInputs();
+void resimulate(long from, long to);
+bool advanceRollback(unsigned int actions);
+long rollbackConfirmedTick();
+MatchState const *rollbackState(long tick);
+void printRollbackStats();
+
+/* ----------( rewind.c )---------- */
+
+void captureRewindImage(unsigned char *output);
+void applyRewindImage(unsigned char const *input, long tick);
+int encodeRewindDelta(unsigned char const *a, unsigned char const *b);
+void applyRewindDelta(RewindFrame const *frame, unsigned char *output);
+void decodeRewindFrame(unsigned long index, unsigned char *output);
+void resetRewind(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls);
+bool rewindActive();
+void dropRewindSegment();
+void pushRewind(long tick);
+bool stepRewind(long *tick);
+void rewindUsage(double *seconds, unsigned long *bytes);
+
+/* ----------( workers.c )---------- */
+
+void runChunks();
+int workerThread(void *data);
+void startWorkers(int nbThreads);
+void stopWorkers();
+int workersCount();
+void runWorkers(WorkerJob job, void *data, int nbItems, int chunkSize);
+
+/* ------------( input.c )------------ */
+
+/* INPUT QUEUE */
+int inputFilter(SDL_Event const *event);
+void initInput();
+void openInputQueue();
+void closeInputQueue();
+bool popInput(Uint32 until, InputEvent *event);
+
+/* LATENCY */
+void recordInputLatency(Uint32 latency);
+void resetInputLatency();
+void printInputLatency();
+
+/* ---------( resolution.c )--------- */
+void initResolution(int refreshRate);
+void setResolutionLevel(int level);
+float resolutionScale(unsigned long *changes);
+void beginScaledFrame();
+void adaptResolution(unsigned long frameTime);
+void endScaledFrame();
+void freeResolution();
+
+/* ----------( headless.c )---------- */
+bool openHeadlessDisplay();
+bool initHeadless(int width, int height);
+void readHeadlessFrame(GLubyte *pixels);
+void quitHeadless();
+
+/* ----------( capture.c )---------- */
+
+/* WRITER */
+void writeCaptureFrame(GLubyte const *rgba, int repeats);
+void drainCapture();
+int captureWriterThread(void *data);
+
+/* CAPTURE */
+bool startCapture(char const *path, int width, int height, int fps);
+void queueCaptureFrame(GLubyte const *rgba, int repeats);
+void collectCaptureFrame(int index);
+int captureRepeatCount(long tick);
+void captureFrame(long tick);
+void stopCapture();
+
+/* ----------( profiler.c )---------- */
+
+#ifdef PROFILER
+void profilerDrainCSV();
+int profilerCSVThread(void *data);
+void profilerInit();
+void profilerQuit();
+void profilerBegin(enum profilerPhase phase);
+void profilerEnd(enum profilerPhase phase);
+void profilerEndFrame();
+void profilerToggleOverlay();
+int compareDurations(void const *a, void const *b);
+bool profilerStats(enum profilerPhase phase, PhaseStats *stats);
+void profilerDrawOverlay();
+#endif
+
 /* ----------( gameplay.c )---------- */
 
 /* INITIALISATON */
@@ -316,7 +1245,17 @@ void moveBar (Bar *bar, enum direction dir);
 void handleGladOS(Bar *bar, Ball const *balls, int nbBalls);
 int indesirableNumberOne(Ball const *ball);
 void hitBrick (Brick *brick, Ball *ball);
-void ballOutOfBounds(Ball *ball, enum direction dir);
+int ballOutOfBounds(Ball *ball, enum direction dir);
+void loseLives(int fallen);
+void collideBall(GridBrick grid, Ball *ball, int gridWidth, int gridHeight, int nbPlayers);
+void detectBallHits(void *data, int first, int last);
+void resolveBallHits(CollisionJob const *job, int nbBalls);
+void collideBalls(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls);
+void moveBalls(int nbBalls);
+void initBrickMotions();
+void moveBricks(GridBrick grid, int gridWidth, int gridHeight, long ticks);
+unsigned int keyAction(SDLKey key);
+void applyPlayersActions(unsigned int actions, unsigned int gladOSSeats, int nbPlayers, int nbBalls);
 
 /* COLORS */
 int defineBrickColor(Brick br);
@@ -0,0 +1,189 @@
+/**
+ * @file		headless.c
+ *       		headless functions library. Create an OpenGL context without any window (EGL, Mesa
+ * 			    surfaceless platform when available, llvmpipe on CPU-only servers) so the usual
+ * 			    drawing functions render into an offscreen buffer, at full speed and without vsync.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define GL_GLEXT_PROTOTYPES
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+#include <GL/glext.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static EGLDisplay headlessDisplay = EGL_NO_DISPLAY;
+static EGLContext headlessContext = EGL_NO_CONTEXT;
+static EGLSurface headlessSurface = EGL_NO_SURFACE;
+static RenderTarget headlessTarget;
+static int headlessWidth, headlessHeight;
+
+/*/////////////////////////////////////////
+ //					HEADLESS FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Open the EGL display : the Mesa surfaceless platform if the client supports it
+ * (no X server, no DRM device needed), the default display otherwise.
+ * @return	bool	false if no display can be initialised
+ */
+bool openHeadlessDisplay() {
+	PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay;
+	char const *extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+	EGLDisplay display = EGL_NO_DISPLAY;
+
+	if (extensions != NULL && strstr(extensions, "EGL_MESA_platform_surfaceless") != NULL) {
+		getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+		if (getPlatformDisplay != NULL) {
+			display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+		}
+	}
+	if (display == EGL_NO_DISPLAY) {
+		display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	}
+	if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL)) {
+		return false;
+	}
+	headlessDisplay = display;
+	return true;
+}
+
+/**
+ * Create a windowless OpenGL (compatibility profile) context and make it current.
+ * The frame goes into a pbuffer, or into a render target when the driver only
+ * supports surfaceless contexts. The logical screen (SCREEN_WIDTH x SCREEN_HEIGHT)
+ * is mapped on the whole frame, so any output size can be used.
+ * @param		int		width		frame width in pixels
+ * @param		int		height	frame height in pixels
+ * @return	bool					false if no headless context can be created
+ */
+bool initHeadless(int width, int height) {
+	EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+		EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_ALPHA_SIZE, 8,
+		EGL_NONE
+	};
+	EGLint surfaceAttributes[] = {EGL_WIDTH, 0, EGL_HEIGHT, 0, EGL_NONE};
+	EGLConfig config;
+	EGLint nbConfigs;
+
+	headlessWidth = width;
+	headlessHeight = height;
+	if (!openHeadlessDisplay()) {
+		printf("ERROR : No EGL display for headless rendering.\n");
+		return false;
+	}
+	if (!eglBindAPI(EGL_OPENGL_API)) {
+		printf("ERROR : This EGL doesn't support desktop OpenGL.\n");
+		quitHeadless();
+		return false;
+	}
+
+	/* pbuffer if possible, any OpenGL config otherwise (surfaceless + render target) */
+	if (!eglChooseConfig(headlessDisplay, configAttributes, &config, 1, &nbConfigs) || nbConfigs < 1) {
+		configAttributes[1] = 0;
+		if (!eglChooseConfig(headlessDisplay, configAttributes, &config, 1, &nbConfigs) || nbConfigs < 1) {
+			printf("ERROR : No EGL config for headless rendering.\n");
+			quitHeadless();
+			return false;
+		}
+	}
+	if ((headlessContext = eglCreateContext(headlessDisplay, config, EGL_NO_CONTEXT, NULL)) == EGL_NO_CONTEXT) {
+		printf("ERROR : Impossible to create the headless context.\n");
+		quitHeadless();
+		return false;
+	}
+
+	surfaceAttributes[1] = width;
+	surfaceAttributes[3] = height;
+	if (configAttributes[1]) {
+		headlessSurface = eglCreatePbufferSurface(headlessDisplay, config, surfaceAttributes);
+	}
+	if (!eglMakeCurrent(headlessDisplay, headlessSurface, headlessSurface, headlessContext)) {
+		printf("ERROR : Impossible to use the headless context.\n");
+		quitHeadless();
+		return false;
+	}
+	if (headlessSurface == EGL_NO_SURFACE) {
+		if (!initRenderTarget(&headlessTarget, width, height)) {
+			printf("ERROR : Surfaceless context without framebuffer objects.\n");
+			quitHeadless();
+			return false;
+		}
+		glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, headlessTarget.fbo);
+	}
+
+	glViewport(0, 0, width, height);
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	gluOrtho2D(0, SCREEN_WIDTH, SCREEN_HEIGHT, 0);
+	glMatrixMode(GL_MODELVIEW);
+	glClear(GL_COLOR_BUFFER_BIT);
+	return true;
+}
+
+/**
+ * Read the current frame back, as top-down RGB rows (width * height * 3 bytes).
+ * Waits for the frame to be rendered.
+ * @param	GLubyte*	pixels	the frame pixels
+ */
+void readHeadlessFrame(GLubyte *pixels) {
+	GLubyte *row = malloc(headlessWidth * 3);
+	int i;
+
+	if (row == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, headlessWidth, headlessHeight, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+
+	/* glReadPixels is bottom-up */
+	for (i = 0; i < headlessHeight / 2; ++i) {
+		memcpy(row, &pixels[i * headlessWidth * 3], headlessWidth * 3);
+		memcpy(&pixels[i * headlessWidth * 3], &pixels[(headlessHeight - 1 - i) * headlessWidth * 3], headlessWidth * 3);
+		memcpy(&pixels[(headlessHeight - 1 - i) * headlessWidth * 3], row, headlessWidth * 3);
+	}
+	free(row);
+}
+
+/**
+ * Destroy the headless context.
+ */
+void quitHeadless() {
+	if (headlessDisplay == EGL_NO_DISPLAY) {
+		return;
+	}
+	if (headlessContext != EGL_NO_CONTEXT) {
+		if (headlessTarget.fbo) {
+			glBindFramebufferEXT(GL_FRAMEBUFFER_EXT, 0);
+			freeRenderTarget(&headlessTarget);
+		}
+		eglMakeCurrent(headlessDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+		eglDestroyContext(headlessDisplay, headlessContext);
+	}
+	if (headlessSurface != EGL_NO_SURFACE) {
+		eglDestroySurface(headlessDisplay, headlessSurface);
+	}
+	eglTerminate(headlessDisplay);
+	headlessDisplay = EGL_NO_DISPLAY;
+	headlessContext = EGL_NO_CONTEXT;
+	headlessSurface = EGL_NO_SURFACE;
+}
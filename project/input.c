@@ -0,0 +1,165 @@
+/**
+ * @file		input.c
+ *       		input functions library. Timestamp the bar keys transitions as soon as SDL pumps them
+ * 			    and queue them for the simulation thread, which applies each one at the tick it
+ * 			    happened in. Keep an input-to-simulation latency histogram.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static InputEvent inputQueue[INPUT_QUEUE_SIZE];
+static unsigned long inputHead = 0;
+static unsigned long inputTail = 0;
+static int inputOpen = 0;
+static unsigned long inputDropped = 0;
+
+static unsigned long latencyHistogram[INPUT_LATENCY_BINS];
+
+/*/////////////////////////////////////////
+ //					INPUT QUEUE FUNCTIONS				//
+/////////////////////////////////////////*/
+
+/**
+ * SDL event filter : called as soon as an event is pumped (by the SDL event thread when
+ * available), before it reaches the event queue of the main loop. Single producer of the queue.
+ * @param		SDL_Event const*	event	the pumped event
+ * @return	int										1, the event is always kept for the main loop
+ */
+int inputFilter(SDL_Event const *event) {
+	unsigned long head;
+	unsigned int action;
+
+	if ((event->type != SDL_KEYDOWN && event->type != SDL_KEYUP)
+		|| !__atomic_load_n(&inputOpen, __ATOMIC_ACQUIRE)) {
+		return 1;
+	}
+	if ((action = keyAction(event->key.keysym.sym)) == 0) {
+		return 1;
+	}
+
+	head = inputHead;
+	if (head - __atomic_load_n(&inputTail, __ATOMIC_ACQUIRE) >= INPUT_QUEUE_SIZE) {
+		__atomic_fetch_add(&inputDropped, 1, __ATOMIC_RELAXED);
+		return 1;
+	}
+	inputQueue[head & (INPUT_QUEUE_SIZE - 1)].time = SDL_GetTicks();
+	inputQueue[head & (INPUT_QUEUE_SIZE - 1)].action = action;
+	inputQueue[head & (INPUT_QUEUE_SIZE - 1)].pressed = event->type == SDL_KEYDOWN;
+	__atomic_store_n(&inputHead, head + 1, __ATOMIC_RELEASE);
+	return 1;
+}
+
+/**
+ * Install the input filter. Must be called after SDL_Init.
+ */
+void initInput() {
+	SDL_SetEventFilter(inputFilter);
+}
+
+/**
+ * Start queueing the bar keys for a new match, older transitions are discarded.
+ * Must be called before the simulation thread starts.
+ */
+void openInputQueue() {
+	inputTail = __atomic_load_n(&inputHead, __ATOMIC_ACQUIRE);
+	inputDropped = 0;
+	__atomic_store_n(&inputOpen, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Stop queueing the bar keys (the match is over).
+ */
+void closeInputQueue() {
+	__atomic_store_n(&inputOpen, 0, __ATOMIC_RELEASE);
+}
+
+/**
+ * Take the oldest queued transition if it happened before a given time.
+ * Single consumer of the queue : only the simulation thread moves the tail.
+ * @param		Uint32				until	time of the current tick (SDL_GetTicks)
+ * @param		InputEvent*		event	the transition taken
+ * @return	bool								false if no transition happened before until
+ */
+bool popInput(Uint32 until, InputEvent *event) {
+	unsigned long tail = inputTail;
+
+	if (tail == __atomic_load_n(&inputHead, __ATOMIC_ACQUIRE)) {
+		return false;
+	}
+	*event = inputQueue[tail & (INPUT_QUEUE_SIZE - 1)];
+	if ((Sint32)(event->time - until) > 0) {
+		return false;
+	}
+	__atomic_store_n(&inputTail, tail + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+/*/////////////////////////////////////////
+ //					LATENCY FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Count one transition in the latency histogram (1 ms bins, the last one is open).
+ * @param	Uint32	latency	time between the key transition and its tick, in ms
+ */
+void recordInputLatency(Uint32 latency) {
+	++latencyHistogram[latency < INPUT_LATENCY_BINS ? latency : INPUT_LATENCY_BINS - 1];
+}
+
+/**
+ * Empty the latency histogram.
+ */
+void resetInputLatency() {
+	memset(latencyHistogram, 0, sizeof(latencyHistogram));
+}
+
+/**
+ * Print the latency histogram of the match, with its median and 99th percentile.
+ * Only called once the simulation thread is stopped.
+ */
+void printInputLatency() {
+	unsigned long total = 0, count = 0, underTick = 0;
+	int i, p50 = -1, p99 = -1;
+
+	for (i = 0; i < INPUT_LATENCY_BINS; ++i) {
+		total += latencyHistogram[i];
+	}
+	if (!total) {
+		return;
+	}
+	for (i = 0; i < INPUT_LATENCY_BINS; ++i) {
+		count += latencyHistogram[i];
+		if (i < SIM_TICK_DURATION) {
+			underTick = count;
+		}
+		if (p50 == -1 && count * 2 >= total) {
+			p50 = i;
+		}
+		if (p99 == -1 && count * 100 >= total * 99) {
+			p99 = i;
+		}
+	}
+
+	printf("Input latency : %lu transitions, p50 %d ms, p99 %d ms, %.1f%% under one tick, %lu dropped\n",
+		total, p50, p99, (100.0 * underTick) / total, inputDropped);
+	for (i = 0; i < INPUT_LATENCY_BINS; ++i) {
+		if (latencyHistogram[i]) {
+			printf("  %2d%s ms : %lu\n", i, i == INPUT_LATENCY_BINS - 1 ? "+" : " ", latencyHistogram[i]);
+		}
+	}
+}
@@ -17,18 +17,9 @@
 #include <SDL/SDL_image.h>
 #include <GL/gl.h>
 #include <GL/glu.h>
-#include <GL/glut.h>
 
 #include "headers.h"
 
-/*/////////////////////////////////////////
- //					GLOBAL VARIABLES DEF				//
-/////////////////////////////////////////*/
-
-char *playersNames[4];
-GLuint texturesBuffer[TEXTURE_NB];
-Color3f themeColor;
-
 /*/////////////////////////////////////////
  //					MAIN SDL FUNCTIONS					//
 /////////////////////////////////////////*/
@@ -56,6 +47,38 @@ void setVideoMode() {
 	SDL_GL_SwapBuffers();
 }
 
+/**
+ * Push a user event to wake up a waitEventTimeout call.
+ * @param		Uint32	interval	the timer interval
+ * @param		void*		param			unused
+ * @return	Uint32						0 to stop the timer
+ */
+Uint32 wakeUp(Uint32 interval, void *param) {
+	SDL_Event event;
+	event.type = SDL_USEREVENT;
+	event.user.code = 0;
+	event.user.data1 = NULL;
+	event.user.data2 = NULL;
+	SDL_PushEvent(&event);
+	return 0;
+}
+
+/**
+ * Block until an event arrives or the timeout expires (SDL 1.2 has no SDL_WaitEventTimeout).
+ * A timeout is reported as an SDL_USEREVENT.
+ * @param		SDL_Event*	event		the event received
+ * @param		Uint32			timeout	maximum waiting time in milliseconds
+ * @return	int									1 if an event was received, 0 on error
+ */
+int waitEventTimeout(SDL_Event *event, Uint32 timeout) {
+	SDL_TimerID timer = SDL_AddTimer(timeout, wakeUp, NULL);
+	int result = SDL_WaitEvent(event);
+	if (timer != NULL) {
+		SDL_RemoveTimer(timer);
+	}
+	return result;
+}
+
 /**
  * Instanciate all players names based on theyre number and the program params (argv, argc)
  * @param	int			argc	number of paramaters of main
@@ -108,11 +131,20 @@ int main (int argc, char** argv) {
 	 //				VARIABLES DEFINITION					//
 	/////////////////////////////////////////*/
 
-	Uint8 * keyState = SDL_GetKeyState(NULL);
 	int gridWidth = 0, gridHeight = 0;
 	int *brickTypes;
 	bool gladOS = false;
-	glutInit(&argc, argv);
+	FILE *recordFile = NULL;
+	NetClient *client = NULL;
+	Uint32 serverHost = 0;
+	Uint16 serverPort = 0;
+	Uint32 peerHost = 0;
+	Uint16 peerPort = 0;
+	int seat = 1;
+	unsigned int seats = 1;
+	char const *digit;
+	double rewindSeconds;
+	unsigned long rewindBytes;
 	initColor3f(&themeColor, 255, 139, 0);
 	instanciatePlayerNames(argc, argv);
 	brickTypes = readConfigFile(argv[1], &gridWidth, &gridHeight);
@@ -121,12 +153,32 @@ int main (int argc, char** argv) {
 	 //			INITIATE SDL OPENGL CONTEXT			//
 	/////////////////////////////////////////*/
 
-	if (-1 == SDL_Init(SDL_INIT_VIDEO)) {
+	/* With the event thread the bar keys are timestamped as soon as they arrive,
+	 * not when the main loop polls. Not available everywhere. */
+	if (-1 == SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER | SDL_INIT_EVENTTHREAD)
+		&& -1 == SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER)) {
 		fprintf(stderr, "Impossible d'initialiser la SDL. Fin du programme.\n");
 		return EXIT_FAILURE;
 	}
 	setVideoMode(SCREEN_WIDTH);
 	SDL_WM_SetCaption("KassPong", NULL);
+	initInput();
+
+	/* KASSPONG_RENDERER=null draws nothing, =record counts the draw calls
+	 * (and writes them into KASSPONG_RECORD=file) */
+	if (getenv("KASSPONG_RENDERER") != NULL) {
+		if (findRenderer(getenv("KASSPONG_RENDERER")) == NULL) {
+			printf("ERROR : Unknown renderer '%s'.\n", getenv("KASSPONG_RENDERER"));
+		} else {
+			setRenderer(findRenderer(getenv("KASSPONG_RENDERER")));
+		}
+	}
+	if (renderer == &recordRenderer) {
+		if (getenv("KASSPONG_RECORD") != NULL && (recordFile = fopen(getenv("KASSPONG_RECORD"), "w")) == NULL) {
+			printf("ERROR : Impossible to open the record file '%s'.\n", getenv("KASSPONG_RECORD"));
+		}
+		startRecording(recordFile);
+	}
 
 	/*/////////////////////////////////////////
 	 //						INITIALISATONS						//
@@ -136,15 +188,77 @@ int main (int argc, char** argv) {
 	initMenu(menu);
 	GridBrick grid = initGrid(gridWidth, gridHeight, brickTypes);
 	initBrickCoordinates(grid, gridWidth, gridHeight);
+	initBallMesh();
+	initGlyphAtlas();
+	/* KASSPONG_REFRESH=50 gives the refresh rate of the display (60 Hz by default) : the
+	 * dynamic resolution keeps the frames within its period */
+	initResolution(getenv("KASSPONG_REFRESH") != NULL ? atoi(getenv("KASSPONG_REFRESH")) : RESOLUTION_REFRESH);
 	glGenTextures(TEXTURE_NB, texturesBuffer);
 	loadTextures("img/THEME1/");
+#ifdef PROFILER
+	profilerInit();
+#endif
+	/* KASSPONG_SHM=/kasspong exports the matches to the bots (shared.c) */
+	if (getenv("KASSPONG_SHM") != NULL) {
+		openSharedState(getenv("KASSPONG_SHM"));
+	}
+	/* KASSPONG_SPECTATE=/kasspong_spectate shows the matches on the screens of kasspong_spectator (spectator.c) */
+	if (getenv("KASSPONG_SPECTATE") != NULL) {
+		openSpectatorFeed(getenv("KASSPONG_SPECTATE"));
+	}
+	/* KASSPONG_THREADS=4 collides the balls on 4 threads once there are enough of them */
+	if (getenv("KASSPONG_THREADS") != NULL) {
+		startWorkers(atoi(getenv("KASSPONG_THREADS")));
+	}
+	/* KASSPONG_NET_LOSS=5 KASSPONG_NET_LATENCY=50 lose 5% of the packets sent and delay the others (network.c) */
+	setNetworkShim(getenv("KASSPONG_NET_LOSS") != NULL ? atoi(getenv("KASSPONG_NET_LOSS")) : 0,
+		getenv("KASSPONG_NET_LATENCY") != NULL ? atoi(getenv("KASSPONG_NET_LATENCY")) : 0);
+	/* KASSPONG_SERVER=27500 plays the matches for the clients of other machines (server.c),
+	 * KASSPONG_CONNECT=host:27500 KASSPONG_SEAT=2 only draws the matches of a server (client.c) */
+	if (getenv("KASSPONG_SERVER") != NULL) {
+		openServer(atoi(getenv("KASSPONG_SERVER")));
+	}
+	if (getenv("KASSPONG_CONNECT") != NULL) {
+		if (!resolveAddress(getenv("KASSPONG_CONNECT"), &serverHost, &serverPort)) {
+			printf("ERROR : Unknown server '%s'.\n", getenv("KASSPONG_CONNECT"));
+		} else if ((client = malloc(sizeof(NetClient))) == NULL) {
+			exit(MALLOC_ERROR);
+		}
+		if (getenv("KASSPONG_SEAT") != NULL && atoi(getenv("KASSPONG_SEAT")) >= 1 && atoi(getenv("KASSPONG_SEAT")) <= 4) {
+			seat = atoi(getenv("KASSPONG_SEAT")) - 1;
+		}
+	}
+	/* KASSPONG_ROLLBACK_PEER=host:27500 KASSPONG_ROLLBACK_PORT=27500 KASSPONG_ROLLBACK_SEATS=13 plays
+	 * seats 1 and 3 here and the others on the peer, without waiting for its keys (rollback.c) */
+	if (getenv("KASSPONG_ROLLBACK_PEER") != NULL) {
+		if (getenv("KASSPONG_ROLLBACK_SEATS") != NULL) {
+			seats = 0;
+			for (digit = getenv("KASSPONG_ROLLBACK_SEATS"); *digit; ++digit) {
+				if (*digit >= '1' && *digit <= '4') {
+					seats |= 1u << (*digit - '1');
+				}
+			}
+		}
+		if (!resolveAddress(getenv("KASSPONG_ROLLBACK_PEER"), &peerHost, &peerPort)) {
+			printf("ERROR : Unknown peer '%s'.\n", getenv("KASSPONG_ROLLBACK_PEER"));
+		} else {
+			openRollback(getenv("KASSPONG_ROLLBACK_PORT") != NULL ? atoi(getenv("KASSPONG_ROLLBACK_PORT")) : NET_DEFAULT_PORT,
+				peerHost, peerPort, seats);
+		}
+	}
+	/* KASSPONG_CAPTURE=match.y4m (or "|command") records every PLAYTIME frame */
+	if (getenv("KASSPONG_CAPTURE") != NULL) {
+		startCapture(getenv("KASSPONG_CAPTURE"), SCREEN_WIDTH, SCREEN_HEIGHT, CAPTURE_FPS);
+	}
 
 	/*/////////////////////////////////////////
 	 //				START OF INFINITE LOOP				//
 	/////////////////////////////////////////*/
 
-	int tmp, i, j, loop = true, nbPlayers = 0, nbBalls = 0;
-	int gameStep = INITIALISATON;
+	int tmp, i, loop = true, nbPlayers = 0, nbBalls = 0;
+	int gameStep = INITIALISATON, lastStep = INITIALISATON;
+	bool redraw = true;
+	RenderSnapshot const *snapshot;
 
 	while (loop) {
 
@@ -153,12 +267,33 @@ int main (int argc, char** argv) {
 		/////////////////////////////////////////*/
 
 		SDL_Event trigger;
+		int pending = 0;
+		/*----------( IDLE MODE )---------- */
+		/* Static screens wait for an event instead of spinning, and are only redrawn
+		 * on input, on a step change or when the animation timeout expires. */
+		if (gameStep != lastStep) {
+			lastStep = gameStep;
+			redraw = true;
+		}
+		if (!redraw && gameStep != PLAYTIME && gameStep != QUIT_PROGRAM) {
+			pending = waitEventTimeout(&trigger, IDLE_REDRAW_DELAY);
+		}
 		/*----------( STOP CONDITION )---------- */
-		while(SDL_PollEvent(&trigger)) {
+		PROFILE_BEGIN(PHASE_EVENTS);
+		while(pending || SDL_PollEvent(&trigger)) {
+			pending = 0;
+			if (trigger.type != SDL_MOUSEMOTION) {
+				redraw = true;
+			}
 			if (trigger.type == SDL_QUIT) {
 				loop = 0;
 				break;
 			}
+#ifdef PROFILER
+			if (trigger.type == SDL_KEYDOWN && trigger.key.keysym.sym == SDLK_F3) {
+				profilerToggleOverlay();
+			}
+#endif
 			/*----------( OTHER ACTIONS )---------- */
 			switch (gameStep) {
 				case INITIALISATON :
@@ -176,8 +311,30 @@ int main (int argc, char** argv) {
 					handleButton(&menu[3], trigger, &gameStep);
 					handleButton(&menu[4], trigger, &gameStep);
 					nbBalls = nbPlayers;
+					if (gameStep == PLAYTIME) {
+						resetHUDCaches();
+						resetParticles();
+						if (client != NULL) {
+							openInputQueue();
+							startClient(client, serverHost, serverPort, seat, grid, gridWidth, gridHeight, players, nbPlayers);
+						} else {
+							/* against GladOS, it plays the second seat */
+							startSimulation(grid, gridWidth, gridHeight, nbPlayers, nbBalls, gladOS ? 1u << 1 : 0);
+						}
+					}
 					break;
 				case PLAYTIME :
+					/* the server doesn't pause for a client */
+					if (trigger.type == SDL_KEYDOWN && trigger.key.keysym.sym == SDLK_p && client == NULL) {
+						gameStep = PAUSE;
+						setSimulationPaused(true);
+						setSimulationRewinding(false);
+					}
+					/* practice against GladOS : the match plays backwards while backspace is held */
+					if ((trigger.type == SDL_KEYDOWN || trigger.type == SDL_KEYUP)
+						&& trigger.key.keysym.sym == SDLK_BACKSPACE && client == NULL) {
+						setSimulationRewinding(trigger.type == SDL_KEYDOWN);
+					}
 					break;
 				case SCOREBOARD :
 					break;
@@ -185,112 +342,97 @@ int main (int argc, char** argv) {
 					loop = false;
 					break;
 				case PAUSE :
+					if (trigger.type == SDL_KEYDOWN && trigger.key.keysym.sym == SDLK_p) {
+						gameStep = PLAYTIME;
+						setSimulationPaused(false);
+					}
 					break;
 				default :
 					break;
 			}
 		}
+		PROFILE_END(PHASE_EVENTS);
 
 		/*/////////////////////////////////////////
-		 //			COLLISION / DISPLAY MANAGER			//
+		 //						DISPLAY MANAGER						//
 		/////////////////////////////////////////*/
 
-		glClear(GL_COLOR_BUFFER_BIT);
-		/* ----------( INITIALISATION PHASE )---------- */
-		if (gameStep == INITIALISATON) {
-			drawBackground(13);
-			drawMenu(menu);
-		}
-
-		/* -------------( PLAYTIME PHASE )------------ */
-		if (gameStep == PLAYTIME) {
-			drawBackground(4);
-			for (i = 0; i < nbBalls; ++i) {
-				collisionBallScreen(&balls[i], nbPlayers);
-				for (j = 0; j < nbPlayers; ++j) {
-					collisionBarBall(&(players[j].bar), &balls[i]);
-				}
-				collisionBallGrid(grid, &balls[i], gridWidth, gridHeight);
+		if (redraw || gameStep == PLAYTIME) {
+			PROFILE_BEGIN(PHASE_DRAW);
+			renderer->beginFrame();
+			/* ----------( INITIALISATION PHASE )---------- */
+			if (gameStep == INITIALISATON) {
+				drawBackground(13);
+				drawMenu(menu);
 			}
 
-			for (i = 0; i < nbBalls; ++i) {
-				if (!balls[i].respawnTimer) {
-					moveBall(&balls[i]);
-					drawBall(balls[i]);
-				} else {
-					--(balls[i].respawnTimer);
+			/* -------------( PLAYTIME PHASE )------------ */
+			/* The simulation runs on its own thread, only draw its latest snapshot */
+			if (gameStep == PLAYTIME) {
+				snapshot = client != NULL ? updateClient(client, clientKeys(collectActions(SDL_GetTicks(), true)))
+					: consumeSnapshot();
+				updateParticles(snapshot->tick);
+				/* the playfield follows the frame time budget, the HUDs stay sharp */
+				beginScaledFrame();
+				drawPlayfield((GridBrick)snapshot->rows, snapshot->gridWidth, snapshot->gridHeight,
+					snapshot->players, snapshot->nbPlayers, snapshot->balls, snapshot->nbBalls);
+				endScaledFrame();
+				drawHUDs(snapshot->players, snapshot->nbPlayers);
+#ifdef PROFILER
+				profilerDrawOverlay();
+#endif
+				captureFrame(snapshot->tick);
+
+				if (snapshot->over && client != NULL) {
+					/* the scoreboard shows the players of the menu */
+					for (i = 0; i < snapshot->nbPlayers; ++i) {
+						players[i].life = snapshot->players[i].life;
+						players[i].score = snapshot->players[i].score;
+					}
+					stopClient(client);
+					closeInputQueue();
 				}
-				if (!balls[i].bonusTimer) {
-					balls[i].speed.x = balls[i].speed.x < 0 ? - NORMAL : NORMAL;
-					balls[i].speed.y = balls[i].speed.y < 0 ? - NORMAL : NORMAL;
-				} else {
-					--(balls[i].bonusTimer);
+				if (snapshot->over) {
+					stopSimulation();
+					gameStep = SCOREBOARD;
+					printf("HUD rebuilds this match : %d\n", hudRebuilds);
+					printInputLatency();
+					printRollbackStats();
+					if (rewindActive()) {
+						rewindUsage(&rewindSeconds, &rewindBytes);
+						printf("Rewind buffer : %.1f s kept in %lu KB\n", rewindSeconds, rewindBytes / 1024);
+					}
 				}
 			}
-
-			for (j = 0; j < nbPlayers; ++j) {
-				drawHUD(&players[j], nbPlayers);
-				drawBar(players[j].bar);
+			/* -------------( SCOREBOARD PHASE )------------ */
+			if (gameStep == SCOREBOARD) {
+				drawBackground(14);
+				printVictoryScreen(players, nbPlayers, gladOS);
 			}
-			drawGrid(grid, gridWidth, gridHeight);
 
-			for (i = 0; i < nbPlayers; ++i) {
-				if (players[i].life <= 0) {
-					++gameStep;
-				}
+			/* -------------( PAUSE PHASE )------------ */
+			if (gameStep == PAUSE) {
+				drawBackground(16);
 			}
-		}
-		/* -------------( SCOREBOARD PHASE )------------ */
-		if (gameStep == SCOREBOARD) {
-			drawBackground(14);
-			printVictoryScreen(players, nbPlayers, gladOS);
-		}
+			renderer->endFrame();
+			PROFILE_END(PHASE_DRAW);
 
-		/* -------------( PAUSE PHASE )------------ */
-		if (gameStep == PAUSE) {
-			drawBackground(16);
+			PROFILE_BEGIN(PHASE_SWAP);
+			SDL_GL_SwapBuffers();
+			PROFILE_END(PHASE_SWAP);
+			redraw = false;
 		}
 
-		SDL_GL_SwapBuffers();
-
 		/*/////////////////////////////////////////
 		 //					KEYBOARD MANAGER						//
 		/////////////////////////////////////////*/
 
-		/* -------------( PAUSE ACTIONS )------------ */
-		if (trigger.type == SDL_KEYDOWN && trigger.key.keysym.sym == SDLK_p && gameStep == PLAYTIME) {
-			gameStep = PAUSE;
-		} else if (keyState[SDLK_p] && trigger.type == SDL_KEYDOWN && gameStep == PAUSE) {
-			gameStep = PLAYTIME;
-		}
-
 		/* -------------( PLAYTIME ACTIONS )------------ */
+		/* The bar keys go straight to the simulation (input.c) */
 		if (gameStep == PLAYTIME) {
-			keyState = SDL_GetKeyState(NULL);
-
-			/* BASIC ACTIONS */
-			if (keyState[SDLK_a]) moveBar(&(players[0].bar), LEFT);
-			if (keyState[SDLK_z]) moveBar(&(players[0].bar), RIGHT);
-
-			/* GladOS ACTIONS */
-			if (!gladOS) {
-				if (keyState[SDLK_LEFT]) moveBar(&(players[1].bar), LEFT);
-				if (keyState[SDLK_RIGHT]) moveBar(&(players[1].bar), RIGHT);
-			} else {
-				players[1].name = "GladOS";
-				handleGladOS(&(players[1].bar), balls, nbPlayers);
-			}
-
-			/* 4PLAYERS MODE ACTIONS */
-			if (nbPlayers > 2) {
-				if (keyState[SDLK_u]) moveBar(&(players[2].bar), TOP);
-				if (keyState[SDLK_n]) moveBar(&(players[2].bar), BOTTOM);
-
-				if (keyState[SDLK_KP9]) moveBar(&(players[3].bar), TOP);
-				if (keyState[SDLK_KP3]) moveBar(&(players[3].bar), BOTTOM);
-			}
 			SDL_Delay(5);
 		}
+		PROFILE_END_FRAME();
 
 		/*/////////////////////////////////////////
 		 //				END OF INFINITE LOOP					//
@@ -301,6 +443,19 @@ int main (int argc, char** argv) {
 	 //						FREE MEMORY								//
 	/////////////////////////////////////////*/
 
+	stopSimulation();
+	stopWorkers();
+	closeSharedState();
+	closeSpectatorFeed();
+	closeServer();
+	closeRollback();
+	if (client != NULL) {
+		if (gameStep == PLAYTIME) {
+			stopClient(client);
+		}
+		free(client);
+	}
+
 	if (menu != NULL) {
 		free(menu);
 	}
@@ -325,7 +480,20 @@ int main (int argc, char** argv) {
 	/*/////////////////////////////////////////
 	 //					FREE SDL AND QUIT						//
 	/////////////////////////////////////////*/
+#ifdef PROFILER
+	profilerQuit();
+#endif
+	stopCapture();
+	freeResolution();
+	freeHUDCaches();
+	freeGlyphAtlas();
 	glDeleteTextures(TEXTURE_NB, texturesBuffer);
+	if (renderer == &recordRenderer) {
+		printRecordingStats(stdout);
+		if (recordFile != NULL) {
+			fclose(recordFile);
+		}
+	}
 	SDL_Quit();
 
 	return EXIT_SUCCESS;
@@ -70,33 +70,20 @@ void initMenu(Button *menu) {
  * @param	Button const*	menu	array of buttons (const)
  */
 void drawMenu(Button const *menu) {
+	Point2D corners[4];
 	int i;
 	for (i = 0; i < NB_BUTTON_MAIN_MENU; ++i) {
-		glEnable(GL_TEXTURE_2D);
-		glColor3f(255, 255, 255);
 		if (i == 3 && menu[i].param == THEME2) {
-			glBindTexture(GL_TEXTURE_2D, texturesBuffer[12]);
+			renderer->bindTexture(12);
 		} else {
-			glBindTexture(GL_TEXTURE_2D, texturesBuffer[7 + i]);
+			renderer->bindTexture(7 + i);
 		}
-		/*glColor3f(menu[i].color.r, menu[i].color.g, menu[i].color.b);*/
-		glBegin(GL_POLYGON);
-			glTexCoord2f(0.0f, 0.0f);
-			glVertex2f(menu[i].origin.x, menu[i].origin.y);
-			glTexCoord2f(1.0f, 0.0f);
-			glVertex2f((menu[i].origin.x + BUTTON_WIDTH), menu[i].origin.y);
-			glTexCoord2f(1.0f, 1.0f);
-			glVertex2f((menu[i].origin.x + BUTTON_WIDTH), (menu[i].origin.y + BUTTON_HEIGHT));
-			glTexCoord2f(0.0f, 1.0f);
-			glVertex2f(menu[i].origin.x, (menu[i].origin.y + BUTTON_HEIGHT));
-		glEnd();
-
-		if (i == 3 && menu[i].param == THEME2) {
-			glBindTexture(GL_TEXTURE_2D, texturesBuffer[12]);
-		} else {
-			glBindTexture(GL_TEXTURE_2D, texturesBuffer[7 + i]);
-		}
-		glDisable(GL_TEXTURE_2D);
+		initPoint2D(&corners[0], menu[i].origin.x, menu[i].origin.y);
+		initPoint2D(&corners[1], (menu[i].origin.x + BUTTON_WIDTH), menu[i].origin.y);
+		initPoint2D(&corners[2], (menu[i].origin.x + BUTTON_WIDTH), (menu[i].origin.y + BUTTON_HEIGHT));
+		initPoint2D(&corners[3], menu[i].origin.x, (menu[i].origin.y + BUTTON_HEIGHT));
+		renderer->drawQuad(corners, quadTexCoords, menu[i].color);
+		renderer->bindTexture(RENDER_NO_TEXTURE);
 	}
 }
 
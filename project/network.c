@@ -0,0 +1,591 @@
+/**
+ * @file		network.c
+ *       		network functions library. The UDP sockets of the server and of the clients, with a
+ * 			    shim that loses and delays the packets sent to test on loopback
+ * 			    (KASSPONG_NET_LOSS=percent, KASSPONG_NET_LATENCY=ms each way), the bit packing of
+ * 			    the messages and the delta compression of the match state :
+ * 			    - a NetState is the match quantized to what the clients draw, 1 / NET_SCALE pixel.
+ * 			    - each field is written against the same field of a baseline state the client
+ * 			      already has : 1 bit if it didn't change, a few bits if it changed a little, the
+ * 			      whole value otherwise. The balls are predicted from the speed of the baseline,
+ * 			      they only cost bits when they bounce. A zeroed baseline gives a full state.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static int shimLoss = 0;
+static int shimLatency = 0;
+
+/*/////////////////////////////////////////
+ //					SOCKET FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Lose and delay the packets of the sockets opened afterwards, to test on loopback.
+ * @param	int	loss		the percentage of packets lost
+ * @param	int	latency	the delay of every packet sent, in ms
+ */
+void setNetworkShim(int loss, int latency) {
+	shimLoss = loss < 0 ? 0 : (loss > 100 ? 100 : loss);
+	shimLatency = latency < 0 ? 0 : latency;
+}
+
+/**
+ * Find the IPv4 address of "host:port".
+ * @param		char const*	name	the host name or address, a colon then the port
+ * @param		Uint32*			host	the address, network byte order
+ * @param		Uint16*			port	the port, network byte order
+ * @return	bool							false if the name is not an address
+ */
+bool resolveAddress(char const *name, Uint32 *host, Uint16 *port) {
+	struct addrinfo hints, *found;
+	char hostName[256];
+	char const *colon = strrchr(name, ':');
+
+	if (colon == NULL || colon == name || colon - name >= (int)sizeof(hostName) || atoi(colon + 1) <= 0) {
+		return false;
+	}
+	memcpy(hostName, name, colon - name);
+	hostName[colon - name] = '\0';
+	memset(&hints, 0, sizeof(hints));
+	hints.ai_family = AF_INET;
+	hints.ai_socktype = SOCK_DGRAM;
+	if (getaddrinfo(hostName, NULL, &hints, &found) != 0) {
+		return false;
+	}
+	*host = ((struct sockaddr_in *)found->ai_addr)->sin_addr.s_addr;
+	*port = htons(atoi(colon + 1));
+	freeaddrinfo(found);
+	return true;
+}
+
+/**
+ * Open a non blocking UDP socket.
+ * @param		NetSocket*	sock	the socket to open
+ * @param		Uint16			port	the port to listen to, 0 for any
+ * @return	bool							false if the socket can't be opened
+ */
+bool openSocket(NetSocket *sock, Uint16 port) {
+	struct sockaddr_in address;
+
+	memset(sock, 0, sizeof(NetSocket));
+	sock->loss = shimLoss;
+	sock->latency = shimLatency;
+	sock->seed = 0x9E3779B9U ^ port;
+	if ((sock->fd = socket(AF_INET, SOCK_DGRAM, 0)) == -1) {
+		printf("ERROR : Impossible to open a UDP socket.\n");
+		return false;
+	}
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(port);
+	if (bind(sock->fd, (struct sockaddr *)&address, sizeof(address)) == -1
+		|| fcntl(sock->fd, F_SETFL, fcntl(sock->fd, F_GETFL) | O_NONBLOCK) == -1) {
+		printf("ERROR : Impossible to listen to the UDP port %d.\n", port);
+		close(sock->fd);
+		sock->fd = -1;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Close a socket, the delayed packets are lost.
+ * @param	NetSocket*	sock	the socket to close
+ */
+void closeSocket(NetSocket *sock) {
+	if (sock->fd != -1) {
+		close(sock->fd);
+	}
+	sock->fd = -1;
+	sock->delayedCount = 0;
+}
+
+/**
+ * Draw the shim of a socket (xorshift), the game doesn't need rand() to be left alone
+ * but the matches must not depend on the network.
+ * @param		NetSocket*	sock	the socket
+ * @return	Uint32						a random number
+ */
+Uint32 shimRandom(NetSocket *sock) {
+	sock->seed ^= sock->seed << 13;
+	sock->seed ^= sock->seed >> 17;
+	sock->seed ^= sock->seed << 5;
+	return sock->seed;
+}
+
+/**
+ * Send a packet, through the shim : it may be lost, or sent later by flushPackets.
+ * @param	NetSocket*						sock		the socket
+ * @param	Uint32								host		the address, network byte order
+ * @param	Uint16								port		the port, network byte order
+ * @param	unsigned char const*	data		the packet
+ * @param	int										length	the packet size, not more than NET_PACKET_SIZE
+ */
+void sendPacket(NetSocket *sock, Uint32 host, Uint16 port, unsigned char const *data, int length) {
+	struct sockaddr_in address;
+	DelayedPacket *packet;
+
+	sock->bytesSent += length;
+	++sock->packetsSent;
+	if (sock->loss && (int)(shimRandom(sock) % 100) < sock->loss) {
+		++sock->packetsDropped;
+		return;
+	}
+	if (sock->latency) {
+		if (sock->delayedCount == NET_SHIM_QUEUE) {
+			++sock->packetsDropped;
+			return;
+		}
+		packet = &sock->delayed[(sock->delayedHead + sock->delayedCount) % NET_SHIM_QUEUE];
+		packet->due = SDL_GetTicks() + sock->latency;
+		packet->host = host;
+		packet->port = port;
+		packet->length = length;
+		memcpy(packet->data, data, length);
+		++sock->delayedCount;
+		return;
+	}
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = host;
+	address.sin_port = port;
+	sendto(sock->fd, data, length, 0, (struct sockaddr *)&address, sizeof(address));
+}
+
+/**
+ * Send the delayed packets that are due. The delay is the same for all : they stay in order.
+ * @param	NetSocket*	sock	the socket
+ */
+void flushPackets(NetSocket *sock) {
+	struct sockaddr_in address;
+	DelayedPacket *packet;
+	Uint32 now = SDL_GetTicks();
+
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	while (sock->delayedCount) {
+		packet = &sock->delayed[sock->delayedHead];
+		if ((Sint32)(packet->due - now) > 0) {
+			return;
+		}
+		address.sin_addr.s_addr = packet->host;
+		address.sin_port = packet->port;
+		sendto(sock->fd, packet->data, packet->length, 0, (struct sockaddr *)&address, sizeof(address));
+		sock->delayedHead = (sock->delayedHead + 1) % NET_SHIM_QUEUE;
+		--sock->delayedCount;
+	}
+}
+
+/**
+ * Take a received packet, never waits.
+ * @param		NetSocket*			sock	the socket
+ * @param		Uint32*					host	the address of the sender, network byte order
+ * @param		Uint16*					port	the port of the sender, network byte order
+ * @param		unsigned char*	data	NET_PACKET_SIZE bytes for the packet
+ * @return	int										the packet size, -1 if none was received
+ */
+int receivePacket(NetSocket *sock, Uint32 *host, Uint16 *port, unsigned char *data) {
+	struct sockaddr_in address;
+	socklen_t size = sizeof(address);
+	ssize_t length = recvfrom(sock->fd, data, NET_PACKET_SIZE, 0, (struct sockaddr *)&address, &size);
+
+	if (length < 0) {
+		return -1;
+	}
+	*host = address.sin_addr.s_addr;
+	*port = address.sin_port;
+	sock->bytesReceived += length;
+	++sock->packetsReceived;
+	return length;
+}
+
+/*/////////////////////////////////////////
+ //						BITS FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Start writing or reading a packet.
+ * @param	BitStream*			stream	the stream
+ * @param	unsigned char*	data		the packet
+ * @param	int							size		the packet size, in bytes
+ */
+void initBitStream(BitStream *stream, unsigned char *data, int size) {
+	stream->data = data;
+	stream->size = size;
+	stream->bit = 0;
+	stream->overflow = false;
+}
+
+/**
+ * Write the low bits of a value, the highest first.
+ * @param	BitStream*	stream	the stream
+ * @param	Uint32			value		the value
+ * @param	int					bits		the number of bits, not more than 32
+ */
+void writeBits(BitStream *stream, Uint32 value, int bits) {
+	int i;
+
+	if (stream->bit + bits > stream->size * 8) {
+		stream->overflow = true;
+		return;
+	}
+	for (i = bits - 1; i >= 0; --i) {
+		if ((value >> i) & 1) {
+			stream->data[stream->bit / 8] |= 0x80 >> (stream->bit % 8);
+		} else {
+			stream->data[stream->bit / 8] &= ~(0x80 >> (stream->bit % 8));
+		}
+		++stream->bit;
+	}
+}
+
+/**
+ * Read a value written by writeBits.
+ * @param		BitStream*	stream	the stream
+ * @param		int					bits		the number of bits, not more than 32
+ * @return	Uint32							the value, 0 past the end of the packet
+ */
+Uint32 readBits(BitStream *stream, int bits) {
+	Uint32 value = 0;
+	int i;
+
+	if (stream->bit + bits > stream->size * 8) {
+		stream->overflow = true;
+		return 0;
+	}
+	for (i = 0; i < bits; ++i) {
+		value = (value << 1) | ((stream->data[stream->bit / 8] >> (7 - (stream->bit % 8))) & 1);
+		++stream->bit;
+	}
+	return value;
+}
+
+/**
+ * Give the size of what was written.
+ * @param		BitStream const*	stream	the stream
+ * @return	int												the number of bytes started
+ */
+int bitStreamBytes(BitStream const *stream) {
+	return (stream->bit + 7) / 8;
+}
+
+/**
+ * Write a value the reader can predict : 0 if it is the prediction, 10 then the difference
+ * if it is close, 11 then the whole value otherwise.
+ * @param	BitStream*	stream		the stream
+ * @param	int					value			the value, from 0 to 2^bits - 1
+ * @param	int					predicted	the value the reader expects
+ * @param	int					bits			the size of the whole value
+ */
+void writeValue(BitStream *stream, int value, int predicted, int bits) {
+	int difference = value - predicted;
+	int range = 1 << (NET_SMALL_BITS - 1);
+
+	if (difference == 0) {
+		writeBits(stream, 0, 1);
+	} else if (difference >= -range && difference < range && bits > NET_SMALL_BITS) {
+		writeBits(stream, 2, 2);
+		writeBits(stream, difference + range, NET_SMALL_BITS);
+	} else {
+		writeBits(stream, 3, 2);
+		writeBits(stream, value, bits);
+	}
+}
+
+/**
+ * Read a value written by writeValue.
+ * @param		BitStream*	stream		the stream
+ * @param		int					predicted	the same prediction as the writer
+ * @param		int					bits			the size of the whole value
+ * @return	int										the value
+ */
+int readValue(BitStream *stream, int predicted, int bits) {
+	if (!readBits(stream, 1)) {
+		return predicted;
+	}
+	if (!readBits(stream, 1)) {
+		return predicted + (int)readBits(stream, NET_SMALL_BITS) - (1 << (NET_SMALL_BITS - 1));
+	}
+	return readBits(stream, bits);
+}
+
+/*/////////////////////////////////////////
+ //					STATE FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Compare two sequence numbers that wrap around.
+ * @param		Uint16	a	the first sequence
+ * @param		Uint16	b	the second sequence
+ * @return	bool			true if a was sent after b
+ */
+bool newerSequence(Uint16 a, Uint16 b) {
+	return a != b && (Uint16)(a - b) < 0x8000;
+}
+
+/**
+ * Quantize a coordinate or a speed to 1 / NET_SCALE pixel.
+ * @param		float	value		the value, in pixels
+ * @param		int		offset	the smallest value sent, in pixels, negated
+ * @param		int		bits		the size of the quantized value
+ * @return	int						the quantized value, from 0 to 2^bits - 1
+ */
+int quantize(float value, int offset, int bits) {
+	int quantized = floor(((value + offset) * NET_SCALE) + 0.5);
+	return quantized < 0 ? 0 : (quantized >= (1 << bits) ? (1 << bits) - 1 : quantized);
+}
+
+/**
+ * Give back the pixels of a quantized value.
+ * @param		int		value		the quantized value
+ * @param		int		offset	the offset given to quantize
+ * @return	float					the value, in pixels
+ */
+float dequantize(int value, int offset) {
+	return ((float)value / NET_SCALE) - offset;
+}
+
+/**
+ * Quantize a snapshot into the state sent to the clients.
+ * @param	NetState*							state			the state to fill
+ * @param	RenderSnapshot const*	snapshot	the snapshot of the match
+ */
+void captureNetState(NetState *state, RenderSnapshot const *snapshot) {
+	Player const *player;
+	Ball const *ball;
+	int i, j;
+
+	memset(state, 0, sizeof(NetState));
+	state->tick = snapshot->tick;
+	state->over = snapshot->over;
+	state->nbPlayers = snapshot->nbPlayers;
+	state->nbBalls = snapshot->nbBalls < NET_MAX_BALLS ? snapshot->nbBalls : NET_MAX_BALLS;
+	state->gridWidth = snapshot->gridWidth;
+	state->gridHeight = snapshot->gridHeight;
+	for (i = 0; i < snapshot->nbPlayers; ++i) {
+		player = &snapshot->players[i];
+		state->players[i].life = player->life < -2 ? -2 : (player->life > 13 ? 13 : player->life);
+		state->players[i].score = player->score < 0 ? 0 : (player->score > 0xFFFF ? 0xFFFF : player->score);
+		state->players[i].x = quantize(player->bar.center.x, NET_POSITION_OFFSET, NET_POSITION_BITS);
+		state->players[i].y = quantize(player->bar.center.y, NET_POSITION_OFFSET, NET_POSITION_BITS);
+		state->players[i].width = player->bar.width < 0 ? 0 : (player->bar.width > 511 ? 511 : player->bar.width);
+	}
+	for (i = 0; i < state->nbBalls; ++i) {
+		ball = &snapshot->balls[i];
+		state->balls[i].x = quantize(ball->origin.x, NET_POSITION_OFFSET, NET_POSITION_BITS);
+		state->balls[i].y = quantize(ball->origin.y, NET_POSITION_OFFSET, NET_POSITION_BITS);
+		state->balls[i].speedX = quantize(ball->speed.x, NET_SPEED_OFFSET, NET_SPEED_BITS);
+		state->balls[i].speedY = quantize(ball->speed.y, NET_SPEED_OFFSET, NET_SPEED_BITS);
+		state->balls[i].radius = ball->radius > 63 ? 63 : ball->radius;
+		state->balls[i].respawnTimer = ball->respawnTimer > 255 ? 255 : ball->respawnTimer;
+		state->balls[i].lastPlayerId = ball->lastPlayerId & 7;
+	}
+	for (i = 0; i < snapshot->gridHeight; ++i) {
+		for (j = 0; j < snapshot->gridWidth; ++j) {
+			if (snapshot->rows[i][j].status != DESTROYED) {
+				state->bricks[((i * snapshot->gridWidth) + j) / 32] |= 1u << (((i * snapshot->gridWidth) + j) % 32);
+			}
+		}
+	}
+}
+
+/**
+ * Predict where a ball is from a baseline : it kept its speed since then.
+ * @param		int							position	the coordinate in the baseline
+ * @param		int							speed			the quantized speed on the same axis in the baseline
+ * @param		NetBall const*	baseline	the ball in the baseline
+ * @param		long						ticks			the ticks since the baseline
+ * @return	int												the predicted coordinate
+ */
+int predictPosition(int position, int speed, NetBall const *baseline, long ticks) {
+	long predicted;
+
+	if (baseline->respawnTimer || ticks <= 0 || ticks > 1024) {
+		return position;
+	}
+	predicted = position + ((speed - (NET_SPEED_OFFSET * NET_SCALE)) * ticks);
+	return predicted < 0 ? 0 : (predicted >= (1 << NET_POSITION_BITS) ? (1 << NET_POSITION_BITS) - 1 : predicted);
+}
+
+/**
+ * Write a state against a baseline the reader has. The same order as readNetState.
+ * @param	BitStream*			stream		the packet
+ * @param	NetState const*	state			the state to send
+ * @param	NetState const*	baseline	the state the reader has, zeroed for none
+ */
+void writeNetState(BitStream *stream, NetState const *state, NetState const *baseline) {
+	NetPlayer const *player, *basePlayer;
+	NetBall const *ball, *baseBall;
+	long ticks = (long)(state->tick - baseline->tick);
+	Uint32 changed;
+	int nbChanged = 0, i, j;
+
+	if (ticks >= 0 && ticks < 4096) {
+		writeBits(stream, 0, 1);
+		writeBits(stream, ticks, 12);
+	} else {
+		writeBits(stream, 1, 1);
+		writeBits(stream, state->tick, 32);
+	}
+	writeValue(stream, state->over, baseline->over, 1);
+	writeValue(stream, state->nbPlayers, baseline->nbPlayers, 3);
+	writeValue(stream, state->nbBalls, baseline->nbBalls, 4);
+	writeValue(stream, state->gridWidth, baseline->gridWidth, 4);
+	writeValue(stream, state->gridHeight, baseline->gridHeight, 4);
+
+	for (i = 0; i < state->nbPlayers; ++i) {
+		player = &state->players[i];
+		basePlayer = &baseline->players[i];
+		writeValue(stream, player->life + 2, basePlayer->life + 2, 4);
+		writeValue(stream, player->score, basePlayer->score, 16);
+		writeValue(stream, player->x, basePlayer->x, NET_POSITION_BITS);
+		writeValue(stream, player->y, basePlayer->y, NET_POSITION_BITS);
+		writeValue(stream, player->width, basePlayer->width, 9);
+	}
+	for (i = 0; i < state->nbBalls; ++i) {
+		ball = &state->balls[i];
+		baseBall = &baseline->balls[i];
+		writeValue(stream, ball->x, predictPosition(baseBall->x, baseBall->speedX, baseBall, ticks), NET_POSITION_BITS);
+		writeValue(stream, ball->y, predictPosition(baseBall->y, baseBall->speedY, baseBall, ticks), NET_POSITION_BITS);
+		writeValue(stream, ball->speedX, baseBall->speedX, NET_SPEED_BITS);
+		writeValue(stream, ball->speedY, baseBall->speedY, NET_SPEED_BITS);
+		writeValue(stream, ball->radius, baseBall->radius, 6);
+		writeValue(stream, ball->respawnTimer, baseBall->respawnTimer, 8);
+		writeValue(stream, ball->lastPlayerId, baseBall->lastPlayerId, 3);
+	}
+
+	/* the bricks destroyed since the baseline, by index */
+	for (i = 0; i < NET_BRICK_WORDS; ++i) {
+		for (changed = state->bricks[i] ^ baseline->bricks[i]; changed; changed &= changed - 1) {
+			++nbChanged;
+		}
+	}
+	writeBits(stream, nbChanged != 0, 1);
+	if (nbChanged) {
+		writeBits(stream, nbChanged, 8);
+		for (i = 0; i < NET_BRICK_WORDS; ++i) {
+			changed = state->bricks[i] ^ baseline->bricks[i];
+			for (j = 0; j < 32; ++j) {
+				if ((changed >> j) & 1) {
+					writeBits(stream, (i * 32) + j, 8);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * Read a state written by writeNetState.
+ * @param	BitStream*			stream		the packet
+ * @param	NetState*				state			the state read
+ * @param	NetState const*	baseline	the same baseline as the writer
+ */
+void readNetState(BitStream *stream, NetState *state, NetState const *baseline) {
+	NetPlayer *player;
+	NetPlayer const *basePlayer;
+	NetBall *ball;
+	NetBall const *baseBall;
+	long ticks;
+	int nbChanged, index, i;
+
+	*state = *baseline;
+	if (!readBits(stream, 1)) {
+		state->tick = baseline->tick + readBits(stream, 12);
+	} else {
+		state->tick = readBits(stream, 32);
+	}
+	ticks = (long)(state->tick - baseline->tick);
+	state->over = readValue(stream, baseline->over, 1);
+	state->nbPlayers = readValue(stream, baseline->nbPlayers, 3);
+	state->nbBalls = readValue(stream, baseline->nbBalls, 4);
+	state->gridWidth = readValue(stream, baseline->gridWidth, 4);
+	state->gridHeight = readValue(stream, baseline->gridHeight, 4);
+	if (state->nbPlayers > 4 || state->nbBalls > NET_MAX_BALLS
+		|| state->gridWidth * state->gridHeight > GRID_MAX_WIDTH * GRID_MAX_HEIGHT) {
+		stream->overflow = true;
+		return;
+	}
+
+	for (i = 0; i < state->nbPlayers; ++i) {
+		player = &state->players[i];
+		basePlayer = &baseline->players[i];
+		player->life = readValue(stream, basePlayer->life + 2, 4) - 2;
+		player->score = readValue(stream, basePlayer->score, 16);
+		player->x = readValue(stream, basePlayer->x, NET_POSITION_BITS);
+		player->y = readValue(stream, basePlayer->y, NET_POSITION_BITS);
+		player->width = readValue(stream, basePlayer->width, 9);
+	}
+	for (i = 0; i < state->nbBalls; ++i) {
+		ball = &state->balls[i];
+		baseBall = &baseline->balls[i];
+		ball->x = readValue(stream, predictPosition(baseBall->x, baseBall->speedX, baseBall, ticks), NET_POSITION_BITS);
+		ball->y = readValue(stream, predictPosition(baseBall->y, baseBall->speedY, baseBall, ticks), NET_POSITION_BITS);
+		ball->speedX = readValue(stream, baseBall->speedX, NET_SPEED_BITS);
+		ball->speedY = readValue(stream, baseBall->speedY, NET_SPEED_BITS);
+		ball->radius = readValue(stream, baseBall->radius, 6);
+		ball->respawnTimer = readValue(stream, baseBall->respawnTimer, 8);
+		ball->lastPlayerId = readValue(stream, baseBall->lastPlayerId, 3);
+	}
+	/* the players and balls that left keep the values of no one, like in captureNetState */
+	memset(&state->players[state->nbPlayers], 0, (4 - state->nbPlayers) * sizeof(NetPlayer));
+	memset(&state->balls[state->nbBalls], 0, (NET_MAX_BALLS - state->nbBalls) * sizeof(NetBall));
+
+	if (readBits(stream, 1)) {
+		for (nbChanged = readBits(stream, 8); nbChanged > 0; --nbChanged) {
+			index = readBits(stream, 8);
+			if (index < NET_BRICK_WORDS * 32) {
+				state->bricks[index / 32] ^= 1u << (index % 32);
+			}
+		}
+	}
+}
+
+/**
+ * Keep a state sent or received, to use it as a baseline later.
+ * @param	NetHistory*			history		the states kept
+ * @param	NetState const*	state			the state
+ * @param	Uint16					sequence	the sequence of the packet
+ */
+void storeNetState(NetHistory *history, NetState const *state, Uint16 sequence) {
+	history->states[sequence % NET_HISTORY] = *state;
+	history->sequences[sequence % NET_HISTORY] = sequence;
+	history->valid[sequence % NET_HISTORY] = true;
+}
+
+/**
+ * Find a state kept.
+ * @param		NetHistory const*	history		the states kept
+ * @param		Uint16						sequence	the sequence of the packet
+ * @return	NetState const*							the state, NULL if it is not kept anymore
+ */
+NetState const *findNetState(NetHistory const *history, Uint16 sequence) {
+	if (!history->valid[sequence % NET_HISTORY] || history->sequences[sequence % NET_HISTORY] != sequence) {
+		return NULL;
+	}
+	return &history->states[sequence % NET_HISTORY];
+}
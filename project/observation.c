@@ -0,0 +1,190 @@
+/**
+ * @file		observation.c
+ *       		observation functions library. Rasterize the match on the CPU into small grayscale
+ * 			    frames (84x84 for example) for the learning agents : no GL context, straight into the
+ * 			    memory of the caller. Every shape is drawn as horizontal spans, each one a memset :
+ * 			    the C library fills them with its widest vector stores.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+/* gray level of the bricks, by brick type */
+static unsigned char const brickGrays[7] = {96, 64, 128, 160, 128, 160, 128};
+
+/*/////////////////////////////////////////
+ //					SPAN FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Find the pixels covered by [min, max[, at least one.
+ * @param		float	min		the first side, in frame pixels
+ * @param		float	max		the second side, in frame pixels
+ * @param		int		size	the frame size on this axis
+ * @param		int*	first	the first pixel covered
+ * @return	int						the pixel after the last one covered, not more than first if none is in the frame
+ */
+int coveredPixels(float min, float max, int size, int *first) {
+	int last = ceil(max);
+
+	*first = floor(min);
+	if (last <= *first) {
+		last = *first + 1;
+	}
+	*first = *first < 0 ? 0 : *first;
+	return last > size ? size : last;
+}
+
+/**
+ * Fill the pixels of a line covered by [left, right[, at least one pixel.
+ * @param	unsigned char*	line	the first pixel of the line
+ * @param	int							width	the frame width
+ * @param	float						left	the left side, in frame pixels
+ * @param	float						right	the right side, in frame pixels
+ * @param	unsigned char		gray	the gray level
+ */
+void fillSpan(unsigned char *line, int width, float left, float right, unsigned char gray) {
+	int x0, x1 = coveredPixels(left, right, width, &x0);
+
+	if (x1 > x0) {
+		memset(line + x0, gray, x1 - x0);
+	}
+}
+
+/**
+ * Fill a box given in screen coordinates, at least one pixel. The same span on every line.
+ * @param	unsigned char*	pixels	the frame
+ * @param	int							width		the frame width
+ * @param	int							height	the frame height
+ * @param	Point2D					min			the top left corner, in screen coordinates
+ * @param	Point2D					max			the bottom right corner, in screen coordinates
+ * @param	unsigned char		gray		the gray level
+ */
+void fillBox(unsigned char *pixels, int width, int height, Point2D min, Point2D max, unsigned char gray) {
+	float scaleX = (float)width / SCREEN_WIDTH;
+	float scaleY = (float)height / SCREEN_HEIGHT;
+	int x0, x1 = coveredPixels(min.x * scaleX, max.x * scaleX, width, &x0);
+	int y0, y1 = coveredPixels(min.y * scaleY, max.y * scaleY, height, &y0);
+	int y;
+
+	if (x1 <= x0) {
+		return;
+	}
+	for (y = y0; y < y1; ++y) {
+		memset(pixels + (y * width) + x0, gray, x1 - x0);
+	}
+}
+
+/**
+ * Fill a ball, one span per line. A ball smaller than a pixel still fills the pixel of its center.
+ * @param	unsigned char*	pixels	the frame
+ * @param	int							width		the frame width
+ * @param	int							height	the frame height
+ * @param	Ball const*			ball		the ball to draw
+ * @param	unsigned char		gray		the gray level
+ */
+void fillBall(unsigned char *pixels, int width, int height, Ball const *ball, unsigned char gray) {
+	float scaleX = (float)width / SCREEN_WIDTH;
+	float scaleY = (float)height / SCREEN_HEIGHT;
+	float centerX = ball->origin.x * scaleX, centerY = ball->origin.y * scaleY;
+	float radiusY = ball->radius * scaleY;
+	float dy, half;
+	int y0 = floor(centerY - radiusY);
+	int y1 = floor(centerY + radiusY) + 1;
+	int y;
+
+	y0 = y0 < 0 ? 0 : y0;
+	y1 = y1 > height ? height : y1;
+	for (y = y0; y < y1; ++y) {
+		/* the nearest point of the line to the center */
+		dy = centerY < y ? y - centerY : (centerY > y + 1 ? centerY - (y + 1) : 0);
+		if (dy > radiusY) {
+			continue;
+		}
+		half = sqrt((radiusY * radiusY) - (dy * dy)) * (scaleX / scaleY);
+		fillSpan(pixels + (y * width), width, centerX - half, centerX + half, gray);
+	}
+}
+
+/*/////////////////////////////////////////
+ //				OBSERVATION FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Draw the match into a grayscale frame of the caller : black background, bricks, bars
+ * then balls, the whole screen scaled to the frame.
+ * @param	unsigned char*	pixels			the frame, width * height bytes, line by line
+ * @param	int							width				the frame width
+ * @param	int							height			the frame height
+ * @param	GridBrick				grid				the 2 dimensional brick grid
+ * @param	int							gridWidth		the number of columns in game
+ * @param	int							gridHeight	the number of lines
+ * @param	Player const*		players			the players to draw
+ * @param	int							nbPlayers		total number of players in game
+ * @param	Ball const*			balls				the balls to draw
+ * @param	int							nbBalls			the number of balls in game
+ */
+void drawObservation(unsigned char *pixels, int width, int height, GridBrick const grid, int gridWidth,
+	int gridHeight, Player const *players, int nbPlayers, Ball const *balls, int nbBalls) {
+	Bar const *bar;
+	Point2D min, max;
+	int sizeX, sizeY, i, j;
+
+	memset(pixels, 0, width * height);
+	for (i = 0; i < gridHeight; ++i) {
+		for (j = 0; j < gridWidth; ++j) {
+			if (grid[i][j].status != DESTROYED) {
+				fillBox(pixels, width, height, grid[i][j].topLeft, grid[i][j].bottomRight, brickGrays[grid[i][j].type]);
+			}
+		}
+	}
+	for (i = 0; i < nbPlayers; ++i) {
+		bar = &players[i].bar;
+		sizeX = bar->orientationHorizontal ? bar->width / 2 : BAR_HEIGHT / 2;
+		sizeY = bar->orientationHorizontal ? BAR_HEIGHT / 2 : bar->width / 2;
+		initPoint2D(&min, bar->center.x - sizeX, bar->center.y - sizeY);
+		initPoint2D(&max, bar->center.x + sizeX, bar->center.y + sizeY);
+		fillBox(pixels, width, height, min, max, OBSERVATION_BAR);
+	}
+	for (i = 0; i < nbBalls; ++i) {
+		if (!balls[i].respawnTimer) {
+			fillBall(pixels, width, height, &balls[i], OBSERVATION_BALL);
+		}
+	}
+}
+
+/**
+ * Push a new frame in a stack of the last frames : the frames move one place towards the
+ * start, the oldest is dropped and the match is drawn in the last one.
+ * @param	unsigned char*	frames			depth frames of width * height bytes, the oldest first
+ * @param	int							depth				the number of frames of the stack
+ * @param	int							width				the frame width
+ * @param	int							height			the frame height
+ * @param	GridBrick				grid				the 2 dimensional brick grid
+ * @param	int							gridWidth		the number of columns in game
+ * @param	int							gridHeight	the number of lines
+ * @param	Player const*		players			the players to draw
+ * @param	int							nbPlayers		total number of players in game
+ * @param	Ball const*			balls				the balls to draw
+ * @param	int							nbBalls			the number of balls in game
+ */
+void stackObservation(unsigned char *frames, int depth, int width, int height, GridBrick const grid,
+	int gridWidth, int gridHeight, Player const *players, int nbPlayers, Ball const *balls, int nbBalls) {
+	int size = width * height;
+
+	memmove(frames, frames + size, (depth - 1) * size);
+	drawObservation(frames + ((depth - 1) * size), width, height, grid, gridWidth, gridHeight,
+		players, nbPlayers, balls, nbBalls);
+}
@@ -0,0 +1,240 @@
+/**
+ * @file		particles.c
+ *       		particles functions library. Debris bursts of the destroyed bricks, in a fixed-capacity
+ * 			    pool stored as structure of arrays : the integration is one straight loop per frame
+ * 			    the compiler can vectorise, the whole pool is drawn in a single batch and nothing is
+ * 			    allocated per particle. The simulation thread only queues the bursts, the GL thread
+ * 			    spawns, moves and draws the particles.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <GL/gl.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+/* number of particles of a burst, by brick type (INDESTRUCTIBLE bricks never break) */
+static int const burstSizes[7] = {12, 0, 24, 24, 32, 20, 20};
+
+static ParticlePool pool;
+static long particlesTick = 0;
+static unsigned int particlesSeed = 42;
+
+static ParticleBurst burstQueue[PARTICLE_BURST_QUEUE];
+static unsigned long burstHead = 0;
+static unsigned long burstTail = 0;
+static bool burstsMuted = false;
+
+static GLfloat particleVertices[PARTICLE_CAPACITY * 6 * 2];
+static GLfloat particleColors[PARTICLE_CAPACITY * 6 * 3];
+
+/*/////////////////////////////////////////
+ //					BURST FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Queue the debris burst of a destroyed brick. Never blocks : when the GL thread is a full
+ * queue behind, the burst is dropped. Single producer : only the thread running hitBrick.
+ * @param	Brick const*	brick	the destroyed brick
+ */
+void emitBrickBurst(Brick const *brick) {
+	unsigned long head = burstHead;
+
+	if (burstsMuted) {
+		return;
+	}
+	if (head - __atomic_load_n(&burstTail, __ATOMIC_ACQUIRE) >= PARTICLE_BURST_QUEUE) {
+		__atomic_fetch_add(&pool.droppedBursts, 1, __ATOMIC_RELAXED);
+		return;
+	}
+	initPoint2D(&burstQueue[head & (PARTICLE_BURST_QUEUE - 1)].center,
+		(brick->topLeft.x + brick->bottomRight.x) / 2, (brick->topLeft.y + brick->bottomRight.y) / 2);
+	burstQueue[head & (PARTICLE_BURST_QUEUE - 1)].type = brick->type;
+	burstQueue[head & (PARTICLE_BURST_QUEUE - 1)].texture = defineBrickColor(*brick);
+	__atomic_store_n(&burstHead, head + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Stop queueing the bursts while ticks are played again (rollback) : they were queued the first time.
+ * Only called by the thread running hitBrick.
+ * @param	bool	muted	true to stop queueing
+ */
+void muteBrickBursts(bool muted) {
+	burstsMuted = muted;
+}
+
+/**
+ * Random number of the particles (own generator : rand() belongs to the simulation).
+ * @return	unsigned int	a number between 0 and 32767
+ */
+unsigned int particleRandom() {
+	particlesSeed = (particlesSeed * 1103515245u) + 12345u;
+	return (particlesSeed >> 16) & 0x7FFF;
+}
+
+/**
+ * Spawn the particles of a burst, from the precomputed unit circle of the balls.
+ * The particles that don't fit in the pool are dropped.
+ * @param	ParticleBurst const*	burst	the burst to spawn
+ */
+void spawnBurst(ParticleBurst const *burst) {
+	Color3f color;
+	Point2D const *direction;
+	float speed;
+	int i, n = burstSizes[burst->type];
+
+	/* the colors of the brick textures */
+	if (burst->texture == BONUS) {
+		initColor3f(&color, 20, 230, 90);
+	} else if (burst->texture == MALUS) {
+		initColor3f(&color, 220, 20, 60);
+	} else {
+		initColor3f(&color, 255, 160, 60);
+	}
+
+	for (i = 0; i < n; ++i) {
+		if (pool.count == PARTICLE_CAPACITY) {
+			pool.droppedParticles += n - i;
+			break;
+		}
+		direction = &ballMesh[particleRandom() % BALL_SIDES];
+		speed = PARTICLE_MIN_SPEED + ((particleRandom() % 100) * (PARTICLE_MAX_SPEED - PARTICLE_MIN_SPEED) / 100.0f);
+		pool.x[pool.count] = burst->center.x + (direction->x * (BRICK_WIDTH / 4));
+		pool.y[pool.count] = burst->center.y + (direction->y * (BRICK_HEIGHT / 4));
+		pool.vx[pool.count] = direction->x * speed;
+		pool.vy[pool.count] = direction->y * speed;
+		pool.life[pool.count] = PARTICLE_LIFE - (particleRandom() % (PARTICLE_LIFE / 2));
+		pool.r[pool.count] = color.r;
+		pool.g[pool.count] = color.g;
+		pool.b[pool.count] = color.b;
+		++pool.count;
+	}
+	if (pool.count > pool.peak) {
+		pool.peak = pool.count;
+	}
+}
+
+/*/////////////////////////////////////////
+ //					POOL FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Empty the pool and the burst queue for a new match. Peak and drop counters are kept.
+ * Must be called while the simulation thread is stopped.
+ */
+void resetParticles() {
+	pool.count = 0;
+	particlesTick = 0;
+	burstTail = __atomic_load_n(&burstHead, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Spawn the queued bursts, then move the particles to a simulation tick and cull the dead ones.
+ * Single consumer of the burst queue : only the GL thread.
+ * @param	long	tick	the tick of the drawn snapshot
+ */
+void updateParticles(long tick) {
+	unsigned long head = __atomic_load_n(&burstHead, __ATOMIC_ACQUIRE);
+	unsigned long tail = burstTail;
+	float dt = tick - particlesTick;
+	int i, alive, count;
+
+	while (tail != head) {
+		spawnBurst(&burstQueue[tail & (PARTICLE_BURST_QUEUE - 1)]);
+		++tail;
+	}
+	__atomic_store_n(&burstTail, tail, __ATOMIC_RELEASE);
+
+	if (tick < particlesTick) {
+		dt = 0;
+	}
+	particlesTick = tick;
+	if (dt <= 0) {
+		return;
+	}
+
+	/* integrate : no branch, no aliasing, and a multiple of 4 particles (the unused
+	 * slots are moved for nothing) so that even -O2 vectorises it without a scalar tail */
+	count = (pool.count + 3) & ~3;
+	for (i = 0; i < count; ++i) {
+		pool.x[i] += pool.vx[i] * dt;
+		pool.y[i] += pool.vy[i] * dt;
+		pool.vy[i] += PARTICLE_GRAVITY * dt;
+		pool.life[i] -= dt;
+	}
+
+	/* cull : compact the living particles at the start of the arrays */
+	for (i = 0, alive = 0; i < pool.count; ++i) {
+		if (pool.life[i] > 0) {
+			pool.x[alive] = pool.x[i];
+			pool.y[alive] = pool.y[i];
+			pool.vx[alive] = pool.vx[i];
+			pool.vy[alive] = pool.vy[i];
+			pool.life[alive] = pool.life[i];
+			pool.r[alive] = pool.r[i];
+			pool.g[alive] = pool.g[i];
+			pool.b[alive] = pool.b[i];
+			++alive;
+		}
+	}
+	pool.count = alive;
+}
+
+/**
+ * Draw every particle as a small square fading out, in a single draw call.
+ */
+void drawParticles() {
+	GLfloat *v = particleVertices, *c = particleColors;
+	float fade, x0, y0, x1, y1;
+	int i, j;
+
+	if (!pool.count) {
+		return;
+	}
+	for (i = 0; i < pool.count; ++i) {
+		x0 = pool.x[i] - (PARTICLE_SIZE / 2.0f);
+		y0 = pool.y[i] - (PARTICLE_SIZE / 2.0f);
+		x1 = x0 + PARTICLE_SIZE;
+		y1 = y0 + PARTICLE_SIZE;
+		*v++ = x0;
+		*v++ = y0;
+		*v++ = x1;
+		*v++ = y0;
+		*v++ = x1;
+		*v++ = y1;
+		*v++ = x0;
+		*v++ = y0;
+		*v++ = x1;
+		*v++ = y1;
+		*v++ = x0;
+		*v++ = y1;
+
+		fade = pool.life[i] / PARTICLE_LIFE;
+		for (j = 0; j < 6; ++j) {
+			*c++ = pool.r[i] * fade;
+			*c++ = pool.g[i] * fade;
+			*c++ = pool.b[i] * fade;
+		}
+	}
+	renderer->drawTriangles(particleVertices, particleColors, pool.count * 6);
+}
+
+/**
+ * Get the pool, for its size and peak use.
+ * @return	ParticlePool const*	the particle pool
+ */
+ParticlePool const *particlePool() {
+	return &pool;
+}
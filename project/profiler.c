@@ -0,0 +1,259 @@
+/**
+ * @file		profiler.c
+ *       		profiler functions library. Time the phases of the main loop with a monotonic clock,
+ * 			    keep the frames in a lock-free ring, draw min/avg/p99 per phase and dump CSV.
+ * 			    Only compiled with -DPROFILER (make PROFILE=1), the PROFILE_* macros are empty otherwise.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_thread.h>
+#include <GL/gl.h>
+
+#include "headers.h"
+
+#ifdef PROFILER
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static char const *phaseNames[PHASE_NB] = {"events", "collision", "movement", "draw", "swap"};
+
+static FrameProfile history[PROFILER_WINDOW];
+static FrameProfile ring[PROFILER_RING_SIZE];
+static unsigned long ringHead = 0;
+static unsigned long ringTail = 0;
+static unsigned long droppedFrames = 0;
+
+static FrameProfile current;
+static unsigned long phaseStart[PHASE_NB];
+static bool overlayVisible = false;
+
+static FILE *csvFile = NULL;
+static SDL_Thread *csvThread = NULL;
+static int csvRunning = 0;
+
+/*/////////////////////////////////////////
+ //					CSV WRITER FUNCTIONS				//
+/////////////////////////////////////////*/
+
+/**
+ * Write every published frame not yet consumed into the CSV file.
+ * Single consumer side of the ring : only the writer thread moves the tail.
+ */
+void profilerDrainCSV() {
+	unsigned long head = __atomic_load_n(&ringHead, __ATOMIC_ACQUIRE);
+	unsigned long tail = ringTail;
+	FrameProfile const *frame;
+	int i;
+
+	while (tail != head) {
+		frame = &ring[tail & (PROFILER_RING_SIZE - 1)];
+		fprintf(csvFile, "%lu", frame->frame);
+		for (i = 0; i < PHASE_NB; ++i) {
+			fprintf(csvFile, ",%lu", frame->phases[i]);
+		}
+		fprintf(csvFile, "\n");
+		++tail;
+	}
+	__atomic_store_n(&ringTail, tail, __ATOMIC_RELEASE);
+}
+
+/**
+ * Body of the CSV writer thread, so the game loop never touches the disk.
+ * @param		void*	data	unused
+ * @return	int					0
+ */
+int profilerCSVThread(void *data) {
+	while (__atomic_load_n(&csvRunning, __ATOMIC_ACQUIRE)) {
+		profilerDrainCSV();
+		SDL_Delay(10);
+	}
+	profilerDrainCSV();
+	return 0;
+}
+
+/*/////////////////////////////////////////
+ //					PROFILER FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Start the profiler. If KASSPONG_PROFILE_CSV is set, every frame is dumped in that file.
+ */
+void profilerInit() {
+	char const *path = getenv("KASSPONG_PROFILE_CSV");
+	int i;
+
+	memset(&current, 0, sizeof(current));
+	if (path == NULL) {
+		return;
+	}
+	if ((csvFile = fopen(path, "w")) == NULL) {
+		printf("ERROR : Impossible to open the profiler file '%s'.\n", path);
+		return;
+	}
+	fprintf(csvFile, "frame");
+	for (i = 0; i < PHASE_NB; ++i) {
+		fprintf(csvFile, ",%s_ns", phaseNames[i]);
+	}
+	fprintf(csvFile, "\n");
+	csvRunning = 1;
+	csvThread = SDL_CreateThread(profilerCSVThread, NULL);
+}
+
+/**
+ * Report the particle pool use, stop the CSV writer thread and close the file.
+ */
+void profilerQuit() {
+	if (csvThread != NULL) {
+		__atomic_store_n(&csvRunning, 0, __ATOMIC_RELEASE);
+		SDL_WaitThread(csvThread, NULL);
+		csvThread = NULL;
+	}
+	printf("Particles : pool of %d, peak %d (%.0f%%), %lu bursts and %lu particles dropped\n",
+		PARTICLE_CAPACITY, particlePool()->peak, (100.0 * particlePool()->peak) / PARTICLE_CAPACITY,
+		particlePool()->droppedBursts, particlePool()->droppedParticles);
+	if (csvFile != NULL) {
+		if (droppedFrames) {
+			printf("Profiler : %lu frames not written (CSV writer too slow).\n", droppedFrames);
+		}
+		fclose(csvFile);
+		csvFile = NULL;
+	}
+}
+
+/**
+ * Start timing a phase of the current frame.
+ * @param	enum	phase	the phase to time
+ */
+void profilerBegin(enum profilerPhase phase) {
+	phaseStart[phase] = clockNow();
+}
+
+/**
+ * Stop timing a phase. A phase timed several times in a frame is summed.
+ * The simulation thread times its own phases, so the sum is atomic.
+ * @param	enum	phase	the phase to time
+ */
+void profilerEnd(enum profilerPhase phase) {
+	__atomic_fetch_add(&current.phases[phase], clockNow() - phaseStart[phase], __ATOMIC_RELAXED);
+}
+
+/**
+ * Publish the current frame and start a new one. The frame goes in the overlay
+ * history and, when dumping CSV, in the single producer / single consumer ring.
+ * Never blocks : if the CSV writer is a full ring behind, the frame is dropped from the CSV.
+ */
+void profilerEndFrame() {
+	unsigned long head = ringHead;
+	FrameProfile frame;
+	int i;
+
+	frame.frame = current.frame;
+	for (i = 0; i < PHASE_NB; ++i) {
+		frame.phases[i] = __atomic_exchange_n(&current.phases[i], 0, __ATOMIC_RELAXED);
+	}
+	history[current.frame % PROFILER_WINDOW] = frame;
+	if (csvFile != NULL) {
+		if (head - __atomic_load_n(&ringTail, __ATOMIC_ACQUIRE) >= PROFILER_RING_SIZE) {
+			++droppedFrames;
+		} else {
+			ring[head & (PROFILER_RING_SIZE - 1)] = frame;
+			__atomic_store_n(&ringHead, head + 1, __ATOMIC_RELEASE);
+		}
+	}
+
+	++current.frame;
+}
+
+/**
+ * Show or hide the overlay.
+ */
+void profilerToggleOverlay() {
+	overlayVisible = !overlayVisible;
+}
+
+/**
+ * Compare two durations for qsort.
+ */
+int compareDurations(void const *a, void const *b) {
+	unsigned long da = *(unsigned long const *)a, db = *(unsigned long const *)b;
+	return (da > db) - (da < db);
+}
+
+/**
+ * Compute min/avg/p99 of one phase on the last PROFILER_WINDOW frames.
+ * Frames where the phase did not run are ignored.
+ * @param		enum					phase	the phase to look at
+ * @param		PhaseStats*		stats	the computed statistics
+ * @return	bool								false if the phase never ran in the window
+ */
+bool profilerStats(enum profilerPhase phase, PhaseStats *stats) {
+	static unsigned long samples[PROFILER_WINDOW];
+	unsigned long duration, total = 0;
+	int i, nbSamples = 0;
+
+	for (i = 0; i < PROFILER_WINDOW && (unsigned long)i < current.frame; ++i) {
+		duration = history[i].phases[phase];
+		if (duration) {
+			samples[nbSamples++] = duration;
+			total += duration;
+		}
+	}
+	if (!nbSamples) {
+		return false;
+	}
+	qsort(samples, nbSamples, sizeof(unsigned long), compareDurations);
+	stats->min = samples[0];
+	stats->avg = total / nbSamples;
+	stats->p99 = samples[(nbSamples * 99) / 100];
+	return true;
+}
+
+/**
+ * Draw the min/avg/p99 of every phase and the particle pool use in the top left corner of the playground.
+ * The statistics are only refreshed every 30 frames to keep the overlay cheap.
+ */
+void profilerDrawOverlay() {
+	static char lines[PHASE_NB + 2][64];
+	static unsigned long lastRefresh = 0;
+	PhaseStats stats;
+	unsigned long changes;
+	float scale;
+	int i;
+
+	if (!overlayVisible) {
+		return;
+	}
+	if (current.frame - lastRefresh >= 30 || lastRefresh == 0) {
+		for (i = 0; i < PHASE_NB; ++i) {
+			if (profilerStats(i, &stats)) {
+				sprintf(lines[i], "%-9s min %6.3f avg %6.3f p99 %6.3f ms", phaseNames[i],
+					stats.min / 1e6, stats.avg / 1e6, stats.p99 / 1e6);
+			} else {
+				sprintf(lines[i], "%-9s -", phaseNames[i]);
+			}
+		}
+		sprintf(lines[PHASE_NB], "%-9s %4d/%d peak %d", "particles", particlePool()->count,
+			PARTICLE_CAPACITY, particlePool()->peak);
+		scale = resolutionScale(&changes);
+		sprintf(lines[PHASE_NB + 1], "%-9s %dx%d (%d%%) %lu changes", "scene", (int)(SCREEN_WIDTH * scale),
+			(int)(SCREEN_HEIGHT * scale), (int)(scale * 100), changes);
+		lastRefresh = current.frame;
+	}
+
+	for (i = 0; i <= PHASE_NB + 1; ++i) {
+		renderBitmapString(HUD_HEIGHT + 10 + (GLYPH_WIDTH * 24), HUD_HEIGHT + 20 + (i * GLYPH_HEIGHT), lines[i]);
+	}
+}
+
+#endif
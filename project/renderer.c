@@ -0,0 +1,375 @@
+/**
+ * @file		renderer.c
+ *       		renderer functions library. Every drawing function goes through the current
+ * 			    backend : OpenGL (the window or the headless context), null (nothing is drawn,
+ * 			    only the draw submission is left) or recording (draw calls are counted and
+ * 			    serialised as text, for benchmarks and golden outputs without any GL).
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+Point2D const quadTexCoords[4] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+
+Renderer const glRenderer = {
+	"gl", true,
+	beginFrameGL, endFrameGL, bindTextureGL, drawQuadGL, drawTrianglesGL, drawTextGL,
+	pushTransformGL, popTransformGL
+};
+Renderer const nullRenderer = {
+	"null", false,
+	beginFrameNull, endFrameNull, bindTextureNull, drawQuadNull, drawTrianglesNull, drawTextNull,
+	pushTransformNull, popTransformNull
+};
+Renderer const recordRenderer = {
+	"record", false,
+	beginFrameRecord, endFrameRecord, bindTextureRecord, drawQuadRecord, drawTrianglesRecord, drawTextRecord,
+	pushTransformRecord, popTransformRecord
+};
+
+Renderer const *renderer = &glRenderer;
+
+static FILE *recordOutput = NULL;
+static RenderStats recordStats;
+
+/*/////////////////////////////////////////
+ //					RENDERER FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Change the backend of every drawing function.
+ * @param	Renderer const*	backend	glRenderer, nullRenderer or recordRenderer
+ */
+void setRenderer(Renderer const *backend) {
+	renderer = backend;
+}
+
+/**
+ * Find a backend by its name.
+ * @param		char const*			name	"gl", "null" or "record"
+ * @return	Renderer const*				the backend, NULL if the name is unknown
+ */
+Renderer const *findRenderer(char const *name) {
+	Renderer const *backends[3];
+	int i;
+
+	backends[0] = &glRenderer;
+	backends[1] = &nullRenderer;
+	backends[2] = &recordRenderer;
+	for (i = 0; i < 3; ++i) {
+		if (strcmp(backends[i]->name, name) == 0) {
+			return backends[i];
+		}
+	}
+	return NULL;
+}
+
+/*/////////////////////////////////////////
+ //						OPENGL BACKEND						//
+/////////////////////////////////////////*/
+
+/**
+ * Start a frame : clear the color buffer.
+ */
+void beginFrameGL() {
+	glClear(GL_COLOR_BUFFER_BIT);
+}
+
+/**
+ * Finish a frame. Nothing to do : the caller swaps (window) or reads back (headless).
+ */
+void endFrameGL() {
+}
+
+/**
+ * Bind a theme texture for the next quads, or go back to plain colors.
+ * @param	int	index	index in texturesBuffer, RENDER_NO_TEXTURE for plain colors
+ */
+void bindTextureGL(int index) {
+	if (index == RENDER_NO_TEXTURE) {
+		glBindTexture(GL_TEXTURE_2D, 0);
+		glDisable(GL_TEXTURE_2D);
+		return;
+	}
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, texturesBuffer[index]);
+}
+
+/**
+ * Draw a quad.
+ * @param	Point2D const*	corners		the 4 corners, in drawing order
+ * @param	Point2D const*	texCoords	the texture coordinates of each corner, NULL if not textured
+ * @param	Color3f					color			the quad color (modulates the texture)
+ */
+void drawQuadGL(Point2D const *corners, Point2D const *texCoords, Color3f color) {
+	int i;
+
+	glColor3f(color.r, color.g, color.b);
+	glBegin(GL_POLYGON);
+		for (i = 0; i < 4; ++i) {
+			if (texCoords != NULL) {
+				glTexCoord2f(texCoords[i].x, texCoords[i].y);
+			}
+			glVertex2f(corners[i].x, corners[i].y);
+		}
+	glEnd();
+}
+
+/**
+ * Draw a batch of colored triangles in a single draw call.
+ * @param	GLfloat const*	vertices		x, y of every vertex
+ * @param	GLfloat const*	colors			r, g, b of every vertex
+ * @param	int							nbVertices	number of vertices (3 per triangle)
+ */
+void drawTrianglesGL(GLfloat const *vertices, GLfloat const *colors, int nbVertices) {
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, vertices);
+	glColorPointer(3, GL_FLOAT, 0, colors);
+	glDrawArrays(GL_TRIANGLES, 0, nbVertices);
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+}
+
+/**
+ * Draw a text mesh from the glyph atlas, in a single draw call.
+ * @param	TextMesh const*	mesh	the mesh to draw
+ * @param	Color3f					color	the text color
+ */
+void drawTextGL(TextMesh const *mesh, Color3f color) {
+	glColor3f(color.r, color.g, color.b);
+	glEnable(GL_TEXTURE_2D);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glBindTexture(GL_TEXTURE_2D, glyphAtlas);
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, mesh->vertices);
+	glTexCoordPointer(2, GL_FLOAT, 0, mesh->texCoords);
+	glDrawArrays(GL_QUADS, 0, mesh->nbGlyphs * 4);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	glDisable(GL_BLEND);
+	glDisable(GL_TEXTURE_2D);
+}
+
+/**
+ * Save the current transform, then move (and rotate) the next draws.
+ * @param	float	x			translation (x value)
+ * @param	float	y			translation (y value)
+ * @param	float	angle	rotation in degrees, applied after the translation
+ */
+void pushTransformGL(float x, float y, float angle) {
+	glPushMatrix();
+	glTranslatef(x, y, 0);
+	if (angle != 0) {
+		glRotatef(angle, 0, 0, 1);
+	}
+}
+
+/**
+ * Restore the transform saved by the last pushTransform.
+ */
+void popTransformGL() {
+	glPopMatrix();
+}
+
+/*/////////////////////////////////////////
+ //						NULL BACKEND							//
+/////////////////////////////////////////*/
+
+/* Nothing is drawn : only the CPU side of the frame (draw submission) is left. */
+void beginFrameNull() {
+}
+
+void endFrameNull() {
+}
+
+void bindTextureNull(int index) {
+}
+
+void drawQuadNull(Point2D const *corners, Point2D const *texCoords, Color3f color) {
+}
+
+void drawTrianglesNull(GLfloat const *vertices, GLfloat const *colors, int nbVertices) {
+}
+
+void drawTextNull(TextMesh const *mesh, Color3f color) {
+}
+
+void pushTransformNull(float x, float y, float angle) {
+}
+
+void popTransformNull() {
+}
+
+/*/////////////////////////////////////////
+ //					RECORDING BACKEND						//
+/////////////////////////////////////////*/
+
+/**
+ * Reset the recording counters and choose where the commands are written.
+ * @param	FILE*	output	one command per line, NULL to only count them
+ */
+void startRecording(FILE *output) {
+	recordOutput = output;
+	memset(&recordStats, 0, sizeof(recordStats));
+}
+
+/**
+ * Get the counters of the recording backend since the last startRecording.
+ * @return	RenderStats const*	the counters
+ */
+RenderStats const *recordingStats() {
+	return &recordStats;
+}
+
+/**
+ * Print the recorded draw calls, per frame.
+ * @param	FILE*	output	where to print
+ */
+void printRecordingStats(FILE *output) {
+	double frames = recordStats.frames ? recordStats.frames : 1;
+
+	fprintf(output, "Recorded %lu frames : %.1f draw calls/frame (%.1f quads, %.1f triangle batches, %.1f texts), "
+		"%.1f texture binds/frame, %.1f transforms/frame, %.0f triangles/frame\n",
+		recordStats.frames, (recordStats.quads + recordStats.batches + recordStats.texts) / frames,
+		recordStats.quads / frames, recordStats.batches / frames, recordStats.texts / frames,
+		recordStats.binds / frames, recordStats.transforms / frames, recordStats.triangles / frames);
+}
+
+/**
+ * Count a new frame.
+ */
+void beginFrameRecord() {
+	++recordStats.frames;
+	if (recordOutput != NULL) {
+		fprintf(recordOutput, "frame %lu\n", recordStats.frames);
+	}
+}
+
+/**
+ * Mark the end of the frame.
+ */
+void endFrameRecord() {
+	if (recordOutput != NULL) {
+		fprintf(recordOutput, "end\n");
+	}
+}
+
+/**
+ * Record a texture bind.
+ * @param	int	index	index in texturesBuffer, RENDER_NO_TEXTURE for plain colors
+ */
+void bindTextureRecord(int index) {
+	++recordStats.binds;
+	if (recordOutput != NULL) {
+		fprintf(recordOutput, "texture %d\n", index);
+	}
+}
+
+/**
+ * Record a quad with its corners and color.
+ * @param	Point2D const*	corners		the 4 corners, in drawing order
+ * @param	Point2D const*	texCoords	the texture coordinates of each corner, NULL if not textured
+ * @param	Color3f					color			the quad color
+ */
+void drawQuadRecord(Point2D const *corners, Point2D const *texCoords, Color3f color) {
+	++recordStats.quads;
+	if (recordOutput != NULL) {
+		fprintf(recordOutput, "quad %g %g %g %g %g %g %g %g color %g %g %g%s\n",
+			corners[0].x, corners[0].y, corners[1].x, corners[1].y,
+			corners[2].x, corners[2].y, corners[3].x, corners[3].y,
+			color.r, color.g, color.b, texCoords != NULL ? " textured" : "");
+	}
+}
+
+/**
+ * Record a batch of triangles. The vertices aren't written one by one : the hash of
+ * the bits of every coordinate and color tells two batches apart.
+ * @param	GLfloat const*	vertices		x, y of every vertex
+ * @param	GLfloat const*	colors			r, g, b of every vertex
+ * @param	int							nbVertices	number of vertices (3 per triangle)
+ */
+void drawTrianglesRecord(GLfloat const *vertices, GLfloat const *colors, int nbVertices) {
+	Uint64 hash = HASH_GOLDEN;
+	int i;
+
+	++recordStats.batches;
+	recordStats.triangles += nbVertices / 3;
+	if (recordOutput != NULL) {
+		for (i = 0; i < nbVertices; ++i) {
+			hash = mixHash(hash, HASH_WORD(floatWord(vertices[2 * i]), floatWord(vertices[(2 * i) + 1])));
+			hash = mixHash(hash, HASH_WORD(floatWord(colors[3 * i]), floatWord(colors[(3 * i) + 1])));
+			hash = mixHash(hash, floatWord(colors[(3 * i) + 2]));
+		}
+		fprintf(recordOutput, "triangles %d hash ", nbVertices / 3);
+		printHash(recordOutput, hash);
+		fprintf(recordOutput, "\n");
+	}
+}
+
+/**
+ * Record a text mesh : its string, read back from the atlas cell of every glyph, the
+ * position of its first and last glyphs and its color.
+ * @param	TextMesh const*	mesh	the mesh to draw
+ * @param	Color3f					color	the text color
+ */
+void drawTextRecord(TextMesh const *mesh, Color3f color) {
+	int i, column, line;
+
+	++recordStats.texts;
+	if (recordOutput != NULL) {
+		fprintf(recordOutput, "text \"");
+		for (i = 0; i < mesh->nbGlyphs; ++i) {
+			column = (int)floor((mesh->texCoords[8 * i] * GLYPH_ATLAS_WIDTH / GLYPH_WIDTH) + 0.5);
+			line = (int)floor((mesh->texCoords[(8 * i) + 1] * GLYPH_ATLAS_HEIGHT / GLYPH_CELL_HEIGHT) + 0.5);
+			fputc(GLYPH_FIRST + (line * GLYPH_ATLAS_COLUMNS) + column, recordOutput);
+		}
+		fprintf(recordOutput, "\" at %g %g to %g %g color %g %g %g\n",
+			mesh->vertices[0], mesh->vertices[1],
+			mesh->vertices[8 * (mesh->nbGlyphs - 1)], mesh->vertices[(8 * (mesh->nbGlyphs - 1)) + 1],
+			color.r, color.g, color.b);
+	}
+}
+
+/**
+ * Record a transform.
+ * @param	float	x			translation (x value)
+ * @param	float	y			translation (y value)
+ * @param	float	angle	rotation in degrees
+ */
+void pushTransformRecord(float x, float y, float angle) {
+	++recordStats.transforms;
+	if (recordOutput != NULL) {
+		fprintf(recordOutput, "push %g %g %g\n", x, y, angle);
+	}
+}
+
+/**
+ * Record the end of a transform.
+ */
+void popTransformRecord() {
+	if (recordOutput != NULL) {
+		fprintf(recordOutput, "pop\n");
+	}
+}
@@ -0,0 +1,190 @@
+/**
+ * @file		resolution.c
+ *       		resolution functions library. Render the playfield into an offscreen target whose size
+ * 			    follows the frame time budget, then upscale it to the window. The logical coordinates
+ * 			    (SCREEN_WIDTH x SCREEN_HEIGHT) never change, only the number of pixels behind them.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static float const resolutionScales[RESOLUTION_LEVELS] = {1.0f, 0.85f, 0.7f, 0.55f, 0.4f};
+static RenderTarget sceneTargets[RESOLUTION_LEVELS];
+static int resolutionLevel = 0;
+static bool resolutionEnabled = false;
+static unsigned long resolutionChanges = 0;
+static unsigned long resolutionBudget = (1000000000UL * RESOLUTION_MARGIN) / RESOLUTION_REFRESH;
+
+/* frame interval : GPU timer queries don't see the rasterisation of software GL (llvmpipe) */
+static unsigned long nbFrames = 0;
+static unsigned long lastFrameEnd = 0;
+
+static unsigned long windowTotal = 0;
+static int windowSamples = 0;
+static int windowsInBudget = 0;
+static int probeDelay = RESOLUTION_PROBE;
+static bool probing = false;
+
+/*/////////////////////////////////////////
+ //				RESOLUTION FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Enable the resolution scaling if the backend is OpenGL and the context can render into textures.
+ * The frame budget is the refresh period of the display : SDL 1.2 can't tell it, the player does.
+ * Must be called once the GL context exists.
+ * @param	int	refreshRate	the refresh rate of the display in Hz, RESOLUTION_REFRESH if not positive
+ */
+void initResolution(int refreshRate) {
+	refreshRate = refreshRate > 0 ? refreshRate : RESOLUTION_REFRESH;
+	resolutionBudget = (1000000000UL * RESOLUTION_MARGIN) / refreshRate;
+	resolutionEnabled = renderer->offscreen && renderTargetSupported();
+	resolutionLevel = 0;
+	nbFrames = 0;
+}
+
+/**
+ * Change the internal resolution and start a new measure window.
+ * @param	int	level	index in resolutionScales, 0 is the window resolution
+ */
+void setResolutionLevel(int level) {
+	resolutionLevel = level;
+	windowTotal = 0;
+	windowSamples = 0;
+	++resolutionChanges;
+}
+
+/**
+ * Give the current internal resolution, for the profiler overlay.
+ * @param		unsigned long*	changes	the number of changes since the start
+ * @return	float										the scale of the window resolution used
+ */
+float resolutionScale(unsigned long *changes) {
+	*changes = resolutionChanges;
+	return resolutionScales[resolutionLevel];
+}
+
+/**
+ * Start drawing a scaled frame : everything until endScaledFrame goes into the
+ * target of the current resolution, in logical coordinates as usual.
+ */
+void beginScaledFrame() {
+	RenderTarget *target = &sceneTargets[resolutionLevel];
+	Point2D topLeft, bottomRight;
+
+	/* full resolution : draw straight into the window */
+	if (!resolutionEnabled || resolutionLevel == 0) {
+		return;
+	}
+
+	if (!target->fbo) {
+		/* stretched with GL_NEAREST : linear filtering doubles the cost of the upscale on software GL */
+		if (!initRenderTarget(target, SCREEN_WIDTH * resolutionScales[resolutionLevel],
+			SCREEN_HEIGHT * resolutionScales[resolutionLevel])) {
+			resolutionEnabled = false;
+			return;
+		}
+	}
+	initPoint2D(&topLeft, 0, 0);
+	initPoint2D(&bottomRight, SCREEN_WIDTH, SCREEN_HEIGHT);
+	beginRenderTarget(target, topLeft, bottomRight);
+}
+
+/**
+ * Look at the frame interval and pick the resolution of the next frames. Every RESOLUTION_WINDOW
+ * frames : over budget, the resolution goes one level down. It goes one level up as soon as the
+ * predicted interval (proportional to the number of pixels) fits in 80% of the budget. With vsync
+ * the interval never goes under the refresh period, so a higher level is also tried after
+ * RESOLUTION_PROBE windows in budget, twice less often each time the try fails.
+ * @param	unsigned long	frameTime	the last frame interval, in nanoseconds
+ */
+void adaptResolution(unsigned long frameTime) {
+	unsigned long budget = resolutionBudget;
+	unsigned long average;
+	float ratio;
+
+	windowTotal += frameTime;
+	if (++windowSamples < RESOLUTION_WINDOW) {
+		return;
+	}
+	average = windowTotal / windowSamples;
+	windowTotal = 0;
+	windowSamples = 0;
+
+	if (average > budget) {
+		if (probing) {
+			probeDelay *= 2;
+			probing = false;
+		}
+		windowsInBudget = 0;
+		if (resolutionLevel < RESOLUTION_LEVELS - 1) {
+			setResolutionLevel(resolutionLevel + 1);
+		}
+		return;
+	}
+	if (probing) {
+		probeDelay = RESOLUTION_PROBE;
+		probing = false;
+	}
+	if (resolutionLevel == 0) {
+		return;
+	}
+	ratio = resolutionScales[resolutionLevel - 1] / resolutionScales[resolutionLevel];
+	if (average * ratio * ratio < budget * 0.8f) {
+		windowsInBudget = 0;
+		setResolutionLevel(resolutionLevel - 1);
+	} else if (++windowsInBudget >= probeDelay) {
+		windowsInBudget = 0;
+		probing = true;
+		setResolutionLevel(resolutionLevel - 1);
+	}
+}
+
+/**
+ * Finish a scaled frame : upscale the target to the window, then measure the frame interval.
+ */
+void endScaledFrame() {
+	RenderTarget *target = &sceneTargets[resolutionLevel];
+	Point2D topLeft, bottomRight;
+	unsigned long now = clockNow();
+
+	if (resolutionEnabled && resolutionLevel != 0) {
+		endRenderTarget();
+		initPoint2D(&topLeft, 0, 0);
+		initPoint2D(&bottomRight, SCREEN_WIDTH, SCREEN_HEIGHT);
+		drawRenderTarget(target, topLeft, bottomRight);
+	}
+
+	/* a long interval is a pause, not a slow frame */
+	if (nbFrames > 0 && now - lastFrameEnd < 250000000UL) {
+		adaptResolution(now - lastFrameEnd);
+	}
+	lastFrameEnd = now;
+	++nbFrames;
+}
+
+/**
+ * Free the targets of every resolution.
+ */
+void freeResolution() {
+	int i;
+	for (i = 0; i < RESOLUTION_LEVELS; ++i) {
+		freeRenderTarget(&sceneTargets[i]);
+	}
+}
@@ -0,0 +1,289 @@
+/**
+ * @file		rewind.c
+ *       		rewind functions library. Practice matches against GladOS keep their last
+ * 			    REWIND_SECONDS seconds, and holding backspace plays them backwards (not with a
+ * 			    peer, clients or bots : they only get the states played forwards).
+ * 			    - each tick the state (players, balls, brick status, state hash) is written in an
+ * 			      image, and only the bytes changed since the previous tick are kept : the XOR of
+ * 			      both images, its zero runs skipped (RLE) in a byte ring of REWIND_POOL_SIZE.
+ * 			    - every REWIND_KEYFRAME_TICKS ticks the whole image is kept instead (a keyframe).
+ * 			      When the ring is full, the oldest keyframe and its deltas are dropped together.
+ * 			    - going back one tick XORs the delta of the tick into the current image again,
+ * 			      the image before a keyframe is rebuilt from the previous keyframe.
+ * 			    The bricks only keep their status : their position comes from the tick, like
+ * 			    on the clients, and their tree is built again.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static bool rewindOpen = false;
+static GridBrick rewindGrid;
+static int rewindGridWidth, rewindGridHeight, rewindPlayers, rewindBalls;
+
+static unsigned char rewindPool[REWIND_POOL_SIZE];
+static unsigned long poolHead;
+static RewindFrame rewindFrames[REWIND_FRAMES];
+static unsigned long frameHead, frameTail;
+
+/* the image of the last frame of the ring, and the one being written */
+static unsigned char *image = NULL, *scratch = NULL;
+static int imageSize = 0;
+
+/*/////////////////////////////////////////
+ //					IMAGE FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Write the state in an image : players, balls, brick status then state hash.
+ * @param	unsigned char*	output	the image, imageSize bytes
+ */
+void captureRewindImage(unsigned char *output) {
+	StateHash hash;
+	int i, j;
+
+	memcpy(output, players, rewindPlayers * sizeof(Player));
+	output += rewindPlayers * sizeof(Player);
+	memcpy(output, balls, rewindBalls * sizeof(Ball));
+	output += rewindBalls * sizeof(Ball);
+	for (i = 0; i < rewindGridHeight; ++i) {
+		for (j = 0; j < rewindGridWidth; ++j) {
+			*output++ = rewindGrid[i][j].status;
+		}
+	}
+	saveStateHash(&hash);
+	memcpy(output, &hash, sizeof(StateHash));
+}
+
+/**
+ * Put the state of an image back : the bricks take their status and the position of the tick.
+ * @param	unsigned char const*	input	the image
+ * @param	long									tick	the tick of the image
+ */
+void applyRewindImage(unsigned char const *input, long tick) {
+	StateHash hash;
+	Brick *brick;
+	int i, j;
+
+	memcpy(players, input, rewindPlayers * sizeof(Player));
+	input += rewindPlayers * sizeof(Player);
+	memcpy(balls, input, rewindBalls * sizeof(Ball));
+	input += rewindBalls * sizeof(Ball);
+	for (i = 0; i < rewindGridHeight; ++i) {
+		for (j = 0; j < rewindGridWidth; ++j) {
+			brick = &rewindGrid[i][j];
+			brick->status = *input++;
+			brick->phase = tick % (BRICK_SLIDE_PERIOD * BRICK_ORBIT_PERIOD);
+		}
+	}
+	memcpy(&hash, input, sizeof(StateHash));
+	restoreStateHash(&hash);
+	moveBricks(rewindGrid, rewindGridWidth, rewindGridHeight, 0);
+	buildBrickTree(rewindGrid, rewindGridWidth, rewindGridHeight);
+}
+
+/*/////////////////////////////////////////
+ //					DELTA FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Write the XOR of two images in the ring : a zero run length, a literal run length and the
+ * literal bytes, until the end of the images.
+ * @param		unsigned char const*	a	the new image
+ * @param		unsigned char const*	b	the previous image, NULL for a keyframe
+ * @return	int											the number of bytes written
+ */
+int encodeRewindDelta(unsigned char const *a, unsigned char const *b) {
+	unsigned long start = poolHead;
+	int position = 0, run;
+
+	while (position < imageSize) {
+		for (run = 0; run < 255 && position < imageSize && (a[position] ^ (b != NULL ? b[position] : 0)) == 0; ++run) {
+			++position;
+		}
+		rewindPool[poolHead++ & (REWIND_POOL_SIZE - 1)] = run;
+		for (run = 0; run < 255 && position + run < imageSize
+			&& (a[position + run] ^ (b != NULL ? b[position + run] : 0)) != 0; ++run);
+		rewindPool[poolHead++ & (REWIND_POOL_SIZE - 1)] = run;
+		for (; run > 0; --run, ++position) {
+			rewindPool[poolHead++ & (REWIND_POOL_SIZE - 1)] = a[position] ^ (b != NULL ? b[position] : 0);
+		}
+	}
+	return poolHead - start;
+}
+
+/**
+ * XOR a frame of the ring into an image : the delta of a frame goes from the previous image
+ * to the image of the frame and back, a keyframe on a blank image gives its image.
+ * @param	RewindFrame const*	frame		the frame
+ * @param	unsigned char*			output	the image
+ */
+void applyRewindDelta(RewindFrame const *frame, unsigned char *output) {
+	unsigned long read = frame->offset;
+	int position = 0, run;
+
+	while (position < imageSize) {
+		position += rewindPool[read++ & (REWIND_POOL_SIZE - 1)];
+		for (run = rewindPool[read++ & (REWIND_POOL_SIZE - 1)]; run > 0; --run) {
+			output[position++] ^= rewindPool[read++ & (REWIND_POOL_SIZE - 1)];
+		}
+	}
+}
+
+/**
+ * Rebuild the image of a frame from the keyframe before it.
+ * @param	unsigned long		index		the frame
+ * @param	unsigned char*	output	the image
+ */
+void decodeRewindFrame(unsigned long index, unsigned char *output) {
+	unsigned long key = index;
+
+	while (!rewindFrames[key % REWIND_FRAMES].keyframe) {
+		--key;
+	}
+	memset(output, 0, imageSize);
+	for (; key <= index; ++key) {
+		applyRewindDelta(&rewindFrames[key % REWIND_FRAMES], output);
+	}
+}
+
+/*/////////////////////////////////////////
+ //					RING FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Keep the next matches, or stop keeping them.
+ * @param	GridBrick	grid				the 2 dimensional brick grid, NULL to stop
+ * @param	int				gridWidth		the number of columns in game
+ * @param	int				gridHeight	the number of lines
+ * @param	int				nbPlayers		total number of players in game
+ * @param	int				nbBalls			the number of balls in game
+ */
+void resetRewind(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls) {
+	int size = (nbPlayers * sizeof(Player)) + (nbBalls * sizeof(Ball)) + (gridWidth * gridHeight) + sizeof(StateHash);
+
+	rewindOpen = grid != NULL;
+	if (!rewindOpen) {
+		return;
+	}
+	if (size > imageSize) {
+		free(image);
+		free(scratch);
+		if ((image = malloc(size)) == NULL || (scratch = malloc(size)) == NULL) {
+			exit(MALLOC_ERROR);
+		}
+	}
+	imageSize = size;
+	rewindGrid = grid;
+	rewindGridWidth = gridWidth;
+	rewindGridHeight = gridHeight;
+	rewindPlayers = nbPlayers;
+	rewindBalls = nbBalls;
+	poolHead = 0;
+	frameHead = 0;
+	frameTail = 0;
+}
+
+/**
+ * Know if the match can be played backwards.
+ * @return	bool	true if it can
+ */
+bool rewindActive() {
+	return rewindOpen;
+}
+
+/**
+ * Drop the oldest keyframe and its deltas.
+ */
+void dropRewindSegment() {
+	do {
+		++frameTail;
+	} while (frameTail != frameHead && !rewindFrames[frameTail % REWIND_FRAMES].keyframe);
+}
+
+/**
+ * Keep the state after a tick. Only called by the simulation thread.
+ * @param	long	tick	the ticks played in the match
+ */
+void pushRewind(long tick) {
+	RewindFrame *frame;
+	unsigned char *swap;
+	/* the most a delta can take : a 2 bytes header for each changed byte */
+	int worst = (3 * imageSize) + 2;
+
+	if (!rewindOpen) {
+		return;
+	}
+	while (frameTail != frameHead && (frameHead - frameTail >= REWIND_FRAMES
+		|| poolHead + worst - rewindFrames[frameTail % REWIND_FRAMES].offset > REWIND_POOL_SIZE)) {
+		dropRewindSegment();
+	}
+
+	captureRewindImage(scratch);
+	frame = &rewindFrames[frameHead % REWIND_FRAMES];
+	frame->tick = tick;
+	frame->offset = poolHead;
+	frame->keyframe = frameHead == frameTail
+		|| tick - rewindFrames[(frameHead - 1) % REWIND_FRAMES].keyTick >= REWIND_KEYFRAME_TICKS;
+	frame->keyTick = frame->keyframe ? tick : rewindFrames[(frameHead - 1) % REWIND_FRAMES].keyTick;
+	frame->size = encodeRewindDelta(scratch, frame->keyframe ? NULL : image);
+	++frameHead;
+
+	swap = image;
+	image = scratch;
+	scratch = swap;
+}
+
+/**
+ * Go back one tick : the last frame is dropped and the state of the one before is put back.
+ * Only called by the simulation thread.
+ * @param		long*	tick	the ticks played in the match, set to the ones of the state put back
+ * @return	bool				false if there is nothing older
+ */
+bool stepRewind(long *tick) {
+	RewindFrame const *last;
+
+	if (!rewindOpen || frameHead - frameTail < 2) {
+		return false;
+	}
+	last = &rewindFrames[(frameHead - 1) % REWIND_FRAMES];
+	if (last->keyframe) {
+		decodeRewindFrame(frameHead - 2, image);
+	} else {
+		applyRewindDelta(last, image);
+	}
+	poolHead = last->offset;
+	--frameHead;
+
+	*tick = rewindFrames[(frameHead - 1) % REWIND_FRAMES].tick;
+	applyRewindImage(image, *tick);
+	return true;
+}
+
+/**
+ * Give the seconds kept and the memory they take.
+ * @param	double*					seconds	the seconds of play kept
+ * @param	unsigned long*	bytes		the bytes of the ring used
+ */
+void rewindUsage(double *seconds, unsigned long *bytes) {
+	*seconds = 0;
+	*bytes = 0;
+	if (frameHead == frameTail) {
+		return;
+	}
+	*seconds = (rewindFrames[(frameHead - 1) % REWIND_FRAMES].tick - rewindFrames[frameTail % REWIND_FRAMES].tick)
+		* SIM_TICK_DURATION / 1000.0;
+	*bytes = poolHead - rewindFrames[frameTail % REWIND_FRAMES].offset;
+}
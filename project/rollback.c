@@ -0,0 +1,386 @@
+/**
+ * @file		rollback.c
+ *       		rollback functions library. Play a match between two machines of a LAN without waiting
+ * 			    for the keys of the other one (GGPO style), KASSPONG_ROLLBACK_PEER=host:port :
+ * 			    - each tick is played at once with the local keys and the predicted remote keys
+ * 			      (the last ones received), the state before it is saved in a ring of
+ * 			      ROLLBACK_FRAMES frames (saveSimulation : players, balls, bricks, brick tree).
+ * 			    - each tick the local keys of every tick the peer didn't acknowledge are sent again,
+ * 			      with the number of remote ticks known : a lost packet costs nothing.
+ * 			    - when remote keys differ from the prediction, the state before the first wrong tick
+ * 			      is restored and every tick since is played again within the same tick, without
+ * 			      the brick bursts (they were queued the first time).
+ * 			    - a peer more than ROLLBACK_WINDOW ticks ahead of the keys it received waits.
+ * 			    - each packet carries the state hash of the last tick both peers played with
+ * 			      every key known : a different hash there is a desync, printed at once.
+ * 			    Both machines play the same level, mode and seed, each with its own seats
+ * 			    (KASSPONG_ROLLBACK_SEATS=13 : seats 1 and 3 here, the others there).
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static NetSocket rollbackSocket;
+static bool rollbackOpen = false;
+static Uint32 peerHost;
+static Uint16 peerPort;
+static unsigned int localMask, remoteMask;
+
+static RollbackFrame frames[ROLLBACK_FRAMES];
+static int framesBalls = 0;
+static int rollbackPlayers;
+static unsigned int rollbackMatch = 0;
+
+static long current;
+static long remoteKnown;
+static long localAcked;
+static unsigned int prediction;
+static long mispredicted;
+static long peerHashTick;
+static Uint64 peerHash;
+
+static long rollbacks, resimulatedTicks, stalls, hashesChecked, desyncTick;
+static unsigned long longestRollback;
+
+/*/////////////////////////////////////////
+ //				CONNECTION FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Play the next matches with a peer.
+ * @param	Uint16				localPort		the local UDP port
+ * @param	Uint32				host				the peer address, network byte order
+ * @param	Uint16				remotePort	the peer port, network byte order
+ * @param	unsigned int	seats				the local seats, bit 0 for the first seat
+ */
+void openRollback(Uint16 localPort, Uint32 host, Uint16 remotePort, unsigned int seats) {
+	int seat;
+
+	closeRollback();
+	if (!openSocket(&rollbackSocket, localPort)) {
+		return;
+	}
+	peerHost = host;
+	peerPort = remotePort;
+	localMask = 0;
+	for (seat = 0; seat < 4; ++seat) {
+		if ((seats >> seat) & 1) {
+			localMask |= ACTION_MINUS(seat) | ACTION_PLUS(seat);
+		}
+	}
+	remoteMask = ~localMask & 0xFF;
+	rollbackOpen = true;
+}
+
+/**
+ * Play the next matches alone again.
+ */
+void closeRollback() {
+	int i;
+
+	if (!rollbackOpen) {
+		return;
+	}
+	closeSocket(&rollbackSocket);
+	for (i = 0; i < ROLLBACK_FRAMES; ++i) {
+		free(frames[i].state.balls);
+		frames[i].state.balls = NULL;
+	}
+	framesBalls = 0;
+	rollbackOpen = false;
+}
+
+/**
+ * Know if the matches are played with a peer.
+ * @return	bool	true if they are
+ */
+bool rollbackActive() {
+	return rollbackOpen;
+}
+
+/**
+ * Start a new match with the peer, from tick 0.
+ * @param	int	nbPlayers	total number of players in game
+ * @param	int	nbBalls		the number of balls in game
+ */
+void resetRollback(int nbPlayers, int nbBalls) {
+	int i;
+
+	if (!rollbackOpen) {
+		return;
+	}
+	if (nbBalls > framesBalls) {
+		for (i = 0; i < ROLLBACK_FRAMES; ++i) {
+			free(frames[i].state.balls);
+			if ((frames[i].state.balls = malloc(nbBalls * sizeof(Ball))) == NULL) {
+				exit(MALLOC_ERROR);
+			}
+		}
+		framesBalls = nbBalls;
+	}
+	for (i = 0; i < ROLLBACK_FRAMES; ++i) {
+		frames[i].tick = -1;
+		frames[i].remoteTick = -1;
+	}
+	rollbackPlayers = nbPlayers;
+	rollbackMatch = (rollbackMatch + 1) & 0xFF;
+	current = 0;
+	remoteKnown = 0;
+	localAcked = 0;
+	prediction = 0;
+	mispredicted = -1;
+	peerHashTick = -1;
+	rollbacks = 0;
+	resimulatedTicks = 0;
+	stalls = 0;
+	hashesChecked = 0;
+	desyncTick = -1;
+	longestRollback = 0;
+}
+
+/*/////////////////////////////////////////
+ //					INPUTS FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Read the keys of the peer. A tick already played with other keys than the ones received
+ * is remembered in mispredicted.
+ */
+void receiveRemoteInputs() {
+	unsigned char data[NET_PACKET_SIZE];
+	RollbackFrame *frame;
+	BitStream stream;
+	Uint32 host;
+	Uint16 port;
+	Uint64 hash;
+	unsigned int keys;
+	long ack, tick, hashTick;
+	int length, count;
+
+	flushPackets(&rollbackSocket);
+	while ((length = receivePacket(&rollbackSocket, &host, &port, data)) != -1) {
+		initBitStream(&stream, data, length);
+		if (host != peerHost || port != peerPort || readBits(&stream, 16) != NET_PROTOCOL
+			|| readBits(&stream, 2) != NET_ROLLBACK || readBits(&stream, 8) != rollbackMatch) {
+			continue;
+		}
+		ack = readBits(&stream, 32);
+		hashTick = readBits(&stream, 32);
+		hash = (Uint64)readBits(&stream, 32) << 32;
+		hash |= readBits(&stream, 32);
+		tick = readBits(&stream, 32);
+		count = readBits(&stream, 5);
+		if (stream.overflow || ack > current || tick + count > remoteKnown + ROLLBACK_FRAMES) {
+			continue;
+		}
+		localAcked = ack > localAcked ? ack : localAcked;
+		if (hashTick > peerHashTick) {
+			peerHashTick = hashTick;
+			peerHash = hash;
+		}
+		for (; count > 0; --count, ++tick) {
+			keys = readBits(&stream, 8) & remoteMask;
+			if (stream.overflow || tick < remoteKnown) {
+				continue;
+			}
+			frame = &frames[tick % ROLLBACK_FRAMES];
+			frame->remoteTick = tick;
+			frame->remote = keys;
+			if (tick < current && frame->tick == tick && (frame->used & remoteMask) != keys
+				&& (mispredicted < 0 || tick < mispredicted)) {
+				mispredicted = tick;
+			}
+		}
+	}
+	while (frames[remoteKnown % ROLLBACK_FRAMES].remoteTick == remoteKnown) {
+		prediction = frames[remoteKnown % ROLLBACK_FRAMES].remote;
+		++remoteKnown;
+	}
+}
+
+/**
+ * Give the state hash at a tick still in the ring, or at the tick being played.
+ * @param		long		tick	the tick
+ * @param		Uint64*	hash	the hash found
+ * @return	bool					false if the tick is not in the ring anymore
+ */
+bool rollbackHash(long tick, Uint64 *hash) {
+	MatchState const *state;
+
+	if (tick == current) {
+		*hash = matchHash(current);
+		return true;
+	}
+	if ((state = rollbackState(tick)) == NULL) {
+		return false;
+	}
+	*hash = savedMatchHash(&state->hash, tick);
+	return true;
+}
+
+/**
+ * Compare the last hash of the peer with ours, once both are final.
+ */
+void checkPeerHash() {
+	Uint64 hash;
+
+	if (peerHashTick < 0 || peerHashTick > rollbackConfirmedTick() || !rollbackHash(peerHashTick, &hash)) {
+		return;
+	}
+	++hashesChecked;
+	if (hash != peerHash && desyncTick < 0) {
+		desyncTick = peerHashTick;
+		printf("ERROR : The peer is out of sync since tick %ld at most.\n", desyncTick);
+	}
+	peerHashTick = -1;
+}
+
+/**
+ * Send the local keys of every tick the peer didn't acknowledge, the remote ticks known
+ * and the hash of the last final state.
+ */
+void sendLocalInputs() {
+	unsigned char data[NET_PACKET_SIZE];
+	BitStream stream;
+	Uint64 hash = 0;
+	long tick, confirmed = rollbackConfirmedTick();
+
+	rollbackHash(confirmed, &hash);
+	initBitStream(&stream, data, NET_PACKET_SIZE);
+	writeBits(&stream, NET_PROTOCOL, 16);
+	writeBits(&stream, NET_ROLLBACK, 2);
+	writeBits(&stream, rollbackMatch, 8);
+	writeBits(&stream, remoteKnown, 32);
+	writeBits(&stream, confirmed, 32);
+	writeBits(&stream, (Uint32)(hash >> 32), 32);
+	writeBits(&stream, (Uint32)(hash & 0xFFFFFFFFU), 32);
+	writeBits(&stream, localAcked, 32);
+	writeBits(&stream, current - localAcked, 5);
+	for (tick = localAcked; tick < current; ++tick) {
+		writeBits(&stream, frames[tick % ROLLBACK_FRAMES].local, 8);
+	}
+	sendPacket(&rollbackSocket, peerHost, peerPort, data, bitStreamBytes(&stream));
+	flushPackets(&rollbackSocket);
+}
+
+/*/////////////////////////////////////////
+ //				ROLLBACK FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Play ticks again from a saved state, with the remote keys known now.
+ * @param	long	from	the first tick to play again, its state is in the ring
+ * @param	long	to		the tick after the last one
+ */
+void resimulate(long from, long to) {
+	RollbackFrame *frame;
+	long tick;
+
+	restoreSimulation(&frames[from % ROLLBACK_FRAMES].state);
+	muteBrickBursts(true);
+	for (tick = from; tick < to; ++tick) {
+		frame = &frames[tick % ROLLBACK_FRAMES];
+		if (tick != from) {
+			saveSimulation(&frame->state);
+		}
+		frame->used = frame->local | (frame->remoteTick == tick ? frame->remote : (prediction & remoteMask));
+		simulationTick(frame->used);
+	}
+	muteBrickBursts(false);
+}
+
+/**
+ * Play the next tick with the peer : correct the ticks played with wrong remote keys,
+ * then play the tick with the predicted ones. Only called by the simulation thread.
+ * @param		unsigned int	actions	the actions of the tick, only the local seats are kept
+ * @return	bool									false if the tick waits for the peer
+ */
+bool advanceRollback(unsigned int actions) {
+	RollbackFrame *frame;
+	unsigned long start;
+	bool over = false;
+	int i;
+
+	receiveRemoteInputs();
+	if (mispredicted >= 0) {
+		start = clockNow();
+		resimulate(mispredicted, current);
+		start = clockNow() - start;
+		longestRollback = start > longestRollback ? start : longestRollback;
+		resimulatedTicks += current - mispredicted;
+		++rollbacks;
+		mispredicted = -1;
+	}
+	checkPeerHash();
+
+	/* the end of the match : nothing more to play, the peer must get the last keys */
+	for (i = 0; i < rollbackPlayers; ++i) {
+		over = over || players[i].life <= 0;
+	}
+	if (over || current - remoteKnown >= ROLLBACK_WINDOW || current - localAcked >= ROLLBACK_FRAMES - 1) {
+		stalls += !over;
+		for (i = over && remoteKnown == current ? NET_OVER_REPEAT : 1; i > 0; --i) {
+			sendLocalInputs();
+		}
+		return false;
+	}
+
+	frame = &frames[current % ROLLBACK_FRAMES];
+	frame->tick = current;
+	frame->local = actions & localMask;
+	saveSimulation(&frame->state);
+	frame->used = frame->local | (frame->remoteTick == current ? frame->remote : (prediction & remoteMask));
+	simulationTick(frame->used);
+	++current;
+	sendLocalInputs();
+	return true;
+}
+
+/**
+ * Give the last tick whose state is final : every key before it is known.
+ * Only called by the simulation thread.
+ * @return	long	the tick
+ */
+long rollbackConfirmedTick() {
+	return remoteKnown < current ? remoteKnown : current;
+}
+
+/**
+ * Give the state saved before a tick still in the ring.
+ * @param		long								tick	the tick
+ * @return	MatchState const*					the state, NULL if it is not in the ring anymore
+ */
+MatchState const *rollbackState(long tick) {
+	RollbackFrame const *frame = &frames[tick % ROLLBACK_FRAMES];
+	return tick >= 0 && frame->tick == tick ? &frame->state : NULL;
+}
+
+/**
+ * Print how many ticks were played again this match.
+ */
+void printRollbackStats() {
+	if (!rollbackOpen) {
+		return;
+	}
+	printf("Rollbacks this match : %ld (%ld ticks played again, longest %.0f us), %ld ticks waited for the peer\n",
+		rollbacks, resimulatedTicks, longestRollback / 1000.0, stalls);
+	if (desyncTick >= 0) {
+		printf("State hashes checked : %ld, out of sync since tick %ld\n", hashesChecked, desyncTick);
+	} else {
+		printf("State hashes checked : %ld, always in sync\n", hashesChecked);
+	}
+}
@@ -0,0 +1,241 @@
+/**
+ * @file		server.c
+ *       		server functions library. Play the matches for clients on other machines,
+ * 			    KASSPONG_SERVER=port : the simulation thread stays the only authority.
+ * 			    - a client sends its keys (NET_INPUT) : input sequence, the last snapshot it
+ * 			      received and the 2 keys of its seat. Each seat belongs to the first address that
+ * 			      sends for it, until it is silent for NET_TIMEOUT ms. Its keys are held until the
+ * 			      next ones, like the keys of the keyboard.
+ * 			    - every NET_SNAPSHOT_TICKS ticks each client gets the state (NET_SNAPSHOT), written
+ * 			      against the last snapshot it acknowledged if it is still in the history,
+ * 			      in full otherwise. Nothing is resent : the next snapshot replaces a lost one.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static NetSocket server;
+static bool serverOpen = false;
+static NetPeer peers[4];
+static NetHistory sent;
+static NetState lastState;
+static Uint16 serverSequence = 0;
+static int ticksSinceSend = 0;
+
+/*/////////////////////////////////////////
+ //					SERVER FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Start listening to the clients.
+ * @param	Uint16	port	the UDP port
+ */
+void openServer(Uint16 port) {
+	closeServer();
+	memset(peers, 0, sizeof(peers));
+	memset(&sent, 0, sizeof(sent));
+	memset(&lastState, 0, sizeof(lastState));
+	ticksSinceSend = 0;
+	serverOpen = openSocket(&server, port);
+}
+
+/**
+ * Stop listening, the seats are played by the keyboard again.
+ */
+void closeServer() {
+	if (!serverOpen) {
+		return;
+	}
+	closeSocket(&server);
+	serverOpen = false;
+}
+
+/**
+ * Know if the clients are listened to.
+ * @return	bool	true if the server is open
+ */
+bool serverActive() {
+	return serverOpen;
+}
+
+/**
+ * Give the client of a seat, for the statistics.
+ * @param		int							seat	the seat, from 0
+ * @return	NetPeer const*				the client, NULL if the server is closed
+ */
+NetPeer const *serverPeer(int seat) {
+	return serverOpen ? &peers[seat] : NULL;
+}
+
+/**
+ * Give a state sent, to check what a client received.
+ * @param		Uint16					sequence	the sequence of the snapshot
+ * @return	NetState const*						the state, NULL if it is not kept anymore
+ */
+NetState const *serverState(Uint16 sequence) {
+	return findNetState(&sent, sequence);
+}
+
+/**
+ * Read the keys and acknowledgements of the clients. Only called by the simulation thread.
+ */
+void receiveInputs() {
+	unsigned char data[NET_PACKET_SIZE];
+	BitStream stream;
+	NetPeer *peer;
+	Uint32 host, now = SDL_GetTicks();
+	Uint16 port, inputSequence, ack;
+	bool hasAck;
+	unsigned int keys;
+	int length, seat;
+
+	flushPackets(&server);
+	for (seat = 0; seat < 4; ++seat) {
+		if (peers[seat].connected && now - peers[seat].lastHeard > NET_TIMEOUT) {
+			peers[seat].connected = false;
+		}
+	}
+	while ((length = receivePacket(&server, &host, &port, data)) != -1) {
+		initBitStream(&stream, data, length);
+		if (readBits(&stream, 16) != NET_PROTOCOL || readBits(&stream, 2) != NET_INPUT) {
+			continue;
+		}
+		seat = readBits(&stream, 2);
+		inputSequence = readBits(&stream, 16);
+		hasAck = readBits(&stream, 1);
+		ack = readBits(&stream, 16);
+		keys = readBits(&stream, 2);
+		peer = &peers[seat];
+		if (stream.overflow || (peer->connected && (peer->host != host || peer->port != port))) {
+			continue;
+		}
+		if (!peer->connected) {
+			memset(peer, 0, sizeof(NetPeer));
+			peer->connected = true;
+			peer->host = host;
+			peer->port = port;
+			peer->inputSequence = inputSequence - 1;
+		}
+		peer->lastHeard = now;
+		peer->bytesReceived += length;
+		if (hasAck && (!peer->hasAck || newerSequence(ack, peer->acked))) {
+			peer->hasAck = true;
+			peer->acked = ack;
+		}
+		/* older keys arriving late are ignored */
+		if (newerSequence(inputSequence, peer->inputSequence)) {
+			peer->inputSequence = inputSequence;
+			peer->held = keys;
+			peer->pressed |= keys;
+		}
+	}
+}
+
+/**
+ * Replace the keys of the seats played by a client by its keys.
+ * A key pressed then released between two ticks still moves the bar once.
+ * @param		unsigned int	actions	the actions of the tick
+ * @return	unsigned int					the actions of the tick
+ */
+unsigned int serverActions(unsigned int actions) {
+	int seat;
+
+	if (!serverOpen) {
+		return actions;
+	}
+	receiveInputs();
+	for (seat = 0; seat < 4; ++seat) {
+		if (!peers[seat].connected) {
+			continue;
+		}
+		actions &= ~(ACTION_MINUS(seat) | ACTION_PLUS(seat));
+		actions |= (peers[seat].held | peers[seat].pressed) << (2 * seat);
+		peers[seat].pressed = 0;
+	}
+	return actions;
+}
+
+/**
+ * Send a state to every client, each against its own baseline.
+ * @param	NetState const*	state		the state
+ * @param	int							copies	the number of packets per client, more than 1 for the last one
+ */
+void sendServerState(NetState const *state, int copies) {
+	static NetState const none;
+	unsigned char data[NET_PACKET_SIZE];
+	NetState const *baseline;
+	BitStream stream;
+	int seat, i;
+
+	++serverSequence;
+	storeNetState(&sent, state, serverSequence);
+	for (seat = 0; seat < 4; ++seat) {
+		if (!peers[seat].connected) {
+			continue;
+		}
+		baseline = peers[seat].hasAck ? findNetState(&sent, peers[seat].acked) : NULL;
+		initBitStream(&stream, data, NET_PACKET_SIZE);
+		writeBits(&stream, NET_PROTOCOL, 16);
+		writeBits(&stream, NET_SNAPSHOT, 2);
+		writeBits(&stream, serverSequence, 16);
+		writeBits(&stream, baseline != NULL, 1);
+		if (baseline != NULL) {
+			writeBits(&stream, peers[seat].acked, 16);
+		} else {
+			++peers[seat].fullSnapshots;
+		}
+		writeNetState(&stream, state, baseline != NULL ? baseline : &none);
+		for (i = 0; i < copies; ++i) {
+			sendPacket(&server, peers[seat].host, peers[seat].port, data, bitStreamBytes(&stream));
+			peers[seat].bytesSent += bitStreamBytes(&stream);
+			++peers[seat].packetsSent;
+		}
+		++peers[seat].snapshotsSent;
+	}
+	flushPackets(&server);
+}
+
+/**
+ * Send the state of a tick to the clients every NET_SNAPSHOT_TICKS ticks, and the end of the
+ * match at once. Only called by the simulation thread.
+ * @param	RenderSnapshot const*	snapshot	the snapshot just filled
+ */
+void publishServerState(RenderSnapshot const *snapshot) {
+	if (!serverOpen) {
+		return;
+	}
+	captureNetState(&lastState, snapshot);
+	if (++ticksSinceSend >= NET_SNAPSHOT_TICKS || lastState.over) {
+		ticksSinceSend = 0;
+		sendServerState(&lastState, lastState.over ? NET_OVER_REPEAT : 1);
+	}
+}
+
+/**
+ * Keep the clients up to date while the match doesn't tick (pause, end of the match) :
+ * the last state is sent again every NET_SNAPSHOT_TICKS ticks. Only called by the simulation thread.
+ */
+void idleServer() {
+	if (!serverOpen) {
+		return;
+	}
+	receiveInputs();
+	if (++ticksSinceSend >= NET_SNAPSHOT_TICKS) {
+		ticksSinceSend = 0;
+		sendServerState(&lastState, 1);
+	}
+}
@@ -0,0 +1,235 @@
+/**
+ * @file		shared.c
+ *       		shared functions library. Export the live match to other processes (bots written in
+ * 			    any language) through a POSIX shared memory segment, KASSPONG_SHM=/name :
+ * 			    - the SharedState is written every tick under a seqlock : sequence is odd while the
+ * 			      game writes. A reader reads sequence (even), copies the state, then reads sequence
+ * 			      again and starts over if it changed. The game never waits for the readers.
+ * 			    - one SharedRing per seat : a bot sets attached, then pushes its keys (SHARED_MINUS,
+ * 			      SHARED_PLUS) at actions[head % SHARED_RING_SIZE] and increments head. Each tick
+ * 			      the game takes them instead of the keyboard of that seat, and increments tail.
+ * 			      The last keys pushed are held until the next ones, like a key kept pressed.
+ * 			    - the bot increments heartbeat for every tick it sees. A heartbeat that doesn't
+ * 			      move for SHARED_STALE_TICKS ticks is a dead bot : its seat goes back to the
+ * 			      keyboard (or GladOS) until the heartbeat moves again.
+ * 			    - a living bot also takes the seat of GladOS (the second one in a match against
+ * 			      GladOS) : GladOS stops moving that bar while the bot is attached and alive.
+ * 			    The brick bitmap has one bit per living brick, line by line (bit i * gridWidth + j).
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static SharedSegment *segment = NULL;
+static char *segmentName = NULL;
+static unsigned int sharedHeld[4];
+static Uint32 sharedHeartbeats[4];
+static int sharedSilentTicks[4];
+static unsigned int sharedLiving = 0;
+
+/*/////////////////////////////////////////
+ //					SEGMENT FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Create the shared memory segment and start exporting the matches into it.
+ * @param	char const*	name	the segment name, "/kasspong" for example
+ */
+void openSharedState(char const *name) {
+	int fd;
+
+	closeSharedState();
+	if ((fd = shm_open(name, O_CREAT | O_RDWR, 0600)) == -1) {
+		printf("ERROR : Impossible to open the shared memory '%s'.\n", name);
+		return;
+	}
+	if (ftruncate(fd, sizeof(SharedSegment)) == -1
+		|| (segment = mmap(NULL, sizeof(SharedSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+		printf("ERROR : Impossible to map the shared memory '%s'.\n", name);
+		segment = NULL;
+		close(fd);
+		shm_unlink(name);
+		return;
+	}
+	close(fd);
+	if ((segmentName = malloc(strlen(name) + 1)) == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	strcpy(segmentName, name);
+
+	memset(segment, 0, sizeof(SharedSegment));
+	memset(sharedHeld, 0, sizeof(sharedHeld));
+	memset(sharedHeartbeats, 0, sizeof(sharedHeartbeats));
+	memset(sharedSilentTicks, 0, sizeof(sharedSilentTicks));
+	segment->state.version = SHARED_VERSION;
+	__atomic_store_n(&segment->state.magic, SHARED_MAGIC, __ATOMIC_RELEASE);
+}
+
+/**
+ * Stop exporting and remove the segment (the processes still mapping it keep it until they unmap it).
+ */
+void closeSharedState() {
+	if (segment == NULL) {
+		return;
+	}
+	munmap(segment, sizeof(SharedSegment));
+	shm_unlink(segmentName);
+	free(segmentName);
+	segment = NULL;
+	segmentName = NULL;
+}
+
+/**
+ * Know if the state is exported to other processes.
+ * @return	bool	true if the segment is open
+ */
+bool sharedStateActive() {
+	return segment != NULL;
+}
+
+/*/////////////////////////////////////////
+ //					EXPORT FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Write a snapshot of the match into the segment, under the seqlock. Never waits.
+ * Single writer : only the simulation thread.
+ * @param	RenderSnapshot const*	snapshot	the snapshot just filled
+ */
+void publishSharedState(RenderSnapshot const *snapshot) {
+	SharedState *state;
+	Ball const *ball;
+	Uint32 sequence;
+	int i, j;
+
+	if (segment == NULL) {
+		return;
+	}
+	state = &segment->state;
+	sequence = state->sequence;
+	__atomic_store_n(&state->sequence, sequence + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	state->tick = snapshot->tick;
+	state->over = snapshot->over;
+	state->nbPlayers = snapshot->nbPlayers;
+	state->nbBalls = snapshot->nbBalls < SHARED_MAX_BALLS ? snapshot->nbBalls : SHARED_MAX_BALLS;
+	state->gridWidth = snapshot->gridWidth;
+	state->gridHeight = snapshot->gridHeight;
+	for (i = 0; i < snapshot->nbPlayers; ++i) {
+		state->lives[i] = snapshot->players[i].life;
+		state->scores[i] = snapshot->players[i].score;
+		state->bars[i].x = snapshot->players[i].bar.center.x;
+		state->bars[i].y = snapshot->players[i].bar.center.y;
+		state->bars[i].width = snapshot->players[i].bar.width;
+		state->bars[i].horizontal = snapshot->players[i].bar.orientationHorizontal;
+	}
+	for (i = 0; i < state->nbBalls; ++i) {
+		ball = &snapshot->balls[i];
+		state->balls[i].x = ball->origin.x;
+		state->balls[i].y = ball->origin.y;
+		state->balls[i].speedX = ball->speed.x;
+		state->balls[i].speedY = ball->speed.y;
+		state->balls[i].radius = ball->radius;
+		state->balls[i].respawnTimer = ball->respawnTimer;
+		state->balls[i].bonusTimer = ball->bonusTimer;
+		state->balls[i].lastPlayerId = ball->lastPlayerId;
+	}
+	memset(state->bricks, 0, sizeof(state->bricks));
+	for (i = 0; i < snapshot->gridHeight; ++i) {
+		for (j = 0; j < snapshot->gridWidth; ++j) {
+			if (snapshot->rows[i][j].status != DESTROYED) {
+				state->bricks[((i * snapshot->gridWidth) + j) / 32] |= 1u << (((i * snapshot->gridWidth) + j) % 32);
+			}
+		}
+	}
+
+	__atomic_store_n(&state->sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+/**
+ * Forget the keys the bots held in the previous match. A dead bot stays silent.
+ */
+void resetSharedActions() {
+	memset(sharedHeld, 0, sizeof(sharedHeld));
+	sharedLiving = 0;
+}
+
+/**
+ * Know which seats a living bot played at the last sharedActions call.
+ * @return	unsigned int	bit i set if a living bot plays seat i
+ */
+unsigned int sharedSeats() {
+	return sharedLiving;
+}
+
+/**
+ * Replace the keys of the seats a living bot is attached to by the keys it pushed in its ring.
+ * A key pushed then released within the same tick still moves the bar once.
+ * Single consumer of the rings : only the simulation thread.
+ * @param		unsigned int	actions	the actions of the tick, from the keyboard
+ * @return	unsigned int					the actions of the tick
+ */
+unsigned int sharedActions(unsigned int actions) {
+	SharedRing *ring;
+	Uint32 head, tail, heartbeat;
+	unsigned int pressed;
+	int seat;
+
+	sharedLiving = 0;
+	if (segment == NULL) {
+		return actions;
+	}
+	for (seat = 0; seat < 4; ++seat) {
+		ring = &segment->rings[seat];
+		if (!__atomic_load_n(&ring->attached, __ATOMIC_ACQUIRE)) {
+			continue;
+		}
+		heartbeat = __atomic_load_n(&ring->heartbeat, __ATOMIC_ACQUIRE);
+		if (heartbeat != sharedHeartbeats[seat]) {
+			sharedHeartbeats[seat] = heartbeat;
+			sharedSilentTicks[seat] = 0;
+		} else if (sharedSilentTicks[seat] >= SHARED_STALE_TICKS) {
+			continue;
+		} else {
+			++sharedSilentTicks[seat];
+		}
+		sharedLiving |= 1u << seat;
+		head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+		tail = ring->tail;
+		/* a bot too far ahead : only its latest keys are kept */
+		if (head - tail > SHARED_RING_SIZE) {
+			tail = head - SHARED_RING_SIZE;
+		}
+		pressed = 0;
+		while (tail != head) {
+			sharedHeld[seat] = ring->actions[tail % SHARED_RING_SIZE] & (SHARED_MINUS | SHARED_PLUS);
+			pressed |= sharedHeld[seat];
+			++tail;
+		}
+		__atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+		actions &= ~(ACTION_MINUS(seat) | ACTION_PLUS(seat));
+		actions |= (sharedHeld[seat] | pressed) << (2 * seat);
+	}
+	return actions;
+}
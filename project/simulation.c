@@ -0,0 +1,350 @@
+/**
+ * @file		simulation.c
+ *       		simulation functions library. Run the PLAYTIME simulation (collisions, balls and bars
+ * 			    movements, bricks) on its own thread at a fixed rate, and publish immutable render
+ * 			    snapshots to the GL thread through a lock-free triple buffer. The bar keys come
+ * 			    from the timestamped input queue (input.c), or from the bots (shared.c) and the
+ * 			    network clients (server.c).
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_thread.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static TripleBuffer snapshots;
+static SDL_Thread *simThread = NULL;
+static int simRunning = 0;
+static int simPaused = 0;
+static int simRewinding = 0;
+static unsigned int simHeld = 0;
+
+static GridBrick simGrid;
+static int simGridWidth, simGridHeight, simNbPlayers, simNbBalls;
+static unsigned int simGladOSSeats;
+static long simTick;
+
+/*/////////////////////////////////////////
+ //				SNAPSHOT FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Allocate the balls of a snapshot and link its grid rows.
+ * @param	RenderSnapshot*	snapshot	the snapshot to initialise
+ * @param	int							nbBalls		the number of balls in game
+ */
+void initSnapshot(RenderSnapshot *snapshot, int nbBalls) {
+	int i;
+	snapshot->balls = malloc(nbBalls * sizeof(Ball));
+	if (snapshot->balls == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	for (i = 0; i < GRID_MAX_HEIGHT; ++i) {
+		snapshot->rows[i] = &snapshot->bricks[i * GRID_MAX_WIDTH];
+	}
+}
+
+/**
+ * Copy the current game state (balls, bars, bricks, HUD values) into a snapshot.
+ * @param	RenderSnapshot*	snapshot	the snapshot to fill
+ */
+void fillSnapshot(RenderSnapshot *snapshot) {
+	int i;
+
+	snapshot->tick = simTick;
+	snapshot->gridWidth = simGridWidth;
+	snapshot->gridHeight = simGridHeight;
+	snapshot->nbPlayers = simNbPlayers;
+	snapshot->nbBalls = simNbBalls;
+	snapshot->over = false;
+
+	memcpy(snapshot->balls, balls, simNbBalls * sizeof(Ball));
+	memcpy(snapshot->players, players, simNbPlayers * sizeof(Player));
+	for (i = 0; i < simGridHeight; ++i) {
+		memcpy(snapshot->rows[i], simGrid[i], simGridWidth * sizeof(Brick));
+	}
+	for (i = 0; i < simNbPlayers; ++i) {
+		snapshot->over = snapshot->over || players[i].life <= 0;
+	}
+}
+
+/**
+ * Publish the back snapshot : swap it with the middle one and flag it as fresh.
+ * Only called by the simulation thread.
+ */
+void publishSnapshot() {
+	snapshots.back = __atomic_exchange_n(&snapshots.middle, snapshots.back | SNAPSHOT_FRESH,
+		__ATOMIC_ACQ_REL) & ~SNAPSHOT_FRESH;
+}
+
+/**
+ * Get the latest published snapshot. Never blocks : if nothing new was published,
+ * the previous snapshot is returned again. Only called by the GL thread.
+ * @return	RenderSnapshot const*	the snapshot to draw
+ */
+RenderSnapshot const *consumeSnapshot() {
+	if (__atomic_load_n(&snapshots.middle, __ATOMIC_ACQUIRE) & SNAPSHOT_FRESH) {
+		snapshots.front = __atomic_exchange_n(&snapshots.middle, snapshots.front,
+			__ATOMIC_ACQ_REL) & ~SNAPSHOT_FRESH;
+	}
+	return &snapshots.buffers[snapshots.front];
+}
+
+/*/////////////////////////////////////////
+ //				SIMULATION FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Apply the queued key transitions that happened before a tick.
+ * A key pressed and released within the same tick still moves the bar once.
+ * @param		Uint32				tickTime	time of the tick (SDL_GetTicks)
+ * @param		bool					record		count the transitions in the latency histogram
+ * @return	unsigned int						the actions of the tick
+ */
+unsigned int collectActions(Uint32 tickTime, bool record) {
+	InputEvent event;
+	unsigned int pressed = 0;
+	Uint32 now = SDL_GetTicks();
+
+	while (popInput(tickTime, &event)) {
+		if (event.pressed) {
+			simHeld |= event.action;
+			pressed |= event.action;
+		} else {
+			simHeld &= ~event.action;
+		}
+		if (record) {
+			recordInputLatency(now - event.time);
+		}
+	}
+	return simHeld | pressed;
+}
+
+/**
+ * Run one simulation tick : collisions, balls and bricks movement then the players actions.
+ * @param	unsigned int	actions	the actions of the tick
+ */
+void simulationTick(unsigned int actions) {
+	PROFILE_BEGIN(PHASE_COLLISION);
+	collideBalls(simGrid, simGridWidth, simGridHeight, simNbPlayers, simNbBalls);
+	PROFILE_END(PHASE_COLLISION);
+
+	PROFILE_BEGIN(PHASE_MOVEMENT);
+	moveBalls(simNbBalls);
+	moveBricks(simGrid, simGridWidth, simGridHeight, 1);
+	/* a living bot of the shared segment takes the seat from GladOS */
+	applyPlayersActions(actions, simGladOSSeats & ~sharedSeats(), simNbPlayers, simNbBalls);
+	PROFILE_END(PHASE_MOVEMENT);
+	++simTick;
+}
+
+/**
+ * Body of the simulation thread. Ticks every SIM_TICK_DURATION ms whatever the
+ * GL thread is doing, until the match is over or the simulation is stopped.
+ * @param		void*	data	unused
+ * @return	int					0
+ */
+int simulationThread(void *data) {
+	Uint32 next = SDL_GetTicks(), now;
+	unsigned int actions;
+	bool over = false;
+
+	while (__atomic_load_n(&simRunning, __ATOMIC_ACQUIRE)) {
+		if (!over && !__atomic_load_n(&simPaused, __ATOMIC_ACQUIRE) && __atomic_load_n(&simRewinding, __ATOMIC_ACQUIRE)) {
+			/* practice : one tick back, the keys released meanwhile are not replayed */
+			collectActions(next, false);
+			stepRewind(&simTick);
+			fillSnapshot(&snapshots.buffers[snapshots.back]);
+			publishSpectatorFrame(&snapshots.buffers[snapshots.back]);
+			publishSnapshot();
+		} else if (!over && !__atomic_load_n(&simPaused, __ATOMIC_ACQUIRE)) {
+			actions = serverActions(sharedActions(collectActions(next, true)));
+			if (rollbackActive()) {
+				advanceRollback(actions);
+			} else {
+				simulationTick(actions);
+			}
+			fillSnapshot(&snapshots.buffers[snapshots.back]);
+			publishSharedState(&snapshots.buffers[snapshots.back]);
+			publishServerState(&snapshots.buffers[snapshots.back]);
+			pushRewind(simTick);
+			/* with a peer the end must be final, not predicted */
+			if (rollbackActive() && rollbackConfirmedTick() != simTick) {
+				snapshots.buffers[snapshots.back].over = false;
+			}
+			over = snapshots.buffers[snapshots.back].over;
+			publishSpectatorFrame(&snapshots.buffers[snapshots.back]);
+			publishSnapshot();
+		} else {
+			/* keep track of the keys released during the pause */
+			collectActions(next, false);
+			idleServer();
+		}
+
+		next += SIM_TICK_DURATION;
+		now = SDL_GetTicks();
+		if ((Sint32)(next - now) > 0) {
+			SDL_Delay(next - now);
+		} else if (now - next > 10 * SIM_TICK_DURATION) {
+			/* too late (machine suspended, debugger...) : don't try to catch up */
+			next = now;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Give the game objects of a new match to the simulation, without starting its thread
+ * (simulationTick can be called directly).
+ * @param	GridBrick	grid				the 2 dimensional brick grid
+ * @param	int				gridWidth		the config file gridWidth
+ * @param	int				gridHeight	the config file gridHeight
+ * @param	int				nbPlayers		total number of players in game
+ * @param	int						nbBalls			the number of balls in game
+ * @param	unsigned int	gladOSSeats	bit i set if GladOS plays seat i, the second seat against GladOS
+ */
+void setSimulationMatch(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls, unsigned int gladOSSeats) {
+	int i;
+
+	simGrid = grid;
+	simGridWidth = gridWidth;
+	simGridHeight = gridHeight;
+	simNbPlayers = nbPlayers;
+	simNbBalls = nbBalls;
+	simGladOSSeats = gladOSSeats;
+	simTick = 0;
+	simHeld = 0;
+	simPaused = 0;
+	for (i = 0; i < nbPlayers; ++i) {
+		if (gladOSSeats & (1u << i)) {
+			players[i].name = "GladOS";
+		}
+	}
+	simRewinding = 0;
+	resetStateHash(nbPlayers, nbBalls);
+	resetRollback(nbPlayers, nbBalls);
+	resetSharedActions();
+	/* practice : only the matches against GladOS on this machine are played backwards, the
+	 * clients of the server and the bots of the segment only get the states played forwards */
+	resetRewind(gladOSSeats && !rollbackActive() && !serverActive() && !sharedStateActive() ? grid : NULL,
+		gridWidth, gridHeight, nbPlayers, nbBalls);
+	pushRewind(0);
+}
+
+/**
+ * Start the simulation thread of a new match. The game objects (players, balls, grid)
+ * belong to the simulation thread until stopSimulation is called.
+ * @param	GridBrick	grid				the 2 dimensional brick grid
+ * @param	int				gridWidth		the config file gridWidth
+ * @param	int				gridHeight	the config file gridHeight
+ * @param	int				nbPlayers		total number of players in game
+ * @param	int						nbBalls			the number of balls in game
+ * @param	unsigned int	gladOSSeats	bit i set if GladOS plays seat i
+ */
+void startSimulation(GridBrick grid, int gridWidth, int gridHeight, int nbPlayers, int nbBalls, unsigned int gladOSSeats) {
+	int i;
+
+	setSimulationMatch(grid, gridWidth, gridHeight, nbPlayers, nbBalls, gladOSSeats);
+
+	for (i = 0; i < 3; ++i) {
+		initSnapshot(&snapshots.buffers[i], nbBalls);
+		fillSnapshot(&snapshots.buffers[i]);
+	}
+	snapshots.back = 0;
+	snapshots.middle = 1;
+	snapshots.front = 2;
+
+	resetInputLatency();
+	openInputQueue();
+	simRunning = 1;
+	simThread = SDL_CreateThread(simulationThread, NULL);
+	if (simThread == NULL) {
+		fprintf(stderr, "Impossible de lancer la simulation : %s\n", SDL_GetError());
+		exit(EXIT_FAILURE);
+	}
+}
+
+/**
+ * Stop and join the simulation thread, the game objects belong to the caller again.
+ */
+void stopSimulation() {
+	int i;
+	if (simThread == NULL) {
+		return;
+	}
+	__atomic_store_n(&simRunning, 0, __ATOMIC_RELEASE);
+	SDL_WaitThread(simThread, NULL);
+	simThread = NULL;
+	closeInputQueue();
+	for (i = 0; i < 3; ++i) {
+		free(snapshots.buffers[i].balls);
+		snapshots.buffers[i].balls = NULL;
+	}
+}
+
+/**
+ * Pause or resume the simulation.
+ * @param	bool	paused	true to pause
+ */
+void setSimulationPaused(bool paused) {
+	__atomic_store_n(&simPaused, paused, __ATOMIC_RELEASE);
+}
+
+/**
+ * Play the match backwards while the rewind key is held, in practice matches.
+ * @param	bool	rewinding	true while the key is held
+ */
+void setSimulationRewinding(bool rewinding) {
+	__atomic_store_n(&simRewinding, rewinding && rewindActive(), __ATOMIC_RELEASE);
+}
+
+/*/////////////////////////////////////////
+ //				ROLLBACK FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Save everything a tick changes : tick, players, balls, bricks, their tree and the state hash.
+ * @param	MatchState*	state	the state to fill, its balls allocated for the match
+ */
+void saveSimulation(MatchState *state) {
+	int i;
+
+	state->tick = simTick;
+	memcpy(state->players, players, simNbPlayers * sizeof(Player));
+	memcpy(state->balls, balls, simNbBalls * sizeof(Ball));
+	for (i = 0; i < simGridHeight; ++i) {
+		memcpy(&state->bricks[i * simGridWidth], simGrid[i], simGridWidth * sizeof(Brick));
+	}
+	saveBrickTree(&state->tree);
+	saveStateHash(&state->hash);
+}
+
+/**
+ * Put the match back in a saved state, the next tick played is the one of the state.
+ * @param	MatchState const*	state	the state saved by saveSimulation
+ */
+void restoreSimulation(MatchState const *state) {
+	int i;
+
+	simTick = state->tick;
+	memcpy(players, state->players, simNbPlayers * sizeof(Player));
+	memcpy(balls, state->balls, simNbBalls * sizeof(Ball));
+	for (i = 0; i < simGridHeight; ++i) {
+		memcpy(simGrid[i], &state->bricks[i * simGridWidth], simGridWidth * sizeof(Brick));
+	}
+	restoreBrickTree(&state->tree);
+	restoreStateHash(&state->hash);
+}
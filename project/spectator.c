@@ -0,0 +1,216 @@
+/**
+ * @file		spectator.c
+ *       		spectator functions library. Show the matches of one game on any number of screens
+ * 			    of the same machine, KASSPONG_SPECTATE=/name : the game writes a NetState per tick
+ * 			    into a ring of SPECTATOR_SLOTS slots in a POSIX shared memory segment, and each
+ * 			    spectator process (kasspong_spectator) maps it read only.
+ * 			    - the game writes frame n straight into slots[n % SPECTATOR_SLOTS] under the
+ * 			      seqlock of the slot, then increments head. The spectators can't write anything,
+ * 			      the game never waits for them : adding one costs the game nothing.
+ * 			    - each spectator keeps its own cursor, the next frame it reads. A spectator that
+ * 			      falls SPECTATOR_SLOTS frames behind (or reads a slot written again meanwhile)
+ * 			      jumps to the last frame.
+ * 			    The frames are expanded and drawn like the snapshots of a server (client.c) : the
+ * 			    spectators load the same level.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+static SpectatorFeed *feed = NULL;
+static char *feedName = NULL;
+
+/*/////////////////////////////////////////
+ //						FEED FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Create the shared memory segment and start writing the matches into it.
+ * @param	char const*	name	the segment name, "/kasspong_spectate" for example
+ */
+void openSpectatorFeed(char const *name) {
+	int fd;
+
+	closeSpectatorFeed();
+	if ((fd = shm_open(name, O_CREAT | O_RDWR, 0600)) == -1) {
+		printf("ERROR : Impossible to open the shared memory '%s'.\n", name);
+		return;
+	}
+	if (ftruncate(fd, sizeof(SpectatorFeed)) == -1
+		|| (feed = mmap(NULL, sizeof(SpectatorFeed), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)) == MAP_FAILED) {
+		printf("ERROR : Impossible to map the shared memory '%s'.\n", name);
+		feed = NULL;
+		close(fd);
+		shm_unlink(name);
+		return;
+	}
+	close(fd);
+	if ((feedName = malloc(strlen(name) + 1)) == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	strcpy(feedName, name);
+
+	memset(feed, 0, sizeof(SpectatorFeed));
+	feed->version = SPECTATOR_VERSION;
+	__atomic_store_n(&feed->magic, SPECTATOR_MAGIC, __ATOMIC_RELEASE);
+}
+
+/**
+ * Stop writing and remove the segment (the spectators still mapping it keep it until they unmap it).
+ */
+void closeSpectatorFeed() {
+	if (feed == NULL) {
+		return;
+	}
+	munmap(feed, sizeof(SpectatorFeed));
+	shm_unlink(feedName);
+	free(feedName);
+	feed = NULL;
+	feedName = NULL;
+}
+
+/**
+ * Write a snapshot of the match as the next frame of the ring. Never waits.
+ * Single writer : only the simulation thread.
+ * @param	RenderSnapshot const*	snapshot	the snapshot just filled
+ */
+void publishSpectatorFrame(RenderSnapshot const *snapshot) {
+	SpectatorSlot *slot;
+	Uint32 head;
+
+	if (feed == NULL) {
+		return;
+	}
+	head = feed->head;
+	slot = &feed->slots[head % SPECTATOR_SLOTS];
+	__atomic_store_n(&slot->sequence, (head * 2) + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	captureNetState(&slot->state, snapshot);
+
+	__atomic_store_n(&slot->sequence, (head * 2) + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&feed->head, head + 1, __ATOMIC_RELEASE);
+}
+
+/*/////////////////////////////////////////
+ //					SPECTATOR FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Map the segment of a game read only. The first frame read is the next one written.
+ * The view is prepared with initClientSnapshot before updateSpectator is called.
+ * @param		Spectator*		spectator	the spectator
+ * @param		char const*		name			the segment name
+ * @return	bool										false if no game writes this segment
+ */
+bool attachSpectator(Spectator *spectator, char const *name) {
+	SpectatorFeed *mapped;
+	int fd;
+
+	memset(spectator, 0, sizeof(Spectator));
+	if ((fd = shm_open(name, O_RDONLY, 0)) == -1) {
+		printf("ERROR : No game writes the spectator feed '%s'.\n", name);
+		return false;
+	}
+	mapped = mmap(NULL, sizeof(SpectatorFeed), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		printf("ERROR : Impossible to map the shared memory '%s'.\n", name);
+		return false;
+	}
+	if (__atomic_load_n(&mapped->magic, __ATOMIC_ACQUIRE) != SPECTATOR_MAGIC || mapped->version != SPECTATOR_VERSION) {
+		printf("ERROR : '%s' is not a KassPong spectator feed of version %d.\n", name, SPECTATOR_VERSION);
+		munmap(mapped, sizeof(SpectatorFeed));
+		return false;
+	}
+	spectator->feed = mapped;
+	spectator->cursor = __atomic_load_n(&mapped->head, __ATOMIC_ACQUIRE);
+	return true;
+}
+
+/**
+ * Unmap the segment.
+ * @param	Spectator*	spectator	the spectator
+ */
+void detachSpectator(Spectator *spectator) {
+	if (spectator->feed != NULL) {
+		munmap((void *)spectator->feed, sizeof(SpectatorFeed));
+		spectator->feed = NULL;
+	}
+}
+
+/**
+ * Copy the frame at the cursor and move the cursor to the next one. Never makes the game wait.
+ * @param		Spectator*	spectator	the spectator
+ * @param		NetState*		state			the copy of the frame
+ * @return	bool									false if the game didn't write the next frame yet
+ */
+bool readSpectatorFrame(Spectator *spectator, NetState *state) {
+	SpectatorSlot const *slot;
+	Uint32 head, expected;
+
+	while (true) {
+		head = __atomic_load_n(&spectator->feed->head, __ATOMIC_ACQUIRE);
+		if (spectator->cursor == head) {
+			return false;
+		}
+		/* lapped : the oldest slots are being written again */
+		if (head - spectator->cursor > SPECTATOR_SLOTS - 1) {
+			spectator->framesSkipped += head - 1 - spectator->cursor;
+			spectator->cursor = head - 1;
+		}
+		slot = &spectator->feed->slots[spectator->cursor % SPECTATOR_SLOTS];
+		expected = (spectator->cursor * 2) + 2;
+		if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) == expected) {
+			memcpy(state, &slot->state, sizeof(NetState));
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if (__atomic_load_n(&slot->sequence, __ATOMIC_RELAXED) == expected) {
+				++spectator->cursor;
+				++spectator->framesRead;
+				return true;
+			}
+		}
+		++spectator->retries;
+	}
+}
+
+/**
+ * Read every frame written since the last call and give the snapshot of the last one.
+ * @param		Spectator*							spectator	the spectator
+ * @return	RenderSnapshot const*							the snapshot to draw, NULL before the first frame
+ */
+RenderSnapshot const *updateSpectator(Spectator *spectator) {
+	NetClient *view = &spectator->view;
+	NetState state;
+	bool received = false;
+
+	while (readSpectatorFrame(spectator, &state)) {
+		received = true;
+	}
+	if (received) {
+		view->state = state;
+		view->hasState = true;
+		expandNetState(view);
+		extrapolateBalls(view, 0);
+	}
+	return view->hasState ? &view->snapshot : NULL;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file		text.c
+ *       		text functions library. Load the 9x15 glyph atlas (img/font9x15.png, the GLUT 9x15 font),
+ * 			    build textured quads meshes from strings and keep the HUD strings cached.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <GL/gl.h>
+#include <GL/glu.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+GLuint glyphAtlas;
+HUDCache hudCaches[4];
+
+/*/////////////////////////////////////////
+ //					GLYPH ATLAS FUNCTIONS				//
+/////////////////////////////////////////*/
+
+/**
+ * Load the atlas of every printable character of the 9x15 font and upload it as an
+ * alpha texture. It doesn't need a window (nor GLUT), only a current GL context.
+ */
+void initGlyphAtlas() {
+	GLubyte pixels[GLYPH_ATLAS_WIDTH * GLYPH_ATLAS_HEIGHT];
+	SDL_Surface *surface = IMG_Load(GLYPH_ATLAS_PATH);
+	int i, j;
+
+	memset(pixels, 0, sizeof(pixels));
+	if (surface == NULL || surface->w < GLYPH_ATLAS_WIDTH || surface->h < GLYPH_ATLAS_HEIGHT) {
+		printf("ERROR : Impossible to load the glyph atlas '%s'.\n", GLYPH_ATLAS_PATH);
+	} else {
+		/* grey levels : any channel is the coverage */
+		for (i = 0; i < GLYPH_ATLAS_HEIGHT; ++i) {
+			for (j = 0; j < GLYPH_ATLAS_WIDTH; ++j) {
+				pixels[(i * GLYPH_ATLAS_WIDTH) + j] = ((GLubyte *)surface->pixels)[(i * surface->pitch)
+					+ (j * surface->format->BytesPerPixel)];
+			}
+		}
+	}
+	if (surface != NULL) {
+		SDL_FreeSurface(surface);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glGenTextures(1, &glyphAtlas);
+	glBindTexture(GL_TEXTURE_2D, glyphAtlas);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, GLYPH_ATLAS_WIDTH, GLYPH_ATLAS_HEIGHT, 0,
+			GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/**
+ * Free the glyph atlas texture and every cached HUD mesh.
+ */
+void freeGlyphAtlas() {
+	int i;
+	for (i = 0; i < 4; ++i) {
+		freeTextMesh(&hudCaches[i].nameMesh);
+		freeTextMesh(&hudCaches[i].scoreMesh);
+		hudCaches[i].valid = false;
+	}
+	glDeleteTextures(1, &glyphAtlas);
+}
+
+/*/////////////////////////////////////////
+ //					TEXT MESH FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Build the quads of a string. Same layout as the old GLUT bitmap rendering :
+ * horizontal strings are centered on x, vertical strings go down one glyph per line.
+ * @param	TextMesh*		mesh			the mesh to fill (grown if needed)
+ * @param	float				x					x position (center for horizontal strings)
+ * @param	float				y					baseline of the first glyph
+ * @param	char const*	string		the string to build
+ * @param	bool				vertical	true to stack the glyphs vertically
+ */
+void buildTextMesh(TextMesh *mesh, float x, float y, char const *string, bool vertical) {
+	int i, index, length = NameLenght(string);
+	float penX = x - ((GLYPH_WIDTH * length) / 2), penY = y;
+	float u, v;
+	GLfloat *vertices = mesh->vertices, *texCoords = mesh->texCoords;
+
+	if (length > mesh->capacity) {
+		vertices = realloc(mesh->vertices, length * 8 * sizeof(GLfloat));
+		texCoords = realloc(mesh->texCoords, length * 8 * sizeof(GLfloat));
+		if (vertices == NULL || texCoords == NULL) {
+			exit(MALLOC_ERROR);
+		}
+		mesh->vertices = vertices;
+		mesh->texCoords = texCoords;
+		mesh->capacity = length;
+	}
+	if (vertical) {
+		penX = x;
+	}
+
+	for (i = 0; i < length; ++i) {
+		index = (unsigned char)string[i] - GLYPH_FIRST;
+		if (index < 0 || index >= GLYPH_COUNT) {
+			index = '?' - GLYPH_FIRST;
+		}
+		u = (float)((index % GLYPH_ATLAS_COLUMNS) * GLYPH_WIDTH) / GLYPH_ATLAS_WIDTH;
+		v = (float)((index / GLYPH_ATLAS_COLUMNS) * GLYPH_CELL_HEIGHT) / GLYPH_ATLAS_HEIGHT;
+
+		*vertices++ = penX;
+		*vertices++ = penY - GLYPH_BASELINE;
+		*vertices++ = penX + GLYPH_WIDTH;
+		*vertices++ = penY - GLYPH_BASELINE;
+		*vertices++ = penX + GLYPH_WIDTH;
+		*vertices++ = penY - GLYPH_BASELINE + GLYPH_CELL_HEIGHT;
+		*vertices++ = penX;
+		*vertices++ = penY - GLYPH_BASELINE + GLYPH_CELL_HEIGHT;
+
+		*texCoords++ = u;
+		*texCoords++ = v;
+		*texCoords++ = u + ((float)GLYPH_WIDTH / GLYPH_ATLAS_WIDTH);
+		*texCoords++ = v;
+		*texCoords++ = u + ((float)GLYPH_WIDTH / GLYPH_ATLAS_WIDTH);
+		*texCoords++ = v + ((float)GLYPH_CELL_HEIGHT / GLYPH_ATLAS_HEIGHT);
+		*texCoords++ = u;
+		*texCoords++ = v + ((float)GLYPH_CELL_HEIGHT / GLYPH_ATLAS_HEIGHT);
+
+		if (vertical) {
+			penY += GLYPH_HEIGHT;
+		} else {
+			penX += GLYPH_WIDTH;
+		}
+	}
+	mesh->nbGlyphs = length;
+}
+
+/**
+ * Draw a text mesh, in a single draw call.
+ * @param	TextMesh const*	mesh	the mesh to draw
+ * @param	Color3f					color	the text color
+ */
+void drawTextMesh(TextMesh const *mesh, Color3f color) {
+	if (!mesh->nbGlyphs) {
+		return;
+	}
+	renderer->drawText(mesh, color);
+}
+
+/**
+ * Free the buffers of a text mesh.
+ * @param	TextMesh*	mesh	the mesh to free
+ */
+void freeTextMesh(TextMesh *mesh) {
+	free(mesh->vertices);
+	free(mesh->texCoords);
+	mesh->vertices = NULL;
+	mesh->texCoords = NULL;
+	mesh->capacity = 0;
+	mesh->nbGlyphs = 0;
+}
+
+/*/////////////////////////////////////////
+ //					HUD CACHE FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Get the HUD cache of a player, rebuilding its name and score meshes
+ * only if the score, the life or the name changed since the last call.
+ * @param		Player const*	pl				the current player
+ * @param		float					nameX			name position (x value)
+ * @param		float					nameY			name position (y value)
+ * @param		float					scoreX		score position (x value)
+ * @param		float					scoreY		score position (y value)
+ * @param		bool					vertical	true for the side HUDs (players 3 and 4)
+ * @return	HUDCache*								the up to date cache of the player
+ */
+HUDCache *updateHUDCache(Player const *pl, float nameX, float nameY, float scoreX, float scoreY, bool vertical) {
+	HUDCache *cache = &hudCaches[pl->id - 1];
+
+	if (cache->valid && cache->score == pl->score && cache->life == pl->life && cache->name == pl->name) {
+		return cache;
+	}
+	if (!cache->valid || cache->name != pl->name) {
+		buildTextMesh(&cache->nameMesh, nameX, nameY, pl->name, vertical);
+	}
+	if (!cache->valid || cache->score != pl->score) {
+		sprintf(cache->scoreString, "%d", pl->score);
+		buildTextMesh(&cache->scoreMesh, scoreX, scoreY, cache->scoreString, vertical);
+	}
+	cache->score = pl->score;
+	cache->life = pl->life;
+	cache->name = pl->name;
+	cache->valid = true;
+	return cache;
+}
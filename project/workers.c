@@ -0,0 +1,157 @@
+/**
+ * @file		workers.c
+ *       		workers functions library. A small pool of threads the simulation splits its per-ball
+ * 			    work on. The items are cut in chunks taken by whichever thread is free, so a job
+ * 			    must only write the slots of its own items : what is merged afterwards, and in which
+ * 			    order, is up to the caller, never up to the scheduling.
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+#include <SDL/SDL_thread.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					GLOBAL VARIABLES DEF				//
+/////////////////////////////////////////*/
+
+/* the threads besides the caller of runWorkers, which works too */
+static SDL_Thread *workers[WORKERS_MAX];
+static int nbWorkers = 0;
+static int workersRunning = 0;
+static SDL_sem *workStart = NULL;
+static SDL_sem *workDone = NULL;
+
+static WorkerJob job;
+static void *jobData;
+static int jobItems, jobChunk;
+static int nextChunk;
+
+/*/////////////////////////////////////////
+ //					WORKER FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Run the chunks of the current job until there is none left.
+ */
+void runChunks() {
+	int first, last;
+
+	while ((first = __atomic_fetch_add(&nextChunk, 1, __ATOMIC_RELAXED) * jobChunk) < jobItems) {
+		last = first + jobChunk < jobItems ? first + jobChunk : jobItems;
+		job(jobData, first, last);
+	}
+}
+
+/**
+ * Worker thread : wait for a job, help running it, tell it is done, until stopWorkers.
+ * @param		void*	data	unused
+ * @return	int					0
+ */
+int workerThread(void *data) {
+	while (true) {
+		SDL_SemWait(workStart);
+		if (!__atomic_load_n(&workersRunning, __ATOMIC_ACQUIRE)) {
+			return 0;
+		}
+		runChunks();
+		SDL_SemPost(workDone);
+	}
+}
+
+/*/////////////////////////////////////////
+ //					POOL FUNCTIONS							//
+/////////////////////////////////////////*/
+
+/**
+ * Start the pool. The calling thread counts as one : 1 thread starts no worker at all.
+ * @param	int	nbThreads	the number of threads running the jobs, WORKERS_MAX at most
+ */
+void startWorkers(int nbThreads) {
+	stopWorkers();
+	if (nbThreads > WORKERS_MAX) {
+		nbThreads = WORKERS_MAX;
+	}
+	if (nbThreads < 2) {
+		return;
+	}
+	workStart = SDL_CreateSemaphore(0);
+	workDone = SDL_CreateSemaphore(0);
+	if (workStart == NULL || workDone == NULL) {
+		printf("ERROR : Impossible to start the workers : %s\n", SDL_GetError());
+		return;
+	}
+	__atomic_store_n(&workersRunning, 1, __ATOMIC_RELEASE);
+	for (nbWorkers = 0; nbWorkers < nbThreads - 1; ++nbWorkers) {
+		if ((workers[nbWorkers] = SDL_CreateThread(workerThread, NULL)) == NULL) {
+			printf("ERROR : Impossible to start a worker : %s\n", SDL_GetError());
+			break;
+		}
+	}
+}
+
+/**
+ * Stop the workers and wait for them. Must not be called while a job is running.
+ */
+void stopWorkers() {
+	int i;
+
+	if (workStart == NULL) {
+		return;
+	}
+	__atomic_store_n(&workersRunning, 0, __ATOMIC_RELEASE);
+	for (i = 0; i < nbWorkers; ++i) {
+		SDL_SemPost(workStart);
+	}
+	for (i = 0; i < nbWorkers; ++i) {
+		SDL_WaitThread(workers[i], NULL);
+	}
+	SDL_DestroySemaphore(workStart);
+	SDL_DestroySemaphore(workDone);
+	workStart = NULL;
+	workDone = NULL;
+	nbWorkers = 0;
+}
+
+/**
+ * Get the number of threads running the jobs, the caller included.
+ * @return	int	the number of threads, 1 without any worker
+ */
+int workersCount() {
+	return nbWorkers + 1;
+}
+
+/**
+ * Run a job on every item, split in chunks between the workers and the calling thread,
+ * and return once all of them are done. A single thread at a time may run jobs.
+ * @param	WorkerJob	runJob		the function called on each chunk [first, last[
+ * @param	void*			data			passed to the job
+ * @param	int				nbItems		the number of items
+ * @param	int				chunkSize	the number of items of a chunk
+ */
+void runWorkers(WorkerJob runJob, void *data, int nbItems, int chunkSize) {
+	int i;
+
+	job = runJob;
+	jobData = data;
+	jobItems = nbItems;
+	jobChunk = chunkSize;
+	nextChunk = 0;
+	/* the semaphores order these writes before the workers read them */
+	for (i = 0; i < nbWorkers; ++i) {
+		SDL_SemPost(workStart);
+	}
+	runChunks();
+	for (i = 0; i < nbWorkers; ++i) {
+		SDL_SemWait(workDone);
+	}
+}
@@ -0,0 +1,107 @@
+/**
+ * @file		balance.c
+ *       		Balance runs (make balance). Plays one whole match per level and number of players
+ * 			    with GladOS on every seat, no window and no renderer : fastForward jumps from one
+ * 			    event to the next, the ticks holding an event are played like the simulation does.
+ * 			    Prints one CSV line per match : its length, the jumps and the ticks played, the
+ * 			    first seat out of lives, scores and lives of every seat, the bricks left and the
+ * 			    time spent.
+ * 			    Usage : kasspong_balance <config file> [config files...]
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define MAX_MATCH_TICKS 1000000L
+
+/*/////////////////////////////////////////
+ //					BALANCE FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Play one whole match of a level and print its line.
+ * @param	char const*	level			the config file of the level
+ * @param	int					nbPlayers	total number of players in game
+ */
+void playBalanceMatch(char const *level, int nbPlayers) {
+	Match match;
+	int i, j, loser = -1, bricksLeft = 0;
+	long tick = 0, jumped, jumps = 0, playedTicks = 0;
+	unsigned long start;
+
+	openMatch(&match, level, nbPlayers, (1u << nbPlayers) - 1);
+
+	start = clockNow();
+	while (loser < 0 && tick < MAX_MATCH_TICKS) {
+		if ((jumped = fastForward(match.grid, match.gridWidth, match.gridHeight, nbPlayers, match.nbBalls,
+			match.gladOSSeats, MAX_MATCH_TICKS - tick))) {
+			tick += jumped;
+			++jumps;
+			continue;
+		}
+		simulationTick(0);
+		for (i = nbPlayers - 1; i >= 0; --i) {
+			loser = players[i].life <= 0 ? i : loser;
+		}
+		++tick;
+		++playedTicks;
+	}
+	start = clockNow() - start;
+
+	for (i = 0; i < match.gridHeight; ++i) {
+		for (j = 0; j < match.gridWidth; ++j) {
+			bricksLeft += match.grid[i][j].status != DESTROYED;
+		}
+	}
+	printf("%s,%d,%ld,%.1f,%ld,%ld,%d,", level, nbPlayers, tick, (tick * SIM_TICK_DURATION) / 1000.0,
+		jumps, playedTicks, loser);
+	for (i = 0; i < nbPlayers; ++i) {
+		printf("%d%s", players[i].score, i + 1 < nbPlayers ? " " : ",");
+	}
+	for (i = 0; i < nbPlayers; ++i) {
+		printf("%d%s", players[i].life, i + 1 < nbPlayers ? " " : ",");
+	}
+	printf("%d,%.1f\n", bricksLeft, start / 1000.0);
+
+	closeMatch(&match);
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Play every level given, 2 then 4 players.
+ * @param		argc	number of parameters of main
+ * @param		argv	the levels to play
+ * @return	int		the error code value or the correct end value.
+ */
+int main(int argc, char **argv) {
+	int i, nbPlayers;
+
+	if (argc < 2) {
+		printf("Usage : %s <config file> [config files...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	initMatchDefaults("GladOS");
+
+	printf("level,players,ticks,game_seconds,jumps,played_ticks,loser,scores,lives,bricks_left,us\n");
+	for (i = 1; i < argc; ++i) {
+		for (nbPlayers = TWO_PL; nbPlayers <= FOUR_PL; nbPlayers += 2) {
+			playBalanceMatch(argv[i], nbPlayers);
+		}
+	}
+	return EXIT_SUCCESS;
+}
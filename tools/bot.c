@@ -0,0 +1,170 @@
+/**
+ * @file		bot.c
+ *       		Reference bot (make bot), the way a process in another language plugs into a running
+ * 			    game started with KASSPONG_SHM=/name : reads the shared state under its seqlock and
+ * 			    plays one seat through its action ring, following the nearest ball. Its heartbeat
+ * 			    moves every tick it sees. Prints how many ticks it saw and how many reads had to
+ * 			    start over. On the seat of GladOS (2 in a match against it), the bot plays instead
+ * 			    of GladOS as long as it is alive.
+ * 			    Usage : kasspong_bot </name> <seat (1-4)>
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define BOT_POLL_NS 1000000L
+#define BOT_IDLE_POLLS 5000
+
+/*/////////////////////////////////////////
+ //					BOT FUNCTIONS								//
+/////////////////////////////////////////*/
+
+/**
+ * Copy the shared state without ever making the game wait : start over while the game writes.
+ * @param		SharedState const*	shared	the state in the segment
+ * @param		SharedState*				state		the copy
+ * @return	int											the number of reads that had to start over
+ */
+int readSharedState(SharedState const *shared, SharedState *state) {
+	Uint32 before;
+	int retries = 0;
+
+	while (true) {
+		before = __atomic_load_n(&shared->sequence, __ATOMIC_ACQUIRE);
+		if (!(before & 1)) {
+			memcpy(state, shared, sizeof(SharedState));
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+			if (__atomic_load_n(&shared->sequence, __ATOMIC_RELAXED) == before) {
+				return retries;
+			}
+		}
+		++retries;
+	}
+}
+
+/**
+ * Choose the keys of a seat : move the bar towards the nearest ball.
+ * @param		SharedState const*	state	the copy of the state
+ * @param		int									seat	the seat played, from 0
+ * @return	Uint32										SHARED_MINUS, SHARED_PLUS or 0
+ */
+Uint32 chooseKeys(SharedState const *state, int seat) {
+	SharedBar const *bar = &state->bars[seat];
+	SharedBall const *ball;
+	float distance, nearest = -1, target = 0, barPos;
+	int i;
+
+	for (i = 0; i < state->nbBalls; ++i) {
+		ball = &state->balls[i];
+		distance = bar->horizontal ? fabs(ball->y - bar->y) : fabs(ball->x - bar->x);
+		if (ball->respawnTimer == 0 && (nearest < 0 || distance < nearest)) {
+			nearest = distance;
+			target = bar->horizontal ? ball->x : ball->y;
+		}
+	}
+	if (nearest < 0) {
+		return 0;
+	}
+	barPos = bar->horizontal ? bar->x : bar->y;
+	if (target < barPos - BAR_SPEED) {
+		return SHARED_MINUS;
+	}
+	if (target > barPos + BAR_SPEED) {
+		return SHARED_PLUS;
+	}
+	return 0;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Play a seat until the match is over or the game stops ticking.
+ * @param		argc	number of parameters of main
+ * @param		argv	segment name, seat
+ * @return	int		the error code value or the correct end value.
+ */
+int main(int argc, char **argv) {
+	struct timespec delay = {0, BOT_POLL_NS};
+	SharedSegment *segment;
+	SharedRing *ring;
+	SharedState state;
+	Uint32 keys = 0, wanted, head, lastTick;
+	long reads = 0, retries = 0, ticks = 0, pushed = 0, idle = 0;
+	int fd, seat;
+
+	if (argc != 3 || atoi(argv[2]) < 1 || atoi(argv[2]) > 4) {
+		printf("Usage : %s </name> <seat (1-4)>\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	seat = atoi(argv[2]) - 1;
+	if ((fd = shm_open(argv[1], O_RDWR, 0)) == -1) {
+		printf("ERROR : No game exports '%s'.\n", argv[1]);
+		return EXIT_FAILURE;
+	}
+	segment = mmap(NULL, sizeof(SharedSegment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (segment == MAP_FAILED || __atomic_load_n(&segment->state.magic, __ATOMIC_ACQUIRE) != SHARED_MAGIC
+		|| segment->state.version != SHARED_VERSION) {
+		printf("ERROR : '%s' is not a KassPong segment of version %d.\n", argv[1], SHARED_VERSION);
+		return EXIT_FAILURE;
+	}
+	ring = &segment->rings[seat];
+	__atomic_store_n(&ring->attached, 1, __ATOMIC_RELEASE);
+	readSharedState(&segment->state, &state);
+	lastTick = state.tick;
+
+	while (idle < BOT_IDLE_POLLS) {
+		retries += readSharedState(&segment->state, &state);
+		++reads;
+		if (state.tick == lastTick) {
+			++idle;
+			nanosleep(&delay, NULL);
+			continue;
+		}
+		ticks += state.tick - lastTick;
+		lastTick = state.tick;
+		idle = 0;
+		/* alive : without it the game gives the seat back after SHARED_STALE_TICKS ticks */
+		__atomic_store_n(&ring->heartbeat, ring->heartbeat + 1, __ATOMIC_RELEASE);
+		if (state.over) {
+			break;
+		}
+		if (seat >= state.nbPlayers || (wanted = chooseKeys(&state, seat)) == keys) {
+			continue;
+		}
+		/* ring full : the game is not ticking, the keys are pushed again at the next tick */
+		head = ring->head;
+		if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) < SHARED_RING_SIZE) {
+			keys = wanted;
+			ring->actions[head % SHARED_RING_SIZE] = keys;
+			__atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+			++pushed;
+		}
+	}
+
+	__atomic_store_n(&ring->attached, 0, __ATOMIC_RELEASE);
+	printf("Seat %d : %ld ticks seen, %ld reads (%ld started over), %ld keys pushed, score %d, %d lives\n",
+		seat + 1, ticks, reads, retries, pushed, state.scores[seat], state.lives[seat]);
+	munmap(segment, sizeof(SharedSegment));
+	return EXIT_SUCCESS;
+}
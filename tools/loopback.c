@@ -0,0 +1,158 @@
+/**
+ * @file		loopback.c
+ *       		Network test on loopback (make loopback). Runs a server and one client per seat in the
+ * 			    same process, over 127.0.0.1 through the loss and latency shim, each client playing
+ * 			    its bar from the snapshots it receives. Prints one CSV line per client : snapshots,
+ * 			    bandwidth (UDP payload, then with the 28 bytes of the IP and UDP headers) and whether
+ * 			    its last state is exactly the one the server sent.
+ * 			    Usage : kasspong_loopback <level> <players (2-4)> <seconds> [loss %] [latency ms]
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include <SDL/SDL.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //				CONSTANTS DEFINITION					//
+/////////////////////////////////////////*/
+
+#define UDP_IP_HEADERS 28
+
+/*/////////////////////////////////////////
+ //					LOOPBACK FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Choose the keys of a seat from the state received : move the bar towards the nearest ball.
+ * @param		NetState const*	state				the last state received
+ * @param		int							seat				the seat played, from 0
+ * @param		bool						horizontal	true if the bar of the seat is horizontal
+ * @return	unsigned int								SHARED_MINUS, SHARED_PLUS or 0
+ */
+unsigned int botKeys(NetState const *state, int seat, bool horizontal) {
+	NetPlayer const *bar = &state->players[seat];
+	NetBall const *ball;
+	int distance, nearest = -1, target = 0, barPos = horizontal ? bar->x : bar->y;
+	int i;
+
+	for (i = 0; i < state->nbBalls; ++i) {
+		ball = &state->balls[i];
+		distance = horizontal ? abs(ball->y - bar->y) : abs(ball->x - bar->x);
+		if (ball->respawnTimer == 0 && (nearest < 0 || distance < nearest)) {
+			nearest = distance;
+			target = horizontal ? ball->x : ball->y;
+		}
+	}
+	if (nearest < 0) {
+		return 0;
+	}
+	if (target < barPos - (BAR_SPEED * NET_SCALE)) {
+		return SHARED_MINUS;
+	}
+	if (target > barPos + (BAR_SPEED * NET_SCALE)) {
+		return SHARED_PLUS;
+	}
+	return 0;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Play a match over loopback and check what every client received.
+ * @param		argc	number of parameters of main
+ * @param		argv	level, number of players, duration, loss, latency
+ * @return	int		EXIT_SUCCESS, EXIT_FAILURE if a client ended with another state than the server
+ */
+int main(int argc, char **argv) {
+	static char *names[4] = {"bot 1", "bot 2", "bot 3", "bot 4"};
+	int nbPlayers;
+	Player templates[4];
+	Match match;
+	NetClient *clients;
+	NetPeer const *peer;
+	NetState const *sent;
+	Uint32 host, start, elapsed;
+	Uint16 port;
+	char address[32];
+	bool over = false, same, allSame = true;
+	int loss, latency, seconds, i;
+
+	if (argc < 4 || atoi(argv[2]) < 2 || atoi(argv[2]) > 4 || atoi(argv[3]) <= 0) {
+		printf("Usage : %s <level> <players (2-4)> <seconds> [loss %%] [latency ms]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	nbPlayers = atoi(argv[2]);
+	seconds = atoi(argv[3]);
+	loss = argc > 4 ? atoi(argv[4]) : 0;
+	latency = argc > 5 ? atoi(argv[5]) : 0;
+
+	initMatchDefaults("");
+	for (i = 0; i < 4; ++i) {
+		playersNames[i] = names[i];
+	}
+	openMatch(&match, argv[1], nbPlayers, 0);
+	memcpy(templates, players, nbPlayers * sizeof(Player));
+
+	setNetworkShim(loss, latency);
+	openServer(NET_DEFAULT_PORT);
+	sprintf(address, "127.0.0.1:%d", NET_DEFAULT_PORT);
+	if (serverPeer(0) == NULL || !resolveAddress(address, &host, &port)) {
+		return EXIT_FAILURE;
+	}
+	if ((clients = malloc(nbPlayers * sizeof(NetClient))) == NULL) {
+		exit(MALLOC_ERROR);
+	}
+	for (i = 0; i < nbPlayers; ++i) {
+		startClient(&clients[i], host, port, i, match.grid, match.gridWidth, match.gridHeight, templates, nbPlayers);
+	}
+	startSimulation(match.grid, match.gridWidth, match.gridHeight, nbPlayers, match.nbBalls, 0);
+
+	start = SDL_GetTicks();
+	while (!over && SDL_GetTicks() - start < (Uint32)seconds * 1000) {
+		over = true;
+		for (i = 0; i < nbPlayers; ++i) {
+			updateClient(&clients[i], clients[i].hasState
+				? botKeys(&clients[i].state, i, templates[i].bar.orientationHorizontal) : 0);
+			over = over && clients[i].hasState && clients[i].state.over;
+		}
+		SDL_Delay(1);
+	}
+	elapsed = SDL_GetTicks() - start;
+	stopSimulation();
+
+	printf("seat,snapshots_sent,full_snapshots,received,lost,undecodable,down_bytes_per_s,up_bytes_per_s,"
+		"down_with_headers,up_with_headers,score,lives,same_state\n");
+	for (i = 0; i < nbPlayers; ++i) {
+		peer = serverPeer(i);
+		sent = serverState(clients[i].sequence);
+		same = clients[i].hasState && sent != NULL && memcmp(sent, &clients[i].state, sizeof(NetState)) == 0;
+		allSame = allSame && same;
+		printf("%d,%ld,%ld,%ld,%ld,%ld,%.0f,%.0f,%.0f,%.0f,%d,%d,%s\n", i + 1, peer->snapshotsSent,
+			peer->fullSnapshots, clients[i].snapshotsReceived, clients[i].snapshotsLost,
+			clients[i].snapshotsUndecodable, peer->bytesSent * 1000.0 / elapsed,
+			clients[i].socket.bytesSent * 1000.0 / elapsed,
+			(peer->bytesSent + (peer->packetsSent * UDP_IP_HEADERS)) * 1000.0 / elapsed,
+			(clients[i].socket.bytesSent + (clients[i].socket.packetsSent * UDP_IP_HEADERS)) * 1000.0 / elapsed,
+			clients[i].state.players[i].score, clients[i].state.players[i].life,
+			sent == NULL ? "gone" : (same ? "yes" : "NO"));
+		stopClient(&clients[i]);
+	}
+	printf("%.1f s, %s, %d%% loss, %d ms latency each way\n", elapsed / 1000.0,
+		over ? "match over" : "time out", loss, latency);
+
+	closeServer();
+	free(clients);
+	closeMatch(&match);
+	return allSame ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file		record.c
+ *       		Draw call recorder (make record). Plays a match with GladOS on every seat and
+ * 			    draws every tick through the recording renderer : no GL context is ever created,
+ * 			    the draw calls are written one per line (golden output) and counted, each frame
+ * 			    followed by the hash of the state : a gameplay change shows at the first tick it
+ * 			    changes, even when nothing drawn differs yet. make record-check diffs a short
+ * 			    match against tools/record.golden.
+ * 			    Usage : kasspong_record <config file> <players> <ticks> <commands.txt | ->
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Play a match and record its draw calls.
+ * @param		argc	number of parameters of main
+ * @param		argv	config file, number of players, ticks, commands file ("-" for stdout)
+ * @return	int		the error code value or the correct end value.
+ */
+int main(int argc, char **argv) {
+	int nbPlayers;
+	long tick, ticks;
+	bool over = false;
+	Match match;
+	FILE *output;
+	int i;
+
+	if (argc != 5) {
+		printf("Usage : %s <config file> <players> <ticks> <commands.txt | ->\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	nbPlayers = atoi(argv[2]) == FOUR_PL ? FOUR_PL : TWO_PL;
+	ticks = atol(argv[3]);
+	output = strcmp(argv[4], "-") == 0 ? stdout : fopen(argv[4], "w");
+	if (output == NULL) {
+		printf("ERROR : Impossible to write '%s'.\n", argv[4]);
+		return EXIT_FAILURE;
+	}
+
+	initMatchDefaults("GladOS");
+	openMatch(&match, argv[1], nbPlayers, (1u << nbPlayers) - 1);
+
+	initBallMesh();
+	resetHUDCaches();
+	setRenderer(&recordRenderer);
+	startRecording(output);
+
+	for (tick = 0; tick < ticks && !over; ++tick) {
+		simulationTick(0);
+		for (i = 0; i < nbPlayers; ++i) {
+			over = over || players[i].life <= 0;
+		}
+
+		updateParticles(tick + 1);
+		renderer->beginFrame();
+		drawGame(match.grid, match.gridWidth, match.gridHeight, players, nbPlayers, balls, match.nbBalls);
+		renderer->endFrame();
+		fprintf(output, "hash ");
+		printHash(output, matchHash(tick + 1));
+		fprintf(output, "\n");
+	}
+	printRecordingStats(stderr);
+
+	if (output != stdout) {
+		fclose(output);
+	}
+	for (i = 0; i < 4; ++i) {
+		freeTextMesh(&hudCaches[i].nameMesh);
+		freeTextMesh(&hudCaches[i].scoreMesh);
+	}
+	closeMatch(&match);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file		render.c
+ *       		Headless renderer (make headless). Plays a match with GladOS on every seat and
+ * 			    renders every tick offscreen, without any window, display or vsync. The last
+ * 			    frame is written as a PPM thumbnail. KASSPONG_CAPTURE=clip.y4m (or "|command")
+ * 			    also records every tick as a Y4M video.
+ * 			    Usage : kasspong_render <config file> <players> <ticks> <thumbnail.ppm> [width height]
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					RENDER FUNCTIONS						//
+/////////////////////////////////////////*/
+
+/**
+ * Write a frame as a binary PPM picture.
+ * @param		char const*			path		the picture file
+ * @param		GLubyte const*	pixels	top-down RGB rows
+ * @param		int							width		width in pixels
+ * @param		int							height	height in pixels
+ * @return	bool										false if the file can't be written
+ */
+bool writePPM(char const *path, GLubyte const *pixels, int width, int height) {
+	FILE *file = fopen(path, "wb");
+	if (file == NULL) {
+		return false;
+	}
+	fprintf(file, "P6\n%d %d\n255\n", width, height);
+	fwrite(pixels, 3, width * height, file);
+	fclose(file);
+	return true;
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Play and render a headless match.
+ * @param		argc	number of parameters of main
+ * @param		argv	config file, number of players, ticks, thumbnail, optional frame size
+ * @return	int		the error code value or the correct end value.
+ */
+int main(int argc, char **argv) {
+	int nbPlayers, width = SCREEN_WIDTH, height = SCREEN_HEIGHT;
+	long tick, ticks;
+	bool over = false;
+	double start;
+	Match match;
+	GLubyte *pixels;
+	int i;
+
+	if (argc != 5 && argc != 7) {
+		printf("Usage : %s <config file> <players> <ticks> <thumbnail.ppm> [width height]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	nbPlayers = atoi(argv[2]) == FOUR_PL ? FOUR_PL : TWO_PL;
+	ticks = atol(argv[3]);
+	if (argc == 7) {
+		width = atoi(argv[5]);
+		height = atoi(argv[6]);
+	}
+
+	if (!initHeadless(width, height)) {
+		return EXIT_FAILURE;
+	}
+	if ((pixels = malloc(width * height * 3)) == NULL) {
+		exit(MALLOC_ERROR);
+	}
+
+	initMatchDefaults("GladOS");
+	openMatch(&match, argv[1], nbPlayers, (1u << nbPlayers) - 1);
+
+	initBallMesh();
+	initGlyphAtlas();
+	glGenTextures(TEXTURE_NB, texturesBuffer);
+	loadTextures("img/THEME1/");
+	resetHUDCaches();
+	if (getenv("KASSPONG_CAPTURE") != NULL) {
+		startCapture(getenv("KASSPONG_CAPTURE"), width, height, 1000 / SIM_TICK_DURATION);
+	}
+
+	start = clockNow() / 1e9;
+	for (tick = 0; tick < ticks && !over; ++tick) {
+		simulationTick(0);
+		for (i = 0; i < nbPlayers; ++i) {
+			over = over || players[i].life <= 0;
+		}
+
+		updateParticles(tick + 1);
+		renderer->beginFrame();
+		drawGame(match.grid, match.gridWidth, match.gridHeight, players, nbPlayers, balls, match.nbBalls);
+		renderer->endFrame();
+		captureFrame(tick);
+		glFinish();
+	}
+	start = clockNow() / 1e9 - start;
+	printf("%ld frames in %.3f s : %.0f frames/s (%dx%d, %s)\n", tick, start, tick / start,
+		width, height, glGetString(GL_RENDERER));
+
+	stopCapture();
+	readHeadlessFrame(pixels);
+	if (!writePPM(argv[4], pixels, width, height)) {
+		printf("ERROR : Impossible to write '%s'.\n", argv[4]);
+	}
+
+	freeHUDCaches();
+	freeGlyphAtlas();
+	glDeleteTextures(TEXTURE_NB, texturesBuffer);
+	quitHeadless();
+	closeMatch(&match);
+	free(pixels);
+	return EXIT_SUCCESS;
+}
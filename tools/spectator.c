@@ -0,0 +1,150 @@
+/**
+ * @file		spectator.c
+ *       		Spectator screen (make spectator). Shows the matches of a game started with
+ * 			    KASSPONG_SPECTATE=/name on this machine, as many windows as wanted : each one reads
+ * 			    the frames of the shared ring with its own cursor and draws them with display.c.
+ * 			    The level is the one of the game. Escape closes the window and prints how many
+ * 			    frames were read, skipped (too far behind) and read again.
+ * 			    Usage : kasspong_spectator </name> <config file> [player names...]
+ * @author	KassPong contributors
+ * @version	1.0
+ * @date		2026-10-18
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+#include "headers.h"
+
+/*/////////////////////////////////////////
+ //					SPECTATOR FUNCTIONS					//
+/////////////////////////////////////////*/
+
+/**
+ * Open the window, x and y start at 0 at the top left corner.
+ * @return	bool	false if the window can't be opened
+ */
+bool openWindow() {
+	if (-1 == SDL_Init(SDL_INIT_VIDEO)
+		|| NULL == SDL_SetVideoMode(SCREEN_WIDTH, SCREEN_HEIGHT, BIT_PER_PIXEL, SDL_OPENGL)) {
+		printf("ERROR : Impossible to open the window.\n");
+		return false;
+	}
+	SDL_WM_SetCaption("KassPong spectator", NULL);
+	glViewport(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+	glMatrixMode(GL_PROJECTION);
+	glLoadIdentity();
+	gluOrtho2D(0, SCREEN_WIDTH, SCREEN_HEIGHT, 0);
+	return true;
+}
+
+/**
+ * Prepare the view for the players of the match watched : bars, names and colors like
+ * the menu of the game, 7 columns at most with 4 players.
+ * @param	Spectator*	spectator		the spectator
+ * @param	GridBrick		grid				the 2 dimensional brick grid of the level
+ * @param	int					gridWidth		the config file gridWidth
+ * @param	int					gridHeight	the config file gridHeight
+ * @param	int					nbPlayers		the number of players of the match
+ */
+void watchMatch(Spectator *spectator, GridBrick grid, int gridWidth, int gridHeight, int nbPlayers) {
+	if (nbPlayers == FOUR_PL && gridWidth > 7) {
+		gridWidth = 7;
+	}
+	free(players);
+	free(balls);
+	initGame(nbPlayers);
+	initBrickCoordinates(grid, gridWidth, gridHeight);
+	initClientSnapshot(&spectator->view, grid, gridWidth, gridHeight, players, nbPlayers);
+	expandNetState(&spectator->view);
+	extrapolateBalls(&spectator->view, 0);
+	resetHUDCaches();
+	resetParticles();
+}
+
+/*/////////////////////////////////////////
+ //					MAIN FUNCTION START					//
+/////////////////////////////////////////*/
+
+/**
+ * Draw the matches of the feed until the window is closed.
+ * @param		argc	number of parameters of main
+ * @param		argv	segment name, config file, player names
+ * @return	int		the error code value or the correct end value.
+ */
+int main(int argc, char **argv) {
+	static char *defaultNames[4] = {"Player 1", "Player 2", "Player 3", "Player 4"};
+	static Spectator spectator;
+	RenderSnapshot const *snapshot;
+	SDL_Event event;
+	int gridWidth, gridHeight, nbPlayers = 0;
+	int *brickTypes;
+	GridBrick grid;
+	bool loop = true;
+	int i;
+
+	if (argc < 3) {
+		printf("Usage : %s </name> <config file> [player names...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+	initColor3f(&themeColor, 255, 139, 0);
+	for (i = 0; i < 4; ++i) {
+		playersNames[i] = i + 3 < argc ? argv[i + 3] : defaultNames[i];
+	}
+	brickTypes = readConfigFile(argv[2], &gridWidth, &gridHeight);
+	if (!attachSpectator(&spectator, argv[1]) || !openWindow()) {
+		return EXIT_FAILURE;
+	}
+
+	grid = initGrid(gridWidth, gridHeight, brickTypes);
+	initBallMesh();
+	initGlyphAtlas();
+	glGenTextures(TEXTURE_NB, texturesBuffer);
+	loadTextures("img/THEME1/");
+
+	while (loop) {
+		while (SDL_PollEvent(&event)) {
+			if (event.type == SDL_QUIT || (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)) {
+				loop = false;
+			}
+		}
+
+		snapshot = updateSpectator(&spectator);
+		if (snapshot != NULL && spectator.view.state.nbPlayers != nbPlayers) {
+			nbPlayers = spectator.view.state.nbPlayers;
+			watchMatch(&spectator, grid, gridWidth, gridHeight, nbPlayers);
+		}
+
+		renderer->beginFrame();
+		if (snapshot != NULL) {
+			updateParticles(snapshot->tick);
+			drawPlayfield((GridBrick)snapshot->rows, snapshot->gridWidth, snapshot->gridHeight,
+				snapshot->players, snapshot->nbPlayers, snapshot->balls, snapshot->nbBalls);
+			drawHUDs(snapshot->players, snapshot->nbPlayers);
+		} else {
+			drawBackground(13);
+		}
+		renderer->endFrame();
+		SDL_GL_SwapBuffers();
+		SDL_Delay(5);
+	}
+	printf("%ld frames read, %ld skipped, %ld reads started over\n", spectator.framesRead,
+		spectator.framesSkipped, spectator.retries);
+
+	detachSpectator(&spectator);
+	freeHUDCaches();
+	freeGlyphAtlas();
+	glDeleteTextures(TEXTURE_NB, texturesBuffer);
+	SDL_Quit();
+	for (i = 0; i < gridHeight; ++i) {
+		free(grid[i]);
+	}
+	free(grid);
+	free(brickTypes);
+	free(players);
+	free(balls);
+	return EXIT_SUCCESS;
+}